@@ -226,19 +226,34 @@ CACHING_TYPE_FIFO = 1
 CACHING_TYPE_LFU = 2
 CACHING_TYPE_LRU = 3
 CACHING_TYPE_ARC = 4
+CACHING_TYPE_CLOCK = 5
+CACHING_TYPE_CLOCK_PRO = 6
+CACHING_TYPE_TWO_Q = 7
+CACHING_TYPE_LIRS = 8
+CACHING_TYPE_W_TINY_LFU = 9
 
 CACHING_TYPES_STRINGS = {
     1 : "fifo",
     2 : "lfu",
     3 : "lru",
-    4 : "arc"
+    4 : "arc",
+    5 : "clock",
+    6 : "clock-pro",
+    7 : "2q",
+    8 : "lirs",
+    9 : "w-tinylfu"
 }
 
 CACHING_TYPES = [
     CACHING_TYPE_FIFO,
     CACHING_TYPE_LFU,
     CACHING_TYPE_LRU,
-    CACHING_TYPE_ARC
+    CACHING_TYPE_ARC,
+    CACHING_TYPE_CLOCK,
+    CACHING_TYPE_CLOCK_PRO,
+    CACHING_TYPE_TWO_Q,
+    CACHING_TYPE_LIRS,
+    CACHING_TYPE_W_TINY_LFU
 ]
 
 ## DISK MODE TYPES
@@ -12,12 +12,24 @@
 
 namespace machine {
 
-int super_block_factor = 512;
+size_t super_block_factor = 512;
 
-void PrintCapacity(const size_t block_count){
+size_t lfu_aging_factor = 0;
 
-  // 1 block == 4 KB
-  size_t capacity = block_count * 4 * super_block_factor;
+size_t clock_max_usage = 5;
+
+double two_q_in_ratio = 0.25;
+
+double two_q_out_ratio = 0.5;
+
+double lirs_hir_ratio = 0.01;
+
+double w_tiny_lfu_window_ratio = 0.01;
+
+void PrintCapacity(const size_t block_count, const size_t block_size){
+
+  // 1 block == super_block_factor * block_size
+  size_t capacity = block_count * (block_size / 1024) * super_block_factor;
 
   if(capacity < 1024) {
     std::cout << "[" << capacity <<" KB] ";
@@ -40,8 +52,7 @@ void PrintCapacity(const size_t block_count){
 CACHE_TEMPLATE_ARGUMENT
 CACHE_TEMPLATE_TYPE::Cache(size_t capacity, double clean_fraction)
 : cache_policy_(Policy(capacity, clean_fraction)),
-  capacity_{capacity},
-  current_block_{0} {
+  capacity_{capacity} {
 
   PL_ASSERT(capacity_ > 0);
 
@@ -58,6 +69,11 @@ Value CACHE_TEMPLATE_TYPE::Get(const Key& key) const {
   return cache_policy_.Get(key);
 }
 
+CACHE_TEMPLATE_ARGUMENT
+void CACHE_TEMPLATE_TYPE::Erase(const Key& key) {
+  cache_policy_.Erase(key);
+}
+
 CACHE_TEMPLATE_ARGUMENT
 size_t CACHE_TEMPLATE_TYPE::GetSize() const {
   return cache_policy_.GetSize();
@@ -69,24 +85,6 @@ void CACHE_TEMPLATE_TYPE::Print() const {
   cache_policy_.Print();
 }
 
-CACHE_TEMPLATE_ARGUMENT
-bool CACHE_TEMPLATE_TYPE::IsSequential(const size_t& next) {
-
-  bool status = false;
-  size_t distance = abs(current_block_ - next);
-  DLOG(INFO) << "CURRENT: " << current_block_ << " NEXT: " << next << "\n";
-
-  if(distance == 1){
-    status = true;
-  }
-  else {
-    status = false;
-  }
-
-  current_block_ = next;
-  return status;
-}
-
 // Instantiations
 
 // FIFO
@@ -101,6 +99,21 @@ template class Cache<int, int, LRUCachePolicy<int, int>>;
 // ARC
 template class Cache<int, int, ARCCachePolicy<int, int>>;
 
+// CLOCK
+template class Cache<int, int, CLOCKCachePolicy<int, int>>;
+
+// CLOCK-PRO
+template class Cache<int, int, CLOCKProCachePolicy<int, int>>;
+
+// 2Q
+template class Cache<int, int, TwoQCachePolicy<int, int>>;
+
+// LIRS
+template class Cache<int, int, LIRSCachePolicy<int, int>>;
+
+// W-TINYLFU
+template class Cache<int, int, WTinyLFUCachePolicy<int, int>>;
+
 
 }  // End machine namespace
 
@@ -0,0 +1,253 @@
+// CALIBRATION SOURCE
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+
+#include "calibration.h"
+#include "configuration.h"
+#include "device.h"
+#include "distribution.h"
+#include "emulation_backend.h"
+#include "timer.h"
+
+namespace machine {
+
+// size of each calibration file
+size_t calibration_file_size = 64 * 1024 * 1024;
+
+// random accesses per microbenchmark
+size_t calibration_operation_count = 4096;
+
+// transfer size of the bandwidth microbenchmarks
+size_t calibration_transfer_size = 1024 * 1024;
+
+// Create an empty scratch file of the given size in a directory
+static std::string CreateScratchFile(const std::string& directory,
+                                     const size_t& file_size){
+
+  std::string file_path = directory + "/machine_calibration_XXXXXX";
+  auto fd = mkstemp(&file_path[0]);
+  if(fd == -1){
+    std::cout << "Could not create calibration file in: " << directory << "\n";
+    exit(EXIT_FAILURE);
+  }
+
+  auto status = ftruncate(fd, file_size);
+  close(fd);
+  if(status != 0){
+    std::cout << "Could not size calibration file: " << file_path << "\n";
+    remove(file_path.c_str());
+    exit(EXIT_FAILURE);
+  }
+
+  return file_path;
+}
+
+// Evict the file from the page cache so that reads hit the device
+static void DropCache(const std::string& file_path){
+  auto fd = open(file_path.c_str(), O_RDONLY);
+  if(fd != -1){
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+  }
+}
+
+LatencyProfile CalibrateDevice(const configuration& state,
+                               const DeviceType& device_type,
+                               const std::string& directory,
+                               const size_t& file_size,
+                               const size_t& random_operation_count){
+
+  LatencyProfile profile;
+  Timer<std::ratio<1, 1000 * 1000 * 1000>> timer;
+  size_t page_count = std::max<size_t>(file_size / DEFAULT_BLOCK_SIZE, 1);
+  size_t transfer_size = std::min(calibration_transfer_size,
+                                  page_count * DEFAULT_BLOCK_SIZE);
+  size_t transfer_count = (page_count * DEFAULT_BLOCK_SIZE) / transfer_size;
+  UniformDistribution generator(50);
+
+  // The timed I/O goes through the device's emulation backend, so that it
+  // is measured the way emulated runs perform it
+  EmulationTarget target;
+  target.file_path = CreateScratchFile(directory, page_count * DEFAULT_BLOCK_SIZE);
+  target.file_size = page_count * DEFAULT_BLOCK_SIZE;
+  auto backend = EmulationBackendFactory::GetEmulationBackend(state,
+                                                              device_type,
+                                                              target,
+                                                              transfer_size);
+
+  // SEQUENTIAL WRITE (including write back)
+  timer.Start();
+  for(size_t page_itr = 0; page_itr < page_count; page_itr++){
+    backend->Write(page_itr * DEFAULT_BLOCK_SIZE, DEFAULT_BLOCK_SIZE);
+  }
+  backend->Sync();
+  timer.Stop();
+  profile.seq_write_latency = timer.GetDuration() / page_count;
+  DropCache(target.file_path);
+
+  // SEQUENTIAL READ
+  timer.Reset();
+  timer.Start();
+  for(size_t page_itr = 0; page_itr < page_count; page_itr++){
+    backend->Read(page_itr * DEFAULT_BLOCK_SIZE, DEFAULT_BLOCK_SIZE);
+  }
+  timer.Stop();
+  profile.seq_read_latency = timer.GetDuration() / page_count;
+  DropCache(target.file_path);
+
+  // RANDOM WRITE (including write back)
+  timer.Reset();
+  timer.Start();
+  for(size_t operation_itr = 0; operation_itr < random_operation_count; operation_itr++){
+    backend->Write((generator.next() % page_count) * DEFAULT_BLOCK_SIZE,
+                   DEFAULT_BLOCK_SIZE);
+  }
+  backend->Sync();
+  timer.Stop();
+  profile.rnd_write_latency = timer.GetDuration() / random_operation_count;
+  DropCache(target.file_path);
+
+  // RANDOM READ
+  timer.Reset();
+  timer.Start();
+  for(size_t operation_itr = 0; operation_itr < random_operation_count; operation_itr++){
+    backend->Read((generator.next() % page_count) * DEFAULT_BLOCK_SIZE,
+                  DEFAULT_BLOCK_SIZE);
+  }
+  timer.Stop();
+  profile.rnd_read_latency = timer.GetDuration() / random_operation_count;
+  DropCache(target.file_path);
+
+  // WRITE BANDWIDTH (large sequential transfers, including write back)
+  timer.Reset();
+  timer.Start();
+  for(size_t transfer_itr = 0; transfer_itr < transfer_count; transfer_itr++){
+    backend->Write(transfer_itr * transfer_size, transfer_size);
+  }
+  backend->Sync();
+  timer.Stop();
+  profile.write_bandwidth = (transfer_count * transfer_size) / timer.GetDuration();
+  DropCache(target.file_path);
+
+  // READ BANDWIDTH
+  timer.Reset();
+  timer.Start();
+  for(size_t transfer_itr = 0; transfer_itr < transfer_count; transfer_itr++){
+    backend->Read(transfer_itr * transfer_size, transfer_size);
+  }
+  timer.Stop();
+  profile.read_bandwidth = (transfer_count * transfer_size) / timer.GetDuration();
+
+  backend.reset();
+  remove(target.file_path.c_str());
+
+  return profile;
+}
+
+void RunCalibration(const configuration& state){
+
+  std::map<DeviceType, LatencyProfile> profiles;
+
+  for(auto entry : state.calibration_paths){
+    std::cout << "Calibrating " << DeviceTypeToString(entry.first)
+        << " :: " << entry.second << "\n";
+
+    auto profile = CalibrateDevice(state,
+                                   entry.first,
+                                   entry.second,
+                                   calibration_file_size,
+                                   calibration_operation_count);
+
+    std::cout << std::setw(10) << DeviceTypeToString(entry.first) << " :: "
+        << "SEQ READ: " << profile.seq_read_latency << " ns "
+        << "SEQ WRITE: " << profile.seq_write_latency << " ns "
+        << "RND READ: " << profile.rnd_read_latency << " ns "
+        << "RND WRITE: " << profile.rnd_write_latency << " ns "
+        << "READ BW: " << profile.read_bandwidth << " GB/s "
+        << "WRITE BW: " << profile.write_bandwidth << " GB/s\n";
+
+    profiles[entry.first] = profile;
+  }
+
+  WriteLatencyProfile(state.latency_profile, profiles);
+  std::cout << "Wrote latency profile: " << state.latency_profile << "\n";
+
+}
+
+void WriteLatencyProfile(const std::string& profile_file,
+                         const std::map<DeviceType, LatencyProfile>& profiles){
+
+  std::ofstream out(profile_file);
+  if(out.is_open() == false){
+    std::cout << "Could not open latency profile: " << profile_file << "\n";
+    exit(EXIT_FAILURE);
+  }
+
+  out << "# DEVICE SEQ_READ SEQ_WRITE RND_READ RND_WRITE (ns per page) "
+      << "READ_BW WRITE_BW (GB/s)\n";
+  for(auto entry : profiles){
+    auto& profile = entry.second;
+    out << DeviceTypeToString(entry.first) << " "
+        << profile.seq_read_latency << " "
+        << profile.seq_write_latency << " "
+        << profile.rnd_read_latency << " "
+        << profile.rnd_write_latency << " "
+        << profile.read_bandwidth << " "
+        << profile.write_bandwidth << "\n";
+  }
+
+}
+
+std::map<DeviceType, LatencyProfile> ReadLatencyProfile(const std::string& profile_file){
+
+  std::map<DeviceType, LatencyProfile> profiles;
+
+  std::ifstream in(profile_file);
+  if(in.is_open() == false){
+    std::cout << "Could not open latency profile: " << profile_file << "\n";
+    exit(EXIT_FAILURE);
+  }
+
+  std::string line;
+  while(std::getline(in, line)){
+    if(line.empty() == true || line[0] == '#'){
+      continue;
+    }
+
+    std::stringstream stream(line);
+    std::string device_name;
+    LatencyProfile profile;
+    stream >> device_name
+    >> profile.seq_read_latency
+    >> profile.seq_write_latency
+    >> profile.rnd_read_latency
+    >> profile.rnd_write_latency;
+
+    auto device_type = StringToDeviceType(device_name);
+    if(stream.fail() == true || device_type == DEVICE_TYPE_INVALID){
+      std::cout << "Invalid latency profile line: " << line << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    // Profiles without bandwidths derive them from the sequential latencies
+    stream >> profile.read_bandwidth >> profile.write_bandwidth;
+    if(stream.fail() == true){
+      profile.read_bandwidth = 0;
+      profile.write_bandwidth = 0;
+    }
+
+    profiles[device_type] = profile;
+  }
+
+  return profiles;
+}
+
+}  // End machine namespace
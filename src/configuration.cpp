@@ -1,7 +1,12 @@
 // CONFIGURATION SOURCE
 
 #include <algorithm>
+#include <fcntl.h>
 #include <iomanip>
+#include <set>
+#include <sstream>
+#include <sys/stat.h>
+#include <thread>
 
 #include "configuration.h"
 #include "cache.h"
@@ -14,35 +19,136 @@ void Usage() {
       "\n"
       "Command line options : machine <options>\n"
       "   -a --hierarchy_type                 :  hierarchy type\n"
+      "   -b --block_sizes                    :  block sizes (CACHE,DRAM,NVM,DISK bytes, default 4096; also the emulated transfer size)\n"
       "   -c --caching_type                   :  caching type\n"
       "   -d --disk_mode_type                 :  disk mode type\n"
       "   -e --emulate                        :  emulate\n"
       "   -f --file_name                      :  file name\n"
+      "   -g --numa_affinity                  :  numa node of each client (0,1,...)\n"
+      "   -i --emulation_backend_type         :  emulation backend type\n"
+      "   -j --data_sync                      :  sync emulated writes with fdatasync\n"
+      "   -k --super_block_factor             :  super block factor\n"
       "   -l --latency_type                   :  latency type\n"
       "   -m --migration_frequency            :  migration frequency\n"
+      "   -n --numa_node_count                :  numa node count\n"
       "   -o --operation_count                :  operation count\n"
+      "   -p --numa_placement_type            :  numa placement type\n"
+      "   -q --latency_file                   :  latency percentile file\n"
       "   -r --size_ratio_type                :  size ratio type\n"
       "   -s --size_type                      :  size type\n"
+      "   -t --latency_model_type             :  latency model type\n"
+      "   -u --latency_sigma                  :  latency distribution sigma\n"
       "   -v --verbose                        :  verbose\n"
+      "   -w --prefetch_depth                 :  prefetch depth (blocks)\n"
+      "   -x --numa_remote_latency            :  numa remote latency multiplier\n"
       "   -y --large_file_mode                :  large file mode\n"
-      "   -z --summary_file                   :  summary file\n";
+      "   -z --summary_file                   :  summary file\n"
+      "   -A --group_commit_size              :  flushed blocks per sync\n"
+      "   -B --group_commit_window            :  group commit window (us)\n"
+      "   -C --ssd_capacity                   :  ssd logical capacity (GB)\n"
+      "   -D --ssd_model                      :  model ssd ftl and gc\n"
+      "   -E --nvm_wear_leveling              :  nvm wear-aware placement\n"
+      "   -F --emulation_targets              :  emulation files, truncated unless -X reuses them (NVM=path:GB:flags,...; DRAM=:GB sizes memory)\n"
+      "   -G --gc_policy_type                 :  ssd gc policy type\n"
+      "   -H --hdd_model                      :  model hdd seeks and rotation\n"
+      "   -I --io_queue_depth                 :  emulation io queue depth\n"
+      "   -J --optimizer_jobs                 :  optimizer parallel jobs\n"
+      "   -K --calibrate                      :  calibrate devices (DRAM=dir,NVM=dir,DISK=dir)\n"
+      "   -L --slo_latency                    :  latency SLO (ns/op at --slo_percentile)\n"
+      "   -M --nvm_emulation_backend_type     :  nvm emulation backend type\n"
+      "   -N --nvm_model                      :  model nvm write buffer and wear\n"
+      "   -O --optimize                       :  search hierarchy design space\n"
+      "   -P --tier_prices                    :  tier prices (DRAM,NVM,DISK $/GB)\n"
+      "   -Q --hdd_queue_depth                :  hdd writeback queue depth\n"
+      "   -R --latency_profile                :  latency profile file\n"
+      "   -S --slo_throughput                 :  throughput SLO (ops/s)\n"
+      "   -T --nvm_extra_latency              :  extra ns per emulated nvm access\n"
+      "   -U --prefault_emulation_files       :  write emulation files once upfront\n"
+      "   -V --ssd_over_provisioning          :  ssd over-provisioning fraction\n"
+      "   -W --nvm_write_bandwidth            :  nvm write bandwidth (GB/s)\n"
+      "   -X --reuse_emulation_files          :  reuse prepared emulation files\n"
+      "   -Y --io_worker_count                :  emulation io worker threads\n"
+      "   -Z --validation_profile             :  write emulation-corrected latency profile\n"
+      "      --clock_max_usage                :  clock usage count cap (1-15)\n"
+      "      --lfu_aging_factor               :  halve lfu frequencies every N x capacity accesses\n"
+      "      --lirs_hir_ratio                 :  lirs resident hir share of capacity\n"
+      "      --slo_percentile                 :  op latency percentile bounded by -L (default 99)\n"
+      "      --two_q_in_ratio                 :  2q a1in share of capacity\n"
+      "      --two_q_out_ratio                :  2q a1out size as a fraction of capacity\n"
+      "      --w_tiny_lfu_window_ratio        :  w-tinylfu window share of capacity\n";
       exit(EXIT_FAILURE);
 }
 
+// options without a short form
+enum LongOption {
+  LONG_OPTION_LFU_AGING_FACTOR = 256,
+  LONG_OPTION_CLOCK_MAX_USAGE,
+  LONG_OPTION_TWO_Q_IN_RATIO,
+  LONG_OPTION_TWO_Q_OUT_RATIO,
+  LONG_OPTION_LIRS_HIR_RATIO,
+  LONG_OPTION_W_TINY_LFU_WINDOW_RATIO,
+  LONG_OPTION_SLO_PERCENTILE
+};
+
 static struct option opts[] = {
     {"hierarchy_type", optional_argument, NULL, 'a'},
+    {"block_sizes", optional_argument, NULL, 'b'},
     {"caching_type", optional_argument, NULL, 'c'},
     {"disk_mode_type", optional_argument, NULL, 'd'},
     {"emulate", optional_argument, NULL, 'e'},
     {"file_name", optional_argument, NULL, 'f'},
+    {"numa_affinity", optional_argument, NULL, 'g'},
+    {"emulation_backend_type", optional_argument, NULL, 'i'},
+    {"data_sync", optional_argument, NULL, 'j'},
+    {"super_block_factor", optional_argument, NULL, 'k'},
     {"latency_type", optional_argument, NULL, 'l'},
     {"migration_frequency", optional_argument, NULL, 'm'},
+    {"numa_node_count", optional_argument, NULL, 'n'},
     {"operation_count", optional_argument, NULL, 'o'},
+    {"numa_placement_type", optional_argument, NULL, 'p'},
+    {"latency_file", optional_argument, NULL, 'q'},
     {"size_ratio_type", optional_argument, NULL, 'r'},
     {"size_type", optional_argument, NULL, 's'},
+    {"latency_model_type", optional_argument, NULL, 't'},
+    {"latency_sigma", optional_argument, NULL, 'u'},
     {"verbose", optional_argument, NULL, 'v'},
+    {"prefetch_depth", optional_argument, NULL, 'w'},
+    {"numa_remote_latency", optional_argument, NULL, 'x'},
     {"large_file_mode", optional_argument, NULL, 'y'},
     {"summary_file", optional_argument, NULL, 'z'},
+    {"ssd_capacity", optional_argument, NULL, 'C'},
+    {"ssd_model", optional_argument, NULL, 'D'},
+    {"nvm_wear_leveling", optional_argument, NULL, 'E'},
+    {"gc_policy_type", optional_argument, NULL, 'G'},
+    {"hdd_model", optional_argument, NULL, 'H'},
+    {"io_queue_depth", optional_argument, NULL, 'I'},
+    {"nvm_emulation_backend_type", optional_argument, NULL, 'M'},
+    {"nvm_extra_latency", optional_argument, NULL, 'T'},
+    {"emulation_targets", optional_argument, NULL, 'F'},
+    {"group_commit_size", optional_argument, NULL, 'A'},
+    {"io_worker_count", optional_argument, NULL, 'Y'},
+    {"validation_profile", optional_argument, NULL, 'Z'},
+    {"group_commit_window", optional_argument, NULL, 'B'},
+    {"prefault_emulation_files", optional_argument, NULL, 'U'},
+    {"reuse_emulation_files", optional_argument, NULL, 'X'},
+    {"optimizer_jobs", optional_argument, NULL, 'J'},
+    {"calibrate", optional_argument, NULL, 'K'},
+    {"slo_latency", optional_argument, NULL, 'L'},
+    {"nvm_model", optional_argument, NULL, 'N'},
+    {"optimize", optional_argument, NULL, 'O'},
+    {"tier_prices", optional_argument, NULL, 'P'},
+    {"hdd_queue_depth", optional_argument, NULL, 'Q'},
+    {"latency_profile", optional_argument, NULL, 'R'},
+    {"slo_throughput", optional_argument, NULL, 'S'},
+    {"ssd_over_provisioning", optional_argument, NULL, 'V'},
+    {"nvm_write_bandwidth", optional_argument, NULL, 'W'},
+    {"lfu_aging_factor", required_argument, NULL, LONG_OPTION_LFU_AGING_FACTOR},
+    {"clock_max_usage", required_argument, NULL, LONG_OPTION_CLOCK_MAX_USAGE},
+    {"two_q_in_ratio", required_argument, NULL, LONG_OPTION_TWO_Q_IN_RATIO},
+    {"two_q_out_ratio", required_argument, NULL, LONG_OPTION_TWO_Q_OUT_RATIO},
+    {"lirs_hir_ratio", required_argument, NULL, LONG_OPTION_LIRS_HIR_RATIO},
+    {"w_tiny_lfu_window_ratio", required_argument, NULL, LONG_OPTION_W_TINY_LFU_WINDOW_RATIO},
+    {"slo_percentile", required_argument, NULL, LONG_OPTION_SLO_PERCENTILE},
     {NULL, 0, NULL, 0}
 };
 
@@ -99,6 +205,48 @@ static void ValidateCachingType(const configuration &state) {
     printf("%30s : %s\n", "caching_type",
            CachingTypeToString(state.caching_type).c_str());
   }
+
+  if (state.caching_type == CACHING_TYPE_LFU) {
+    printf("%30s : %lu\n", "lfu_aging_factor", state.lfu_aging_factor);
+  }
+
+  // usage counts are 4-bit fields
+  if (state.clock_max_usage < 1 || state.clock_max_usage > 15) {
+    printf("Invalid clock_max_usage :: %lu\n", state.clock_max_usage);
+    exit(EXIT_FAILURE);
+  }
+  if (state.caching_type == CACHING_TYPE_CLOCK) {
+    printf("%30s : %lu\n", "clock_max_usage", state.clock_max_usage);
+  }
+
+  if (state.two_q_in_ratio < 0 || state.two_q_in_ratio > 1) {
+    printf("Invalid two_q_in_ratio :: %.2lf\n", state.two_q_in_ratio);
+    exit(EXIT_FAILURE);
+  }
+  if (state.two_q_out_ratio < 0 || state.two_q_out_ratio > 1) {
+    printf("Invalid two_q_out_ratio :: %.2lf\n", state.two_q_out_ratio);
+    exit(EXIT_FAILURE);
+  }
+  if (state.caching_type == CACHING_TYPE_TWO_Q) {
+    printf("%30s : %.2lf\n", "two_q_in_ratio", state.two_q_in_ratio);
+    printf("%30s : %.2lf\n", "two_q_out_ratio", state.two_q_out_ratio);
+  }
+
+  if (state.lirs_hir_ratio <= 0 || state.lirs_hir_ratio >= 1) {
+    printf("Invalid lirs_hir_ratio :: %.2lf\n", state.lirs_hir_ratio);
+    exit(EXIT_FAILURE);
+  }
+  if (state.caching_type == CACHING_TYPE_LIRS) {
+    printf("%30s : %.2lf\n", "lirs_hir_ratio", state.lirs_hir_ratio);
+  }
+
+  if (state.w_tiny_lfu_window_ratio <= 0 || state.w_tiny_lfu_window_ratio > 1) {
+    printf("Invalid w_tiny_lfu_window_ratio :: %.2lf\n", state.w_tiny_lfu_window_ratio);
+    exit(EXIT_FAILURE);
+  }
+  if (state.caching_type == CACHING_TYPE_W_TINY_LFU) {
+    printf("%30s : %.2lf\n", "w_tiny_lfu_window_ratio", state.w_tiny_lfu_window_ratio);
+  }
 }
 
 static void ValidateFileName(const configuration &state){
@@ -109,6 +257,43 @@ static void ValidateSummaryFile(const configuration &state){
   printf("%30s : %s\n", "summary_file", state.summary_file.c_str());
 }
 
+static void ValidateLatencyFile(const configuration &state){
+  if(state.latency_file.empty() == false) {
+    printf("%30s : %s\n", "latency_file", state.latency_file.c_str());
+  }
+}
+
+static void ValidateCalibration(const configuration &state){
+  for(auto entry : state.calibration_paths){
+    if(entry.first != DEVICE_TYPE_DRAM &&
+        entry.first != DEVICE_TYPE_NVM &&
+        entry.first != DEVICE_TYPE_DISK) {
+      printf("Invalid calibration device :: %s\n",
+             DeviceTypeToString(entry.first).c_str());
+      exit(EXIT_FAILURE);
+    }
+    // Scratch files are created inside the directory, never over a file
+    struct stat path_stat;
+    if(stat(entry.second.c_str(), &path_stat) != 0 ||
+        S_ISDIR(path_stat.st_mode) == false) {
+      printf("Invalid calibration path :: %s is not a directory\n",
+             entry.second.c_str());
+      exit(EXIT_FAILURE);
+    }
+    auto label = DeviceTypeToString(entry.first) + " calibration_path";
+    printf("%30s : %s\n", label.c_str(), entry.second.c_str());
+  }
+
+  if(state.calibration_paths.empty() == false &&
+      state.latency_profile.empty() == true) {
+    printf("Invalid latency_profile :: calibration needs an output file\n");
+    exit(EXIT_FAILURE);
+  }
+  if(state.latency_profile.empty() == false) {
+    printf("%30s : %s\n", "latency_profile", state.latency_profile.c_str());
+  }
+}
+
 static void ValidateLatencyType(const configuration &state) {
   if (state.latency_type < 1 || state.latency_type > LATENCY_TYPE_MAX) {
     printf("Invalid latency_type :: %d\n", state.latency_type);
@@ -120,6 +305,152 @@ static void ValidateLatencyType(const configuration &state) {
   }
 }
 
+static void ValidateLatencyModel(const configuration &state) {
+  if (state.latency_model_type < 1 ||
+      state.latency_model_type > LATENCY_MODEL_TYPE_MAX) {
+    printf("Invalid latency_model_type :: %d\n", state.latency_model_type);
+    exit(EXIT_FAILURE);
+  }
+  if (state.latency_sigma < 0) {
+    printf("Invalid latency_sigma :: %.2lf\n", state.latency_sigma);
+    exit(EXIT_FAILURE);
+  }
+
+  printf("%30s : %s\n", "latency_model_type",
+         LatencyModelTypeToString(state.latency_model_type).c_str());
+  if (state.latency_model_type == LATENCY_MODEL_TYPE_DISTRIBUTION) {
+    printf("%30s : %.2lf\n", "latency_sigma", state.latency_sigma);
+  }
+}
+
+static void ValidateEmulationBackend(const configuration &state) {
+  if(state.emulate == false){
+    return;
+  }
+
+  if (state.emulation_backend_type < 1 ||
+      state.emulation_backend_type > EMULATION_BACKEND_TYPE_MAX) {
+    printf("Invalid emulation_backend_type :: %d\n", state.emulation_backend_type);
+    exit(EXIT_FAILURE);
+  }
+
+  // Memory only backs volatile and byte-addressable tiers
+  if (state.emulation_backend_type == EMULATION_BACKEND_TYPE_MEMORY) {
+    printf("Invalid emulation_backend_type :: MEMORY is only for the NVM tier (-M)\n");
+    exit(EXIT_FAILURE);
+  }
+
+  if (state.io_queue_depth == 0) {
+    printf("Invalid io_queue_depth :: %lu\n", state.io_queue_depth);
+    exit(EXIT_FAILURE);
+  }
+
+  if (state.nvm_emulation_backend_type < 0 ||
+      state.nvm_emulation_backend_type > EMULATION_BACKEND_TYPE_MAX) {
+    printf("Invalid nvm_emulation_backend_type :: %d\n", state.nvm_emulation_backend_type);
+    exit(EXIT_FAILURE);
+  }
+
+  if (state.nvm_extra_latency < 0) {
+    printf("Invalid nvm_extra_latency :: %.1lf\n", state.nvm_extra_latency);
+    exit(EXIT_FAILURE);
+  }
+
+  printf("%30s : %s\n", "emulation_backend_type",
+         EmulationBackendTypeToString(state.emulation_backend_type).c_str());
+  printf("%30s : %d\n", "data_sync", state.data_sync);
+  if (state.emulation_backend_type == EMULATION_BACKEND_TYPE_URING ||
+      state.io_worker_count > 0) {
+    printf("%30s : %lu\n", "io_queue_depth", state.io_queue_depth);
+  }
+  if (state.io_worker_count > 0) {
+    printf("%30s : %lu\n", "io_worker_count", state.io_worker_count);
+  }
+  if (state.nvm_emulation_backend_type != EMULATION_BACKEND_TYPE_INVALID) {
+    printf("%30s : %s\n", "nvm_emulation_backend_type",
+           EmulationBackendTypeToString(state.nvm_emulation_backend_type).c_str());
+  }
+  if (state.nvm_extra_latency > 0) {
+    printf("%30s : %.1lf ns\n", "nvm_extra_latency", state.nvm_extra_latency);
+  }
+}
+
+static void ValidateEmulationTargets(const configuration &state) {
+  if(state.emulate == false){
+    return;
+  }
+
+  // Accesses span up to the largest block and start on any page before it
+  size_t max_block_size = DEFAULT_BLOCK_SIZE;
+  for(auto entry : state.block_sizes){
+    max_block_size = std::max(max_block_size, entry.second);
+  }
+
+  std::set<std::string> file_paths;
+  for(auto entry : state.emulation_targets){
+    if(entry.first != DEVICE_TYPE_DRAM &&
+        entry.first != DEVICE_TYPE_NVM &&
+        entry.first != DEVICE_TYPE_DISK) {
+      printf("Invalid emulation target device :: %s\n",
+             DeviceTypeToString(entry.first).c_str());
+      exit(EXIT_FAILURE);
+    }
+
+    auto& target = entry.second;
+    if(target.file_path.empty() == true ||
+        target.file_size < (off64_t) (max_block_size + DEFAULT_BLOCK_SIZE)) {
+      printf("Invalid emulation target :: %s\n",
+             DeviceTypeToString(entry.first).c_str());
+      exit(EXIT_FAILURE);
+    }
+
+    std::string flags;
+    flags += (target.open_flags & O_SYNC) == O_SYNC ? " sync" :
+        (target.open_flags & O_DSYNC) ? " dsync" : "";
+    flags += (target.open_flags & O_NOATIME) ? " noatime" : "";
+
+    auto file_path = target.file_path;
+    if(EmulationBackendFactory::GetEmulationBackendType(state, entry.first) ==
+        EMULATION_BACKEND_TYPE_MEMORY) {
+      file_path = "memory";
+    }
+    // Files are truncated and filled in parallel, so they cannot be shared
+    else if(file_paths.insert(file_path).second == false) {
+      printf("Duplicate emulation target file :: %s\n", file_path.c_str());
+      exit(EXIT_FAILURE);
+    }
+
+    auto label = DeviceTypeToString(entry.first) + " emulation_target";
+    printf("%30s : %s (%.2lf GB%s)\n", label.c_str(), file_path.c_str(),
+           (double) target.file_size / (1024 * 1024 * 1024), flags.c_str());
+  }
+
+  if(state.validation_profile.empty() == false){
+    printf("%30s : %s\n", "validation_profile", state.validation_profile.c_str());
+  }
+  printf("%30s : %d\n", "prefault_emulation_files", state.prefault_emulation_files);
+  printf("%30s : %d\n", "reuse_emulation_files", state.reuse_emulation_files);
+}
+
+static void ValidateGroupCommit(const configuration &state) {
+  if(state.emulate == false){
+    return;
+  }
+
+  if (state.group_commit_size == 0) {
+    printf("Invalid group_commit_size :: %lu\n", state.group_commit_size);
+    exit(EXIT_FAILURE);
+  }
+
+  if (state.group_commit_window < 0) {
+    printf("Invalid group_commit_window :: %.1lf\n", state.group_commit_window);
+    exit(EXIT_FAILURE);
+  }
+
+  printf("%30s : %lu\n", "group_commit_size", state.group_commit_size);
+  printf("%30s : %.1lf us\n", "group_commit_window", state.group_commit_window);
+}
+
 static void ValidateMigrationFrequency(const configuration &state){
   printf("%30s : %lu\n", "migration_frequency", state.migration_frequency);
 }
@@ -138,10 +469,324 @@ static void ValidateOperationCount(const configuration &state){
   }
 }
 
+static void ValidatePrefetchDepth(const configuration &state){
+  if(state.prefetch_depth > 0) {
+    printf("%30s : %lu\n", "prefetch_depth", state.prefetch_depth);
+  }
+}
+
 static void ValidateLargeFileMode(const configuration &state){
   printf("%30s : %d\n", "large_file_mode", state.large_file_mode);
 }
 
+static void ValidateBlockSizes(const configuration &state){
+  for(auto entry : state.block_sizes){
+    auto block_size = entry.second;
+    if(block_size == 0 || block_size % DEFAULT_BLOCK_SIZE != 0) {
+      printf("Invalid block_size :: %lu (must be a multiple of %d)\n",
+             block_size, DEFAULT_BLOCK_SIZE);
+      exit(EXIT_FAILURE);
+    }
+    auto label = DeviceTypeToString(entry.first) + " block_size";
+    printf("%30s : %lu\n", label.c_str(), block_size);
+  }
+}
+
+static void ValidateSuperBlockFactor(const configuration &state){
+  if(state.super_block_factor == 0) {
+    printf("Invalid super_block_factor :: %lu\n", state.super_block_factor);
+    exit(EXIT_FAILURE);
+  }
+  else {
+    printf("%30s : %lu\n", "super_block_factor", state.super_block_factor);
+  }
+}
+
+static void ValidateNuma(const configuration &state){
+  if(state.numa_node_count == 0) {
+    printf("Invalid numa_node_count :: %lu\n", state.numa_node_count);
+    exit(EXIT_FAILURE);
+  }
+  if(state.numa_placement_type < 1 ||
+      state.numa_placement_type > NUMA_PLACEMENT_TYPE_MAX) {
+    printf("Invalid numa_placement_type :: %d\n", state.numa_placement_type);
+    exit(EXIT_FAILURE);
+  }
+  for(auto node : state.numa_affinity){
+    if(node >= state.numa_node_count){
+      printf("Invalid numa_affinity node :: %lu\n", node);
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  if(state.numa_node_count > 1) {
+    printf("%30s : %lu\n", "numa_node_count", state.numa_node_count);
+    printf("%30s : %s\n", "numa_placement_type",
+           NumaPlacementTypeToString(state.numa_placement_type).c_str());
+    printf("%30s : %.2lf\n", "numa_remote_latency", state.numa_remote_latency);
+  }
+}
+
+void ParseNumaAffinity(const std::string& numa_affinity, configuration &state){
+
+  std::stringstream stream(numa_affinity);
+  std::string token;
+  state.numa_affinity.clear();
+  while(std::getline(stream, token, ',')){
+    state.numa_affinity.push_back(atol(token.c_str()));
+  }
+
+}
+
+size_t GetClientNode(const configuration &state, const size_t& client){
+
+  // Clients without an explicit affinity are spread round-robin
+  if(client < state.numa_affinity.size()){
+    return state.numa_affinity[client];
+  }
+
+  return client % state.numa_node_count;
+}
+
+static void ValidateSSDModel(const configuration &state){
+  if(state.ssd_model == false){
+    return;
+  }
+
+  if(state.disk_mode_type != DISK_MODE_TYPE_SSD) {
+    printf("Invalid ssd_model :: disk_mode_type is %s\n",
+           DiskModeTypeToString(state.disk_mode_type).c_str());
+    exit(EXIT_FAILURE);
+  }
+  if(state.ssd_capacity == 0) {
+    printf("Invalid ssd_capacity :: %lu\n", state.ssd_capacity);
+    exit(EXIT_FAILURE);
+  }
+  if(state.ssd_over_provisioning <= 0) {
+    printf("Invalid ssd_over_provisioning :: %.2lf\n", state.ssd_over_provisioning);
+    exit(EXIT_FAILURE);
+  }
+  if(state.gc_policy_type < 1 || state.gc_policy_type > GC_POLICY_TYPE_MAX) {
+    printf("Invalid gc_policy_type :: %d\n", state.gc_policy_type);
+    exit(EXIT_FAILURE);
+  }
+
+  printf("%30s : %d\n", "ssd_model", state.ssd_model);
+  printf("%30s : %lu GB\n", "ssd_capacity", state.ssd_capacity);
+  printf("%30s : %.2lf\n", "ssd_over_provisioning", state.ssd_over_provisioning);
+  printf("%30s : %s\n", "gc_policy_type",
+         GcPolicyTypeToString(state.gc_policy_type).c_str());
+}
+
+static void ValidateHDDModel(const configuration &state){
+  if(state.hdd_model == false){
+    return;
+  }
+
+  if(state.disk_mode_type != DISK_MODE_TYPE_HDD) {
+    printf("Invalid hdd_model :: disk_mode_type is %s\n",
+           DiskModeTypeToString(state.disk_mode_type).c_str());
+    exit(EXIT_FAILURE);
+  }
+  if(state.hdd_queue_depth == 0) {
+    printf("Invalid hdd_queue_depth :: %lu\n", state.hdd_queue_depth);
+    exit(EXIT_FAILURE);
+  }
+
+  printf("%30s : %d\n", "hdd_model", state.hdd_model);
+  printf("%30s : %lu\n", "hdd_queue_depth", state.hdd_queue_depth);
+}
+
+static void ValidateNVMModel(const configuration &state){
+  if(state.nvm_model == false){
+    return;
+  }
+
+  if(state.hierarchy_type == HIERARCHY_TYPE_DRAM_DISK) {
+    printf("Invalid nvm_model :: hierarchy_type is %s\n",
+           HierarchyTypeToString(state.hierarchy_type).c_str());
+    exit(EXIT_FAILURE);
+  }
+  if(state.nvm_write_bandwidth <= 0) {
+    printf("Invalid nvm_write_bandwidth :: %.2lf\n", state.nvm_write_bandwidth);
+    exit(EXIT_FAILURE);
+  }
+
+  printf("%30s : %d\n", "nvm_model", state.nvm_model);
+  printf("%30s : %.2lf GB/s\n", "nvm_write_bandwidth", state.nvm_write_bandwidth);
+  printf("%30s : %d\n", "nvm_wear_leveling", state.nvm_wear_leveling);
+}
+
+static void ValidateOptimizer(const configuration &state){
+  if(state.optimize == false){
+    return;
+  }
+
+  if(state.optimizer_jobs == 0) {
+    printf("Invalid optimizer_jobs :: %lu\n", state.optimizer_jobs);
+    exit(EXIT_FAILURE);
+  }
+
+  printf("%30s : %d\n", "optimize", state.optimize);
+  printf("%30s : %lu\n", "optimizer_jobs", state.optimizer_jobs);
+  for(auto entry : state.tier_prices){
+    auto label = DeviceTypeToString(entry.first) + " price";
+    printf("%30s : %.2lf $/GB\n", label.c_str(), entry.second);
+  }
+  if(state.slo_throughput > 0) {
+    printf("%30s : %.2lf\n", "slo_throughput", state.slo_throughput);
+  }
+  if(state.slo_percentile <= 0 || state.slo_percentile > 100) {
+    printf("Invalid slo_percentile :: %.2lf\n", state.slo_percentile);
+    exit(EXIT_FAILURE);
+  }
+  if(state.slo_latency > 0) {
+    printf("%30s : %.2lf\n", "slo_latency", state.slo_latency);
+    printf("%30s : %.2lf\n", "slo_percentile", state.slo_percentile);
+  }
+}
+
+void ParseTierPrices(const std::string& tier_prices, configuration &state){
+
+  std::vector<DeviceType> device_types = {
+      DEVICE_TYPE_DRAM,
+      DEVICE_TYPE_NVM,
+      DEVICE_TYPE_DISK
+  };
+
+  std::stringstream stream(tier_prices);
+  std::string token;
+  size_t device_itr = 0;
+  while(std::getline(stream, token, ',')){
+    if(device_itr >= device_types.size()){
+      printf("Too many tier prices :: %s\n", tier_prices.c_str());
+      exit(EXIT_FAILURE);
+    }
+    state.tier_prices[device_types[device_itr++]] = atof(token.c_str());
+  }
+
+}
+
+void ParseBlockSizes(const std::string& block_sizes, configuration &state){
+
+  std::vector<DeviceType> device_types = {
+      DEVICE_TYPE_CACHE,
+      DEVICE_TYPE_DRAM,
+      DEVICE_TYPE_NVM,
+      DEVICE_TYPE_DISK
+  };
+
+  std::stringstream stream(block_sizes);
+  std::string token;
+  size_t device_itr = 0;
+  while(std::getline(stream, token, ',')){
+    if(device_itr >= device_types.size()){
+      printf("Too many block sizes :: %s\n", block_sizes.c_str());
+      exit(EXIT_FAILURE);
+    }
+    state.block_sizes[device_types[device_itr++]] = atol(token.c_str());
+  }
+
+}
+
+void ParseCalibrationPaths(const std::string& calibration_paths,
+                           configuration &state){
+
+  std::stringstream stream(calibration_paths);
+  std::string token;
+  while(std::getline(stream, token, ',')){
+    auto separator = token.find('=');
+    if(separator == std::string::npos){
+      printf("Invalid calibration path :: %s\n", token.c_str());
+      exit(EXIT_FAILURE);
+    }
+    auto device_type = StringToDeviceType(token.substr(0, separator));
+    state.calibration_paths[device_type] = token.substr(separator + 1);
+  }
+
+}
+
+// DEVICE=path[:GB[:flag+flag]] with flags dsync, sync, and noatime
+void ParseEmulationTargets(const std::string& emulation_targets,
+                           configuration &state){
+
+  std::stringstream stream(emulation_targets);
+  std::string token;
+  while(std::getline(stream, token, ',')){
+    auto separator = token.find('=');
+    if(separator == std::string::npos){
+      printf("Invalid emulation target :: %s\n", token.c_str());
+      exit(EXIT_FAILURE);
+    }
+
+    auto device_type = StringToDeviceType(token.substr(0, separator));
+    std::stringstream fields(token.substr(separator + 1));
+    std::string file_path, file_size, open_flags, flag;
+    std::getline(fields, file_path, ':');
+    std::getline(fields, file_size, ':');
+    std::getline(fields, open_flags, ':');
+
+    // DRAM lives in anonymous memory, so only its size applies
+    auto& target = state.emulation_targets[device_type];
+    if(device_type == DEVICE_TYPE_DRAM){
+      printf("DRAM is emulated in memory; ignoring its file :: %s\n",
+             file_path.c_str());
+    }
+    else {
+      target.file_path = file_path;
+    }
+    if(file_size.empty() == false){
+      target.file_size = atof(file_size.c_str()) * (1024 * 1024 * 1024L);
+    }
+
+    std::stringstream flags(open_flags);
+    while(std::getline(flags, flag, '+')){
+      if(flag == "dsync"){
+        target.open_flags |= O_DSYNC;
+      }
+      else if(flag == "sync"){
+        target.open_flags |= O_SYNC;
+      }
+      else if(flag == "noatime"){
+        target.open_flags |= O_NOATIME;
+      }
+      else {
+        printf("Invalid emulation target flag :: %s\n", flag.c_str());
+        exit(EXIT_FAILURE);
+      }
+    }
+  }
+
+}
+
+// Default files and sizes for emulated devices without a target
+void SetupEmulationTargets(configuration &state){
+
+  std::map<DeviceType, std::string> file_paths = {
+      {DEVICE_TYPE_DRAM, "/data1/database"},
+      {DEVICE_TYPE_NVM, "/mnt/pmfs/database"},
+      {DEVICE_TYPE_DISK, "/data2/database"}
+  };
+
+  // Size in GB
+  std::map<DeviceType, off64_t> file_sizes = {
+      {DEVICE_TYPE_DRAM, 1},
+      {DEVICE_TYPE_NVM, (state.large_file_mode == true) ? 8 : 1},
+      {DEVICE_TYPE_DISK, (state.large_file_mode == true) ? 32 : 1}
+  };
+
+  for(auto entry : file_paths){
+    auto& target = state.emulation_targets[entry.first];
+    if(target.file_path.empty() == true){
+      target.file_path = entry.second;
+    }
+    if(target.file_size == 0){
+      target.file_size = file_sizes[entry.first] * (1024 * 1024 * 1024L);
+    }
+  }
+
+}
+
 void SetupNVMLatency(configuration &state){
 
   switch(state.latency_type){
@@ -204,6 +849,14 @@ void SetupNVMLatency(configuration &state){
 
 void ConstructDeviceList(configuration &state){
 
+  super_block_factor = state.super_block_factor;
+  lfu_aging_factor = state.lfu_aging_factor;
+  clock_max_usage = state.clock_max_usage;
+  two_q_in_ratio = state.two_q_in_ratio;
+  two_q_out_ratio = state.two_q_out_ratio;
+  lirs_hir_ratio = state.lirs_hir_ratio;
+  w_tiny_lfu_window_ratio = state.w_tiny_lfu_window_ratio;
+
   auto last_device_type = GetLastDevice(state.hierarchy_type);
   Device cache_device = DeviceFactory::GetDevice(DEVICE_TYPE_CACHE,
                                                  state,
@@ -265,18 +918,63 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.size_type = SIZE_TYPE_1;
   state.size_ratio_type = SIZE_RATIO_TYPE_1;
   state.caching_type = CACHING_TYPE_FIFO;
+  state.lfu_aging_factor = 0;
+  state.clock_max_usage = 5;
+  state.two_q_in_ratio = 0.25;
+  state.two_q_out_ratio = 0.5;
+  state.lirs_hir_ratio = 0.01;
+  state.w_tiny_lfu_window_ratio = 0.01;
   state.latency_type = LATENCY_TYPE_1;
   state.migration_frequency = 3;
   state.file_name = "";
+  state.latency_file = "";
   state.operation_count = 0;
   state.emulate = false;
+  state.emulation_backend_type = EMULATION_BACKEND_TYPE_STDIO;
+  state.data_sync = false;
+  state.io_queue_depth = 32;
+  state.io_worker_count = 0;
+  state.nvm_emulation_backend_type = EMULATION_BACKEND_TYPE_INVALID;
+  state.nvm_extra_latency = 0;
+  state.prefault_emulation_files = false;
+  state.group_commit_size = 1;
+  state.group_commit_window = 0;
+  state.reuse_emulation_files = false;
   state.large_file_mode = false;
+  state.super_block_factor = 512;
+  state.block_sizes[DEVICE_TYPE_CACHE] = DEFAULT_BLOCK_SIZE;
+  state.block_sizes[DEVICE_TYPE_DRAM] = DEFAULT_BLOCK_SIZE;
+  state.block_sizes[DEVICE_TYPE_NVM] = DEFAULT_BLOCK_SIZE;
+  state.block_sizes[DEVICE_TYPE_DISK] = DEFAULT_BLOCK_SIZE;
+  state.numa_node_count = 1;
+  state.numa_placement_type = NUMA_PLACEMENT_TYPE_FIRST_TOUCH;
+  state.numa_remote_latency = 2;
+  state.optimize = false;
+  state.tier_prices[DEVICE_TYPE_DRAM] = 8;
+  state.tier_prices[DEVICE_TYPE_NVM] = 4;
+  state.tier_prices[DEVICE_TYPE_DISK] = 0.1;
+  state.slo_throughput = 0;
+  state.slo_latency = 0;
+  state.slo_percentile = 99;
+  state.optimizer_jobs = std::max(std::thread::hardware_concurrency(), 1u);
+  state.latency_model_type = LATENCY_MODEL_TYPE_FIXED;
+  state.latency_sigma = 0.5;
+  state.prefetch_depth = 0;
+  state.ssd_model = false;
+  state.ssd_capacity = 4;
+  state.ssd_over_provisioning = 0.07;
+  state.gc_policy_type = GC_POLICY_TYPE_GREEDY;
+  state.hdd_model = false;
+  state.hdd_queue_depth = 32;
+  state.nvm_model = false;
+  state.nvm_write_bandwidth = 2;
+  state.nvm_wear_leveling = false;
 
   // Parse args
   while (1) {
     int idx = 0;
     int c = getopt_long(argc, argv,
-                        "a:c:d:e:f:m:l:o:r:s:vy:z:h",
+                        "a:b:c:d:e:f:g:i:j:k:m:n:l:o:p:q:r:s:t:u:vw:x:y:z:hA:B:C:D:E:F:G:H:I:J:K:L:M:N:O:P:Q:R:S:T:U:V:W:X:Y:Z:",
                         opts, &idx);
 
     if (c == -1) break;
@@ -285,6 +983,9 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'a':
         state.hierarchy_type = (HierarchyType)atoi(optarg);
         break;
+      case 'b':
+        ParseBlockSizes(optarg, state);
+        break;
       case 'c':
         state.caching_type = (CachingType)atoi(optarg);
         break;
@@ -297,30 +998,162 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'f':
         state.file_name = optarg;
         break;
+      case 'g':
+        ParseNumaAffinity(optarg, state);
+        break;
+      case 'i':
+        state.emulation_backend_type = (EmulationBackendType)atoi(optarg);
+        break;
+      case 'j':
+        state.data_sync = atoi(optarg);
+        break;
+      case 'k':
+        state.super_block_factor = atoi(optarg);
+        break;
       case 'm':
         state.migration_frequency = atoi(optarg);
         break;
+      case 'n':
+        state.numa_node_count = atoi(optarg);
+        break;
       case 'l':
         state.latency_type = (LatencyType)atoi(optarg);
         break;
       case 'o':
         state.operation_count = atoi(optarg);
         break;
+      case 'p':
+        state.numa_placement_type = (NumaPlacementType)atoi(optarg);
+        break;
+      case 'q':
+        state.latency_file = optarg;
+        break;
       case 'r':
         state.size_ratio_type = (SizeRatioType)atoi(optarg);
         break;
       case 's':
         state.size_type = (SizeType)atoi(optarg);
         break;
+      case 't':
+        state.latency_model_type = (LatencyModelType)atoi(optarg);
+        break;
+      case 'u':
+        state.latency_sigma = atof(optarg);
+        break;
       case 'v':
         state.verbose = atoi(optarg);
         break;
+      case 'w':
+        state.prefetch_depth = atoi(optarg);
+        break;
+      case 'x':
+        state.numa_remote_latency = atof(optarg);
+        break;
       case 'y':
         state.large_file_mode = atoi(optarg);
         break;
       case 'z':
         state.summary_file = optarg;
         break;
+      case 'A':
+        state.group_commit_size = atoi(optarg);
+        break;
+      case 'B':
+        state.group_commit_window = atof(optarg);
+        break;
+      case 'C':
+        state.ssd_capacity = atoi(optarg);
+        break;
+      case 'D':
+        state.ssd_model = atoi(optarg);
+        break;
+      case 'E':
+        state.nvm_wear_leveling = atoi(optarg);
+        break;
+      case 'F':
+        ParseEmulationTargets(optarg, state);
+        break;
+      case 'G':
+        state.gc_policy_type = (GcPolicyType)atoi(optarg);
+        break;
+      case 'H':
+        state.hdd_model = atoi(optarg);
+        break;
+      case 'I':
+        state.io_queue_depth = atoi(optarg);
+        break;
+      case 'M':
+        state.nvm_emulation_backend_type = (EmulationBackendType) atoi(optarg);
+        break;
+      case 'T':
+        state.nvm_extra_latency = atof(optarg);
+        break;
+      case 'J':
+        state.optimizer_jobs = atoi(optarg);
+        break;
+      case 'K':
+        ParseCalibrationPaths(optarg, state);
+        break;
+      case 'L':
+        state.slo_latency = atof(optarg);
+        break;
+      case 'N':
+        state.nvm_model = atoi(optarg);
+        break;
+      case 'O':
+        state.optimize = atoi(optarg);
+        break;
+      case 'P':
+        ParseTierPrices(optarg, state);
+        break;
+      case 'Q':
+        state.hdd_queue_depth = atoi(optarg);
+        break;
+      case 'R':
+        state.latency_profile = optarg;
+        break;
+      case 'S':
+        state.slo_throughput = atof(optarg);
+        break;
+      case 'U':
+        state.prefault_emulation_files = atoi(optarg);
+        break;
+      case 'V':
+        state.ssd_over_provisioning = atof(optarg);
+        break;
+      case 'W':
+        state.nvm_write_bandwidth = atof(optarg);
+        break;
+      case 'X':
+        state.reuse_emulation_files = atoi(optarg);
+        break;
+      case 'Y':
+        state.io_worker_count = atoi(optarg);
+        break;
+      case 'Z':
+        state.validation_profile = optarg;
+        break;
+      case LONG_OPTION_LFU_AGING_FACTOR:
+        state.lfu_aging_factor = atoi(optarg);
+        break;
+      case LONG_OPTION_CLOCK_MAX_USAGE:
+        state.clock_max_usage = atoi(optarg);
+        break;
+      case LONG_OPTION_TWO_Q_IN_RATIO:
+        state.two_q_in_ratio = atof(optarg);
+        break;
+      case LONG_OPTION_TWO_Q_OUT_RATIO:
+        state.two_q_out_ratio = atof(optarg);
+        break;
+      case LONG_OPTION_LIRS_HIR_RATIO:
+        state.lirs_hir_ratio = atof(optarg);
+        break;
+      case LONG_OPTION_W_TINY_LFU_WINDOW_RATIO:
+        state.w_tiny_lfu_window_ratio = atof(optarg);
+        break;
+      case LONG_OPTION_SLO_PERCENTILE:
+        state.slo_percentile = atof(optarg);
+        break;
       case 'h':
         Usage();
         break;
@@ -348,15 +1181,30 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateSizeType(state);
   ValidateSizeRatioType(state);
   ValidateLatencyType(state);
+  ValidateLatencyModel(state);
+  ValidateCalibration(state);
   ValidateCachingType(state);
   ValidateFileName(state);
   ValidateSummaryFile(state);
+  ValidateLatencyFile(state);
   ValidateMigrationFrequency(state);
   SetupNVMLatency(state);
   ValidateNVMReadLatency(state);
   ValidateNVMWriteLatency(state);
   ValidateOperationCount(state);
   ValidateLargeFileMode(state);
+  ValidateEmulationBackend(state);
+  SetupEmulationTargets(state);
+  ValidateEmulationTargets(state);
+  ValidateGroupCommit(state);
+  ValidatePrefetchDepth(state);
+  ValidateBlockSizes(state);
+  ValidateSuperBlockFactor(state);
+  ValidateNuma(state);
+  ValidateSSDModel(state);
+  ValidateHDDModel(state);
+  ValidateNVMModel(state);
+  ValidateOptimizer(state);
 
   printf("//===----------------------------------------------------------------------===//\n");
 
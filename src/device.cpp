@@ -1,109 +1,331 @@
 // DEVICE SOURCE
 
+#include <fcntl.h>
+#include <iomanip>
+#include <set>
+#include <sys/stat.h>
+#include <thread>
+
 #include "macros.h"
 #include "device.h"
 #include "configuration.h"
 #include "stats.h"
+#include "latency_model.h"
+#include "ssd_model.h"
+#include "hdd_model.h"
+#include "nvm_model.h"
+#include "calibration.h"
+#include "emulation_backend.h"
+#include "group_commit.h"
+#include "io_worker_pool.h"
+#include "validation_report.h"
 
 #define _FILE_OFFSET_BITS  64
 
 namespace machine {
 
 std::map<DeviceType, size_t> device_size;
-std::map<DeviceType, double> seq_read_latency;
-std::map<DeviceType, double> seq_write_latency;
-std::map<DeviceType, double> rnd_read_latency;
-std::map<DeviceType, double> rnd_write_latency;
 
 // Machine stats
 Stats machine_stats;
 
 Timer<std::ratio<1, 1000 * 1000 * 1000>> physical_timer;
 
+// NUMA
+size_t current_numa_node = 0;
+size_t current_client = 0;
+double numa_remote_latency = 1;
+
+// Latency model
+std::unique_ptr<LatencyModel> latency_model;
+
+// SSD model
+std::unique_ptr<SSDModel> ssd_model;
+
+// pages per flash erase block
+size_t ssd_pages_per_block = 256;
+
+// flash block erase latency (ns)
+double ssd_erase_latency = 2 * 1000 * 1000;
+
+// HDD model
+std::unique_ptr<HDDModel> hdd_model;
+
+// HDD capacity (GB)
+size_t hdd_capacity = 1024;
+
+// pages per track (~200 MB/s media rate at 7200 RPM)
+size_t hdd_pages_per_track = 400;
+
+// full rotation at 7200 RPM (ns)
+double hdd_rotation_latency = 60.0 * 1000 * 1000 * 1000 / 7200;
+
+// adjacent and full stroke seek latencies (ns)
+double hdd_track_seek_latency = 0.5 * 1000 * 1000;
+
+double hdd_full_seek_latency = 15 * 1000 * 1000;
+
+// NVM model
+std::unique_ptr<NVMModel> nvm_model;
+
+// wear tracking and leveling granularity (1 MB)
+size_t nvm_region_size = 1024 * 1024;
+
+// write-combining buffer lines (16 KB)
+size_t nvm_buffer_line_count = 64;
+
+// writes each media line sustains
+double nvm_endurance = 10 * 1000 * 1000;
+
+void SetLatencies(const DeviceType& device_type,
+                  const double& seq_read_latency,
+                  const double& seq_write_latency,
+                  const double& rnd_read_latency,
+                  const double& rnd_write_latency){
+
+  latency_model->SetPageLatency(device_type, ACCESS_TYPE_READ,
+                                PATTERN_TYPE_SEQUENTIAL, seq_read_latency);
+  latency_model->SetPageLatency(device_type, ACCESS_TYPE_WRITE,
+                                PATTERN_TYPE_SEQUENTIAL, seq_write_latency);
+  latency_model->SetPageLatency(device_type, ACCESS_TYPE_READ,
+                                PATTERN_TYPE_RANDOM, rnd_read_latency);
+  latency_model->SetPageLatency(device_type, ACCESS_TYPE_WRITE,
+                                PATTERN_TYPE_RANDOM, rnd_write_latency);
+
+  // Strided accesses are predictable but do not stream
+  latency_model->SetPageLatency(device_type, ACCESS_TYPE_READ,
+                                PATTERN_TYPE_STRIDED,
+                                (seq_read_latency + rnd_read_latency) / 2);
+  latency_model->SetPageLatency(device_type, ACCESS_TYPE_WRITE,
+                                PATTERN_TYPE_STRIDED,
+                                (seq_write_latency + rnd_write_latency) / 2);
+
+  // Streaming bandwidth follows from the sequential latency
+  latency_model->SetBandwidth(device_type, ACCESS_TYPE_READ,
+                              DEFAULT_BLOCK_SIZE / seq_read_latency);
+  latency_model->SetBandwidth(device_type, ACCESS_TYPE_WRITE,
+                              DEFAULT_BLOCK_SIZE / seq_write_latency);
+
+}
+
 void BootstrapDeviceMetrics(const configuration &state){
 
+  // NUMA remote access multiplier
+  numa_remote_latency = state.numa_remote_latency;
+
+  latency_model = LatencyModelFactory::GetLatencyModel(state);
+
   // LATENCIES (ns)
 
   // CACHE
-  seq_read_latency[DEVICE_TYPE_CACHE] = 10;
-  seq_write_latency[DEVICE_TYPE_CACHE] = 10;
-  rnd_read_latency[DEVICE_TYPE_CACHE] = 10;
-  rnd_write_latency[DEVICE_TYPE_CACHE] = 10;
+  SetLatencies(DEVICE_TYPE_CACHE, 10, 10, 10, 10);
 
   // DRAM
-  seq_read_latency[DEVICE_TYPE_DRAM] = 1000;
-  seq_write_latency[DEVICE_TYPE_DRAM] = 2000;
-  rnd_read_latency[DEVICE_TYPE_DRAM] = 2000;
-  rnd_write_latency[DEVICE_TYPE_DRAM] = 2500;
+  SetLatencies(DEVICE_TYPE_DRAM, 1000, 2000, 2000, 2500);
 
   // NVM
-  seq_read_latency[DEVICE_TYPE_NVM] = seq_read_latency[DEVICE_TYPE_DRAM];
-  seq_write_latency[DEVICE_TYPE_NVM] = seq_write_latency[DEVICE_TYPE_DRAM];
-  rnd_read_latency[DEVICE_TYPE_NVM] = rnd_read_latency[DEVICE_TYPE_DRAM];
-  rnd_write_latency[DEVICE_TYPE_NVM] = rnd_write_latency[DEVICE_TYPE_DRAM];
-
-  seq_read_latency[DEVICE_TYPE_NVM] *=  state.nvm_read_latency;
-  seq_write_latency[DEVICE_TYPE_NVM] *= state.nvm_write_latency;
-  rnd_read_latency[DEVICE_TYPE_NVM] *= state.nvm_read_latency;
-  rnd_write_latency[DEVICE_TYPE_NVM] *= state.nvm_write_latency;
+  SetLatencies(DEVICE_TYPE_NVM,
+               1000 * state.nvm_read_latency,
+               2000 * state.nvm_write_latency,
+               2000 * state.nvm_read_latency,
+               2500 * state.nvm_write_latency);
+
+  if(state.nvm_model == true){
+    auto last_device_type = GetLastDevice(state.hierarchy_type);
+    auto page_count = DeviceFactory::GetDeviceSize(DEVICE_TYPE_NVM,
+                                                   state,
+                                                   last_device_type);
+    nvm_model.reset(new NVMModel(page_count * DEFAULT_BLOCK_SIZE,
+                                 nvm_region_size,
+                                 state.nvm_write_bandwidth,
+                                 nvm_buffer_line_count,
+                                 nvm_endurance,
+                                 state.nvm_wear_leveling));
+  }
 
   // Check disk mode
 
   // SSD
   if(state.disk_mode_type == DiskModeType::DISK_MODE_TYPE_SSD){
-    seq_read_latency[DEVICE_TYPE_DISK] = 30 * 1000;
-    seq_write_latency[DEVICE_TYPE_DISK] = 100 * 1000;
-    rnd_read_latency[DEVICE_TYPE_DISK] = 50 * 1000;
-    rnd_write_latency[DEVICE_TYPE_DISK] = 150 * 1000;
+    SetLatencies(DEVICE_TYPE_DISK,
+                 30 * 1000,
+                 100 * 1000,
+                 50 * 1000,
+                 150 * 1000);
+
+    if(state.ssd_model == true){
+      size_t logical_page_count = state.ssd_capacity *
+          ((1024 * 1024 * 1024) / DEFAULT_BLOCK_SIZE);
+      ssd_model.reset(new SSDModel(logical_page_count,
+                                   state.ssd_over_provisioning,
+                                   ssd_pages_per_block,
+                                   state.gc_policy_type));
+      ssd_model->SetLatencies(30 * 1000, 100 * 1000, ssd_erase_latency);
+      ssd_model->Precondition();
+    }
   }
   // HDD
   else if(state.disk_mode_type == DiskModeType::DISK_MODE_TYPE_HDD) {
-    seq_read_latency[DEVICE_TYPE_DISK] = 1 * 1000 * 1000;
-    seq_write_latency[DEVICE_TYPE_DISK] = 1 * 1000 * 1000;
-    rnd_read_latency[DEVICE_TYPE_DISK] = 4 * 1000 * 1000;
-    rnd_write_latency[DEVICE_TYPE_DISK] = 10 * 1000 * 1000;
+    SetLatencies(DEVICE_TYPE_DISK,
+                 1 * 1000 * 1000,
+                 1 * 1000 * 1000,
+                 4 * 1000 * 1000,
+                 10 * 1000 * 1000);
+
+    if(state.hdd_model == true){
+      size_t page_count = hdd_capacity *
+          ((1024 * 1024 * 1024) / DEFAULT_BLOCK_SIZE);
+      hdd_model.reset(new HDDModel(page_count,
+                                   hdd_pages_per_track,
+                                   hdd_rotation_latency,
+                                   hdd_track_seek_latency,
+                                   hdd_full_seek_latency,
+                                   state.hdd_queue_depth));
+    }
   }
   else {
     std::cout << "Invalid disk mode type: " << state.disk_mode_type;
     exit(EXIT_FAILURE);
   }
 
+  // Measured latencies replace the defaults
+  if(state.latency_profile.empty() == false &&
+      state.calibration_paths.empty() == true){
+    auto profiles = ReadLatencyProfile(state.latency_profile);
+    for(auto entry : profiles){
+      auto& profile = entry.second;
+      SetLatencies(entry.first,
+                   profile.seq_read_latency,
+                   profile.seq_write_latency,
+                   profile.rnd_read_latency,
+                   profile.rnd_write_latency);
+
+      // Measured streaming bandwidth replaces the one derived above
+      if(profile.read_bandwidth > 0 && profile.write_bandwidth > 0){
+        latency_model->SetBandwidth(entry.first, ACCESS_TYPE_READ,
+                                    profile.read_bandwidth);
+        latency_model->SetBandwidth(entry.first, ACCESS_TYPE_WRITE,
+                                    profile.write_bandwidth);
+      }
+    }
+  }
+
 }
 
-std::vector<DeviceType> emulated_device_types =
-{
-    DeviceType::DEVICE_TYPE_DRAM,
-    DeviceType::DEVICE_TYPE_NVM,
-    DeviceType::DEVICE_TYPE_DISK
+std::map<DeviceType, bool> is_device_emulated;
+std::map<DeviceType, EmulationTarget> emulation_targets;
+std::map<DeviceType, std::unique_ptr<EmulationBackend>> emulation_backends;
+std::map<DeviceType, std::unique_ptr<GroupCommit>> group_commits;
+// workers holding flushed writes of the pending batch (pooled devices)
+std::map<DeviceType, std::set<size_t>> group_commit_workers;
+
+// A trace op that finished while its flushed blocks wait on a batch
+struct CommitWaiter {
+
+  OperationType operation_type;
+
+  DeviceType device_type;
+
+  // recorded latency (ns)
+  double latency;
+
+  size_t block_count;
+
 };
 
-std::map<DeviceType, bool> is_device_emulated;
-std::map<DeviceType, off64_t> file_sizes;
-std::map<DeviceType, std::string> file_paths;
-std::map<DeviceType, FILE*> file_pointers;
-
-std::string write_buffer;
-char read_buffer[BLOCK_SIZE*2];
-
-std::string random_string(size_t length){
-  auto randchar = []() -> char
-      {
-    const char charset[] =
-        "0123456789"
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-        "abcdefghijklmnopqrstuvwxyz";
-    const size_t max_index = (sizeof(charset) - 1);
-    return charset[ rand() % max_index ];
-      };
-  std::string str(length,0);
-  std::generate_n( str.begin(), length, randchar );
-  return str;
+// flushed blocks the running op has queued on each pending batch
+std::map<DeviceType, size_t> running_commit_blocks;
+
+std::map<DeviceType, std::vector<CommitWaiter>> commit_waiters;
+
+// A trace op that finished while its writebacks wait in the HDD queue
+struct WritebackWaiter {
+
+  OperationType operation_type;
+
+  DeviceType device_type;
+
+  // recorded latency (ns)
+  double latency;
+
+  // queue slots of its writebacks
+  std::vector<size_t> slots;
+
+};
+
+// HDD queue slots of the writebacks the running op has queued
+std::vector<size_t> running_writeback_slots;
+
+std::vector<WritebackWaiter> writeback_waiters;
+std::unique_ptr<IOWorkerPool> io_worker_pool;
+ValidationReport validation_report;
+
+// Allocate the backing file of an emulated device (runs on its own thread)
+static void PrepareEmulationFile(const EmulationTarget& target,
+                                 const bool& prefault,
+                                 const bool& reuse,
+                                 std::string& message){
+
+  auto& file_path = target.file_path;
+  auto file_size = target.file_size;
+
+  // Files left fully allocated by an earlier run are kept as they are
+  struct stat file_stat;
+  if(reuse == true &&
+      stat(file_path.c_str(), &file_stat) == 0 &&
+      file_stat.st_size == file_size &&
+      file_stat.st_blocks * 512 >= file_size){
+    message = "Reused file: " + file_path + " file_size: " + std::to_string(file_size);
+    return;
+  }
+
+  auto fd = open(file_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if(fd == -1) {
+    std::cout << "Could not open file: " << file_path << "\n";
+    exit(EXIT_FAILURE);
+  }
+
+  // Reserve blocks upfront, or leave a sparse file if unsupported
+  auto status = fallocate(fd, 0, 0, file_size);
+  if(status != 0){
+    status = ftruncate(fd, file_size);
+  }
+  if(status != 0){
+    std::cout << "Could not allocate file: " << file_path << "\n";
+    exit(EXIT_FAILURE);
+  }
+
+  // Write every block once so that emulated writes do not convert extents
+  if(prefault == true){
+    std::string buffer(1024 * 1024, 'x');
+    for(off64_t offset = 0; offset < file_size; offset += buffer.size()){
+      auto byte_count = std::min<off64_t>(buffer.size(), file_size - offset);
+      if(pwrite(fd, buffer.c_str(), byte_count, offset) != byte_count){
+        std::cout << "Could not prefault file: " << file_path << "\n";
+        exit(EXIT_FAILURE);
+      }
+    }
+  }
+
+  // Sync
+  status = fsync(fd);
+  if(status != 0){
+    std::cout << "Could not sync file: " << file_path << "\n";
+    exit(EXIT_FAILURE);
+  }
+
+  close(fd);
+  message = "Allocated file: " + file_path + " file_size: " + std::to_string(file_size);
+
 }
 
 void BootstrapFileSystemForEmulation(const configuration& state){
 
-  // Setup buffer
-  write_buffer = random_string(BLOCK_SIZE);
+  // Size buffers for the largest block
+  size_t buffer_size = DEFAULT_BLOCK_SIZE;
+  for(auto entry : state.block_sizes){
+    buffer_size = std::max(buffer_size, entry.second);
+  }
 
   is_device_emulated[DeviceType::DEVICE_TYPE_INVALID] = false;
   is_device_emulated[DeviceType::DEVICE_TYPE_CACHE] = false;
@@ -111,181 +333,539 @@ void BootstrapFileSystemForEmulation(const configuration& state){
   is_device_emulated[DeviceType::DEVICE_TYPE_NVM] = true;
   is_device_emulated[DeviceType::DEVICE_TYPE_DISK] = true;
 
-  // Large file mode
-  if(state.large_file_mode == false){
-    file_sizes[DeviceType::DEVICE_TYPE_DRAM] = 1 * (1024 * 1024 * 1024);
-    file_sizes[DeviceType::DEVICE_TYPE_NVM] = 1 * (1024 * 1024 * 1024);
-    file_sizes[DeviceType::DEVICE_TYPE_DISK] = 1 * (1024 * 1024 * 1024);
+  emulation_targets = state.emulation_targets;
+
+  // Prepare all files in parallel
+  std::vector<std::thread> threads;
+  std::vector<std::string> messages(emulation_targets.size());
+  size_t target_itr = 0;
+  for(auto& entry : emulation_targets){
+    if(EmulationBackendFactory::GetEmulationBackendType(state, entry.first) ==
+        EMULATION_BACKEND_TYPE_MEMORY){
+      messages[target_itr++] = "Emulating in memory: " + DeviceTypeToString(entry.first);
+      continue;
+    }
+    threads.push_back(std::thread(PrepareEmulationFile,
+                                  std::cref(entry.second),
+                                  state.prefault_emulation_files,
+                                  state.reuse_emulation_files,
+                                  std::ref(messages[target_itr++])));
   }
-  else {
-    file_sizes[DeviceType::DEVICE_TYPE_DRAM] = 1 * (1024 * 1024 * 1024);
-    file_sizes[DeviceType::DEVICE_TYPE_NVM] = 8 * (1024 * 1024 * 1024L);
-    file_sizes[DeviceType::DEVICE_TYPE_DISK] = 32 * (1024 * 1024 * 1024L);
+  for(auto& thread : threads){
+    thread.join();
+  }
+  for(auto& message : messages){
+    std::cout << message << "\n";
   }
 
-  file_paths[DeviceType::DEVICE_TYPE_DRAM] = "/data1/database";
-  file_paths[DeviceType::DEVICE_TYPE_NVM] = "/mnt/pmfs/database";
-  file_paths[DeviceType::DEVICE_TYPE_DISK] = "/data2/database";
+  std::cout << "Bootstrapped File System \n";
 
-  // Create and truncate files
-  for(auto device_type : emulated_device_types){
-    FILE *file_pointer = NULL;
-    int status;
+  // Workers open their own files
+  if(state.io_worker_count > 0){
+    io_worker_pool.reset(new IOWorkerPool(state,
+                                          emulation_targets,
+                                          state.io_worker_count,
+                                          state.io_queue_depth,
+                                          buffer_size));
+  }
 
-    file_pointer = fopen(file_paths[device_type].c_str(), "w");
-    if(file_pointer == NULL) {
-      std::cout << "Could not open file: " << file_paths[device_type] << "\n";
-      exit(EXIT_FAILURE);
+  // Open all files
+  for(auto& entry : emulation_targets){
+    if(io_worker_pool == nullptr || io_worker_pool->IsPooled(entry.first) == false){
+      emulation_backends[entry.first] =
+          EmulationBackendFactory::GetEmulationBackend(state,
+                                                       entry.first,
+                                                       entry.second,
+                                                       buffer_size);
     }
+    group_commits[entry.first] =
+        std::unique_ptr<GroupCommit>(new GroupCommit(state.group_commit_size,
+                                                     state.group_commit_window * 1000));
+  }
 
-    // Size in GB
-    auto file_size = file_sizes[device_type];
-    status = ftruncate(fileno(file_pointer), file_size);
-    if(status != 0){
-      std::cout << "Could not truncate file: " << file_paths[device_type] << "\n";
-      exit(EXIT_FAILURE);
+}
+
+PatternType GetPattern(std::vector<Device>& devices,
+                       const DeviceType& device_type,
+                       const size_t& next);
+
+// GET NUMA FACTOR
+
+// Latency multiplier for accessing a block on a NUMA device
+double GetNumaFactor(std::vector<Device>& devices,
+                     const DeviceType& device_type,
+                     const size_t& block_id){
+
+  for(auto& device : devices){
+    if(device.device_type == device_type){
+      if(device.node_count == 1){
+        return 1;
+      }
+
+      auto node = device.Locate(device.GetBlockId(block_id));
+      if(node == INVALID_NODE){
+        return 1;
+      }
+
+      if(node == current_numa_node % device.node_count){
+        return 1;
+      }
+      return numa_remote_latency;
     }
-    else {
-      std::cout << "Truncated file: " << file_paths[device_type] << " file_size: " << file_size << "\n";
+  }
+
+  return 1;
+}
+
+// Count a hit on a block already resident on a NUMA device as local or
+// remote (installs and migrations are not hits)
+void CountNumaHit(std::vector<Device>& devices,
+                  const DeviceType& device_type,
+                  const size_t& block_id){
+
+  for(auto& device : devices){
+    if(device.device_type == device_type){
+      if(device.node_count == 1){
+        return;
+      }
+
+      auto node = device.Locate(device.GetBlockId(block_id));
+      if(node == INVALID_NODE){
+        return;
+      }
+
+      bool is_local = (node == current_numa_node % device.node_count);
+      machine_stats.IncrementNumaHitCount(device_type, is_local);
+      return;
     }
+  }
 
-    // Sync
-    status = fsync(fileno(file_pointer));
-    if(status != 0){
-      std::cout << "Could not sync file: " << file_paths[device_type] << "\n";
-      exit(EXIT_FAILURE);
+}
+
+// SSD
+
+// Garbage collection latency of writing the given pages to the SSD
+double GetGarbageCollectionLatency(const size_t& block_id,
+                                   const size_t& byte_count){
+  double latency = 0;
+  size_t page_count = (byte_count + DEFAULT_BLOCK_SIZE - 1)/DEFAULT_BLOCK_SIZE;
+  auto logical_page_count = ssd_model->GetLogicalPageCount();
+  for(size_t page_itr = 0; page_itr < page_count; page_itr++){
+    latency += ssd_model->Write((block_id + page_itr) % logical_page_count);
+  }
+  return latency;
+}
+
+// Discard the pages of a block evicted from the SSD
+void TrimBlocks(const size_t& block_id,
+                const size_t& block_count){
+  auto logical_page_count = ssd_model->GetLogicalPageCount();
+  for(size_t page_itr = 0; page_itr < block_count; page_itr++){
+    ssd_model->Trim((block_id + page_itr) % logical_page_count);
+  }
+}
+
+// HDD
+
+// Service the HDD writeback queue and charge every op that waited on it
+// the service time of its own writebacks; returns that of the running op
+static double DrainWritebacks(){
+  auto service_times = hdd_model->Drain(logical_ns);
+
+  // Ops that already finished get theirs in the latency histograms
+  for(auto& waiter : writeback_waiters){
+    double latency = 0;
+    for(auto slot : waiter.slots){
+      latency += service_times[slot];
     }
+    machine_stats.ChargeLatency(waiter.operation_type,
+                                waiter.device_type,
+                                waiter.latency,
+                                latency);
+  }
+  writeback_waiters.clear();
 
-    // Close file
-    status = fclose(file_pointer);
-    if(status != 0){
-      std::cout << "Could not close file: " << file_paths[device_type] << "\n";
-      exit(EXIT_FAILURE);
+  double running_latency = 0;
+  for(auto slot : running_writeback_slots){
+    running_latency += service_times[slot];
+  }
+  running_writeback_slots.clear();
+  return running_latency;
+}
+
+// Mechanical latency of accessing the given pages on the HDD
+// Writebacks are queued and serviced in elevator order
+double GetMechanicalLatency(const size_t& block_id,
+                            const size_t& byte_count,
+                            const bool& is_writeback){
+  size_t page_count = (byte_count + DEFAULT_BLOCK_SIZE - 1)/DEFAULT_BLOCK_SIZE;
+  auto page = block_id % hdd_model->GetPageCount();
+  if(is_writeback == true){
+    running_writeback_slots.push_back(hdd_model->GetPendingCount());
+    if(hdd_model->QueueWrite(page, page_count) == false){
+      return 0;
     }
+    return DrainWritebacks();
+  }
+  return hdd_model->Access(page, page_count, logical_ns);
+}
+
+// NVM
 
+// Stall of writing the given pages through the NVM write buffer
+double GetWriteThrottlingLatency(const size_t& block_id,
+                                 const size_t& byte_count){
+  auto page_count = nvm_model->GetCapacity() / DEFAULT_BLOCK_SIZE;
+  auto address = (block_id % page_count) * DEFAULT_BLOCK_SIZE;
+  return nvm_model->Write(address, byte_count, logical_ns);
+}
+
+void PrintDeviceLifetime(const double& duration_ns){
+  if(nvm_model){
+    auto lifetime_s = nvm_model->GetLifetime(duration_ns);
+    std::cout << "NVM LIFETIME (years): "
+        << lifetime_s / (365.0 * 24 * 60 * 60) << "\n";
   }
+}
 
-  std::cout << "Bootstrapped File System \n";
+void PrintDeviceModels(){
+  if(ssd_model){
+    std::cout << *ssd_model;
+  }
+  if(hdd_model){
+    std::cout << *hdd_model;
+  }
+  if(nvm_model){
+    std::cout << *nvm_model;
+  }
+  if(group_commits.empty() == false){
+    std::cout << "GROUP COMMIT: \n";
+    for(auto& entry : group_commits){
+      std::cout << std::setw(10) << DeviceTypeToString(entry.first) << " :: "
+          << *entry.second;
+    }
+  }
+  if(io_worker_pool){
+    std::cout << *io_worker_pool;
+  }
+  if(emulate == true){
+    std::cout << validation_report;
+  }
+}
 
-  // Open all files
-  for(auto device_type : emulated_device_types){
-    FILE *file_pointer = NULL;
+void WriteValidationProfile(const std::string& profile_file){
+  WriteLatencyProfile(profile_file,
+                      validation_report.GetSuggestedProfiles(*latency_model));
+  std::cout << "Wrote suggested latency profile: " << profile_file << "\n";
+}
 
-    file_pointer = fopen(file_paths[device_type].c_str(), "rw+");
-    if(file_pointer == NULL) {
-      std::cout << "Could not open file: " << file_paths[device_type] << "\n";
-      exit(EXIT_FAILURE);
+void ResetDeviceModelStats(){
+  if(ssd_model){
+    ssd_model->ResetStats();
+  }
+  if(hdd_model){
+    hdd_model->ResetStats();
+  }
+  if(nvm_model){
+    nvm_model->ResetStats();
+  }
+  for(auto& entry : group_commits){
+    entry.second->ResetStats();
+  }
+  commit_waiters.clear();
+  writeback_waiters.clear();
+  if(io_worker_pool){
+    io_worker_pool->ResetStats();
+  }
+  validation_report.Reset();
+}
+
+// Writebacks are spread across workers; client I/O stays on one worker
+size_t next_writeback_worker = 0;
+
+// Perform emulated I/O inline, or queue it on a worker
+static void EmulateIO(const DeviceType& device_type,
+                      const OperationType& operation_type,
+                      const off64_t& offset,
+                      const size_t& byte_count,
+                      const size_t& worker){
+
+  if(io_worker_pool && io_worker_pool->IsPooled(device_type)){
+    IORequest request;
+    request.device_type = device_type;
+    request.operation_type = operation_type;
+    request.offset = offset;
+    request.byte_count = byte_count;
+    auto ticket = io_worker_pool->Submit(worker, request);
+
+    // The op needs the data it reads; only prefetches may run behind
+    if(operation_type == OPERATION_TYPE_READ && device_type != prefetch_source){
+      io_worker_pool->Wait(worker, ticket);
     }
+    return;
+  }
+
+  auto& emulation_backend = emulation_backends[device_type];
+  switch(operation_type){
+    case OPERATION_TYPE_READ:
+      // Prefetches do not wait for the data
+      if(device_type == prefetch_source){
+        emulation_backend->Prefetch(offset, byte_count);
+      }
+      else {
+        emulation_backend->Read(offset, byte_count);
+      }
+      break;
+    case OPERATION_TYPE_WRITE:
+      emulation_backend->Write(offset, byte_count);
+      break;
+    case OPERATION_TYPE_FLUSH:
+      emulation_backend->Sync();
+      break;
+    default:
+      break;
+  }
 
-    // Cache file pointer
-    file_pointers[device_type] = file_pointer;
+}
+
+// Sync the pending batch of an emulated device and charge every op that
+// waited on it its share; returns the share of the running op
+static double SyncGroupCommit(const DeviceType& device_type){
+  auto sync_start = physical_timer.GetDuration();
+  double sync_latency = 0;
+  physical_timer.Start();
+  if(io_worker_pool && io_worker_pool->IsPooled(device_type)){
+    // The batch may be spread over several workers; each syncs after the
+    // writes it has queued, and the sync is timed there, not at enqueue
+    auto& workers = group_commit_workers[device_type];
+    sync_latency = io_worker_pool->Sync(device_type, workers);
+    workers.clear();
+    physical_timer.Stop();
+  }
+  else {
+    EmulateIO(device_type, OPERATION_TYPE_FLUSH, 0, 0, current_client);
+    physical_timer.Stop();
+    sync_latency = physical_timer.GetDuration() - sync_start;
+  }
+
+  auto latency_share = group_commits[device_type]->Commit(sync_latency, logical_ns);
+  machine_stats.IncrementSyncCount(device_type);
 
+  // Ops that already finished get their share in the latency histograms
+  for(auto& waiter : commit_waiters[device_type]){
+    machine_stats.ChargeLatency(waiter.operation_type,
+                                waiter.device_type,
+                                waiter.latency,
+                                latency_share * waiter.block_count);
   }
+  commit_waiters[device_type].clear();
 
+  auto& running_block_count = running_commit_blocks[device_type];
+  auto running_latency = latency_share * running_block_count;
+  running_block_count = 0;
+  return running_latency;
 }
 
-bool IsSequential(std::vector<Device>& devices,
-                  const DeviceType& device_type,
-                  const size_t& next);
+// Sync the batches whose window ran out on the logical clock, even if no
+// flushed block arrived since; returns the share of the running op
+static double SyncDueGroupCommits(){
+  double running_latency = 0;
+  for(auto& entry : group_commits){
+    if(entry.second->IsDue(logical_ns) == true){
+      running_latency += SyncGroupCommit(entry.first);
+    }
+  }
+  return running_latency;
+}
 
-std::string GetPattern(bool is_sequential){
-  if(is_sequential == true){
-    return "SEQ";
+void WaitOnPendingWrites(const OperationType& operation_type,
+                         const DeviceType& device_type,
+                         const double& latency){
+  if(running_writeback_slots.empty() == false){
+    WritebackWaiter waiter;
+    waiter.operation_type = operation_type;
+    waiter.device_type = device_type;
+    waiter.latency = latency;
+    waiter.slots.swap(running_writeback_slots);
+    writeback_waiters.push_back(waiter);
+  }
+
+  for(auto& entry : running_commit_blocks){
+    if(entry.second == 0){
+      continue;
+    }
+
+    CommitWaiter waiter;
+    waiter.operation_type = operation_type;
+    waiter.device_type = device_type;
+    waiter.latency = latency;
+    waiter.block_count = entry.second;
+    commit_waiters[entry.first].push_back(waiter);
+    entry.second = 0;
+  }
+}
+
+// Sync the pending batch of every emulated device
+void FlushGroupCommits(){
+  for(auto& entry : group_commits){
+    if(entry.second->GetPendingCount() == 0){
+      continue;
+    }
+    SyncGroupCommit(entry.first);
   }
-  return "RND";
+}
+
+void DrainIOWorkers(){
+  if(io_worker_pool){
+    physical_timer.Start();
+    io_worker_pool->Drain();
+    physical_timer.Stop();
+  }
+}
+
+// GET EMULATION OFFSET
+
+off64_t GetEmulationOffset(const DeviceType& device_type,
+                           const size_t& block_id,
+                           const size_t& byte_count){
+  // The access must fit after at least one page
+  auto file_size = (size_t) emulation_targets[device_type].file_size;
+  if(byte_count + DEFAULT_BLOCK_SIZE > file_size){
+    std::cout << "Emulation file too small for access: " << byte_count << "\n";
+    exit(EXIT_FAILURE);
+  }
+
+  // Offsets stay page aligned for O_DIRECT
+  auto page_count = (file_size - byte_count) / DEFAULT_BLOCK_SIZE;
+  return (block_id % page_count) * DEFAULT_BLOCK_SIZE;
 }
 
 // GET READ & WRITE LATENCY
 
-size_t sync_frequency = 1;
+// Whether an emulated access is done once it returns, so that its
+// measured latency covers the I/O (queued I/O, and asynchronous writes and
+// prefetches, complete later; pooled reads are waited for, but also wait
+// behind the requests queued ahead of them)
+static bool IsIOInline(const DeviceType& device_type,
+                       const AccessType& access_type){
+
+  if(io_worker_pool && io_worker_pool->IsPooled(device_type)){
+    return false;
+  }
+
+  if(access_type == ACCESS_TYPE_READ && device_type != prefetch_source){
+    return true;
+  }
+
+  return emulation_backends[device_type]->IsAsynchronous() == false;
+}
+
+// Compare the modeled latency of an emulated access with its measured one
+// (only inline I/O is measured)
+static void RecordValidation(const DeviceType& device_type,
+                             const AccessType& access_type,
+                             const PatternType& pattern_type,
+                             const double& modeled_latency,
+                             const double& measured_latency){
+
+  if(measured_latency < 0 || IsIOInline(device_type, access_type) == false){
+    return;
+  }
 
-size_t GetWriteLatency(std::vector<Device>& devices,
+  validation_report.Record(device_type,
+                           access_type,
+                           pattern_type,
+                           latency_model->GetPageLatency(device_type, access_type, pattern_type),
+                           modeled_latency,
+                           measured_latency);
+
+}
+
+double GetWriteLatency(std::vector<Device>& devices,
                        DeviceType device_type,
                        const size_t& block_id,
-                       const bool& flush_block){
+                       const bool& flush_block,
+                       const size_t& byte_count){
 
   DLOG(INFO) << "WRITE :: " << DeviceTypeToString(device_type) << "\n";
 
   // Increment stats
   machine_stats.IncrementWriteCount(device_type);
+  machine_stats.IncrementWriteBytes(device_type, byte_count);
   if(flush_block == true){
     machine_stats.IncrementFlushCount(device_type);
   }
 
+  // Share of the group commits synced during this access
+  double commit_latency = 0;
+  if(emulate == true){
+    commit_latency += SyncDueGroupCommits();
+  }
+
   // Emulate if needed
+  double measured_latency = -1;
   if(emulate == true && is_device_emulated[device_type] == true){
-    // Seek
-    auto max_size = file_sizes[device_type];
-    auto location = (block_id * BLOCK_SIZE) % max_size;
-
-    physical_timer.Start();
-    auto status = fseek(file_pointers[device_type], location, SEEK_SET);
-    physical_timer.Stop();
-
-    if(status != 0){
-      perror("seek");
-      exit(EXIT_FAILURE);
-    }
+    auto location = GetEmulationOffset(device_type, block_id, byte_count);
 
     // Write
+    auto worker = (flush_block == true) ? current_client : next_writeback_worker++;
+    auto write_start = physical_timer.GetDuration();
     physical_timer.Start();
-    auto write_size = fwrite(write_buffer.c_str(), write_buffer.size(), 1,
-                             file_pointers[device_type]);
+    EmulateIO(device_type, OPERATION_TYPE_WRITE, location, byte_count, worker);
     physical_timer.Stop();
+    measured_latency = physical_timer.GetDuration() - write_start;
 
-    if(write_size == 0){
-      std::cout << "Writing error: " << file_paths[device_type];
-      std::cout << " "  << file_paths[device_type];
-      std::cout << " "  << "write_size: " << write_size << "\n";
-      perror("write");
-      exit(EXIT_FAILURE);
+    if(flush_block == true && io_worker_pool && io_worker_pool->IsPooled(device_type)){
+      group_commit_workers[device_type].insert(worker % io_worker_pool->GetWorkerCount());
     }
 
-    // Flush if needed
+    // Sync once the batch of flushed blocks is full or has waited too long
     if(flush_block == true){
-
-      physical_timer.Start();
-      status = fflush(file_pointers[device_type]);
-      physical_timer.Stop();
-
-      if(status != 0){
-        perror("fflush");
-        exit(EXIT_FAILURE);
-      }
-
-      // Sync if needed
-      auto sync = rand() % sync_frequency;
-      if(sync == 0){
-
-        physical_timer.Start();
-        status = fsync(fileno(file_pointers[device_type]));
-        physical_timer.Stop();
-
-        if(status != 0){
-          perror("fsync");
-          exit(EXIT_FAILURE);
-        }
-        machine_stats.IncrementSyncCount(device_type);
+      running_commit_blocks[device_type]++;
+      if(group_commits[device_type]->Add(logical_ns) == true){
+        commit_latency += SyncGroupCommit(device_type);
       }
-
     }
 
   }
 
-  // Check if sequential or random?
-  bool is_sequential = IsSequential(devices, device_type, block_id);
+  // Check if sequential, strided, or random?
+  auto pattern_type = GetPattern(devices, device_type, block_id);
+
+  // Check if local or remote?
+  auto numa_factor = GetNumaFactor(devices, device_type, block_id);
 
   switch(device_type){
     case DEVICE_TYPE_CACHE:
     case DEVICE_TYPE_DRAM:
     case DEVICE_TYPE_NVM:
     case DEVICE_TYPE_DISK: {
-      if(is_sequential == true){
-        return seq_write_latency[device_type];
+      double latency = 0;
+
+      // Head movement replaces the pattern-based disk latency
+      if(device_type == DEVICE_TYPE_DISK && hdd_model){
+        latency = GetMechanicalLatency(block_id, byte_count, !flush_block);
       }
       else {
-        return rnd_write_latency[device_type];
+        latency = numa_factor * latency_model->GetLatency(device_type,
+                                                          ACCESS_TYPE_WRITE,
+                                                          pattern_type,
+                                                          byte_count);
+
+        // Garbage collection stalls the write that triggered it
+        if(device_type == DEVICE_TYPE_DISK && ssd_model){
+          latency += GetGarbageCollectionLatency(block_id, byte_count);
+        }
+
+        // So does a full NVM write queue
+        if(device_type == DEVICE_TYPE_NVM && nvm_model){
+          latency += GetWriteThrottlingLatency(block_id, byte_count);
+        }
       }
+
+      RecordValidation(device_type, ACCESS_TYPE_WRITE, pattern_type,
+                       latency, measured_latency);
+      return latency + commit_latency;
     }
 
     case DEVICE_TYPE_INVALID:
@@ -298,46 +878,40 @@ size_t GetWriteLatency(std::vector<Device>& devices,
   }
 }
 
-size_t GetReadLatency(std::vector<Device>& devices,
+double GetReadLatency(std::vector<Device>& devices,
                       DeviceType device_type,
-                      const size_t& block_id){
+                      const size_t& block_id,
+                      const size_t& byte_count){
 
   DLOG(INFO) << "READ :: " << DeviceTypeToString(device_type) << "\n";
 
   // Increment stats
   machine_stats.IncrementReadCount(device_type);
+  machine_stats.IncrementReadBytes(device_type, byte_count);
 
-  // Check if sequential or random?
-  bool is_sequential = IsSequential(devices, device_type, block_id);
+  // Share of the group commits synced during this access
+  double commit_latency = 0;
+  if(emulate == true){
+    commit_latency += SyncDueGroupCommits();
+  }
 
-  // Emulate if needed
-  if(emulate == true && is_device_emulated[device_type] == true){
-    // Seek
-    auto max_size = file_sizes[device_type];
-    auto location = (block_id * BLOCK_SIZE) % max_size;
+  // Check if sequential, strided, or random?
+  auto pattern_type = GetPattern(devices, device_type, block_id);
 
-    physical_timer.Start();
-    auto status = fseek(file_pointers[device_type], location, SEEK_SET);
-    physical_timer.Stop();
+  // Check if local or remote?
+  auto numa_factor = GetNumaFactor(devices, device_type, block_id);
 
-    if(status != 0){
-      perror("seek");
-      exit(EXIT_FAILURE);
-    }
+  // Emulate if needed
+  double measured_latency = -1;
+  if(emulate == true && is_device_emulated[device_type] == true){
+    auto location = GetEmulationOffset(device_type, block_id, byte_count);
 
     // Read
+    auto read_start = physical_timer.GetDuration();
     physical_timer.Start();
-    auto read_size = fread(read_buffer, BLOCK_SIZE, 1, file_pointers[device_type]);
+    EmulateIO(device_type, OPERATION_TYPE_READ, location, byte_count, current_client);
     physical_timer.Stop();
-
-    if(read_size != 1){
-      std::cout << "Reading error: " << file_pointers[device_type];
-      std::cout << " "  << file_paths[device_type];
-      std::cout << " "  << "read_size: " << read_size << "\n";
-      perror("read");
-      exit(EXIT_FAILURE);
-    }
-
+    measured_latency = physical_timer.GetDuration() - read_start;
   }
 
   switch(device_type){
@@ -345,12 +919,20 @@ size_t GetReadLatency(std::vector<Device>& devices,
     case DEVICE_TYPE_DRAM:
     case DEVICE_TYPE_NVM:
     case DEVICE_TYPE_DISK: {
-      if(is_sequential == true){
-        return seq_read_latency[device_type];
+      double latency = 0;
+      if(device_type == DEVICE_TYPE_DISK && hdd_model){
+        latency = GetMechanicalLatency(block_id, byte_count, false);
       }
       else {
-        return rnd_read_latency[device_type];
+        latency = numa_factor * latency_model->GetLatency(device_type,
+                                                          ACCESS_TYPE_READ,
+                                                          pattern_type,
+                                                          byte_count);
       }
+
+      RecordValidation(device_type, ACCESS_TYPE_READ, pattern_type,
+                       latency, measured_latency);
+      return latency + commit_latency;
     }
 
     case DEVICE_TYPE_INVALID:
@@ -363,24 +945,128 @@ size_t GetReadLatency(std::vector<Device>& devices,
   }
 }
 
+// DEVICE
+
+Block Device::Put(const size_t& device_block_id, const size_t& block_status){
+
+  if(node_count == 1){
+    return caches[0].Put(device_block_id, block_status);
+  }
+
+  // Existing blocks stay on their node
+  auto node = Locate(device_block_id);
+  if(node == INVALID_NODE){
+    node = GetPlacementNode(device_block_id);
+  }
+
+  auto victim = caches[node].Put(device_block_id, block_status);
+  (*node_map)[device_block_id] = node;
+  if(victim.block_id != INVALID_KEY){
+    node_map->erase(victim.block_id);
+  }
+
+  return victim;
+}
+
+int Device::Get(const size_t& device_block_id){
+
+  if(node_count == 1){
+    return caches[0].Get(device_block_id);
+  }
+
+  auto node = Locate(device_block_id);
+  if(node == INVALID_NODE){
+    return INVALID_VALUE;
+  }
+
+  return caches[node].Get(device_block_id);
+}
+
+void Device::Erase(const size_t& device_block_id){
+
+  if(node_count == 1){
+    caches[0].Erase(device_block_id);
+    return;
+  }
+
+  auto node = Locate(device_block_id);
+  if(node != INVALID_NODE){
+    caches[node].Erase(device_block_id);
+    node_map->erase(device_block_id);
+  }
+
+}
+
+size_t Device::Locate(const size_t& device_block_id) const{
+
+  if(node_count == 1){
+    return 0;
+  }
+
+  auto entry = node_map->find(device_block_id);
+  if(entry == node_map->end()){
+    return INVALID_NODE;
+  }
+
+  return entry->second;
+}
+
+size_t Device::GetPlacementNode(const size_t& device_block_id) const{
+
+  switch(numa_placement_type){
+    case NUMA_PLACEMENT_TYPE_INTERLEAVE:
+      return device_block_id % node_count;
+
+    case NUMA_PLACEMENT_TYPE_FIRST_TOUCH:
+    case NUMA_PLACEMENT_TYPE_MIGRATE:
+      return current_numa_node % node_count;
+
+    default: {
+      std::cout << "GetPlacementNode: Get invalid placement type";
+      exit(EXIT_FAILURE);
+    }
+  }
+
+}
+
+size_t Device::GetSize() const{
+  size_t size = 0;
+  for(auto& cache : caches){
+    size += cache.GetSize();
+  }
+  return size;
+}
+
+size_t Device::GetCapacity() const{
+  size_t capacity = 0;
+  for(auto& cache : caches){
+    capacity += cache.GetCapacity();
+  }
+  return capacity;
+}
+
+PatternType Device::GetPattern(const size_t& device_block_id){
+  return stream_detector->Classify(device_block_id);
+}
+
 // LOCATE IN DEVICE
 
-bool LocateInDevice(Device device,
+bool LocateInDevice(Device& device,
                     const size_t& block_id){
 
   // Check device cache
-  auto value = device.cache.Get(block_id);
-  if(value == INVALID_VALUE){
+  auto value = device.Get(device.GetBlockId(block_id));
+  if(value == (int) INVALID_VALUE){
     return false;
   }
 
   return true;
 }
 
-DeviceType LocateInDevices(std::vector<Device> devices,
+DeviceType LocateInDevices(std::vector<Device>& devices,
                            const size_t& block_id){
 
-  for(auto device : devices){
+  for(auto& device : devices){
     auto found = LocateInDevice(device, block_id);
     if(found == true){
       return device.device_type;
@@ -407,6 +1093,18 @@ size_t GetDeviceOffset(std::vector<Device>& devices,
   exit(EXIT_FAILURE);
 }
 
+// GET BLOCK SIZE
+
+size_t GetBlockSize(std::vector<Device>& devices,
+                    const DeviceType& device_type){
+  for(auto& device : devices){
+    if(device.device_type == device_type){
+      return device.block_size;
+    }
+  }
+  return DEFAULT_BLOCK_SIZE;
+}
+
 // DEVICE EXISTS?
 
 bool DeviceExists(std::vector<Device>& devices,
@@ -419,17 +1117,28 @@ bool DeviceExists(std::vector<Device>& devices,
   return false;
 }
 
-// IS SEQUENTIAL?
+// GET ACCESS PATTERN
 
-bool IsSequential(std::vector<Device>& devices,
-                  const DeviceType& device_type,
-                  const size_t& next){
-  for(auto device : devices){
+DeviceType prefetch_source = DEVICE_TYPE_INVALID;
+DeviceType prefetch_destination = DEVICE_TYPE_INVALID;
+
+PatternType GetPattern(std::vector<Device>& devices,
+                       const DeviceType& device_type,
+                       const size_t& next){
+
+  // Prefetches stream along an already detected pattern
+  if(device_type == prefetch_source || device_type == prefetch_destination){
+    return PATTERN_TYPE_SEQUENTIAL;
+  }
+
+  for(auto& device : devices){
     if(device.device_type == device_type){
-      return device.cache.IsSequential(next);
+      auto pattern_type = device.GetPattern(device.GetBlockId(next));
+      machine_stats.IncrementPatternCount(device_type, pattern_type);
+      return pattern_type;
     }
   }
-  return false;
+  return PATTERN_TYPE_RANDOM;
 }
 
 // GET DEVICE LOWER IN THE HIERARCHY
@@ -502,6 +1211,7 @@ std::string CleanStatus(const size_t& block_status, const bool& check_block){
 void MoveVictim(std::vector<Device>& devices,
                 DeviceType source,
                 const size_t& block_id,
+                const size_t& block_count,
                 const size_t& block_status,
                 double& total_duration);
 
@@ -513,7 +1223,71 @@ void Copy(std::vector<Device>& devices,
           const bool& flush_block,
           double& total_duration){
 
-  DLOG(INFO) << "COPY : " << block_id << " " << " " \
+  CopyBlocks(devices,
+             destination,
+             source,
+             block_id,
+             1,
+             block_status,
+             flush_block,
+             total_duration,
+             total_duration);
+
+}
+
+void Copy(std::vector<Device>& devices,
+          DeviceType destination,
+          DeviceType source,
+          const size_t& block_id,
+          const size_t& block_status,
+          const bool& flush_block,
+          double& total_duration,
+          double& victim_duration){
+
+  CopyBlocks(devices,
+             destination,
+             source,
+             block_id,
+             1,
+             block_status,
+             flush_block,
+             total_duration,
+             victim_duration);
+
+}
+
+void CopyBlocks(std::vector<Device>& devices,
+                DeviceType destination,
+                DeviceType source,
+                const size_t& block_id,
+                const size_t& block_count,
+                const size_t& block_status,
+                const bool& flush_block,
+                double& total_duration){
+
+  CopyBlocks(devices,
+             destination,
+             source,
+             block_id,
+             block_count,
+             block_status,
+             flush_block,
+             total_duration,
+             total_duration);
+
+}
+
+void CopyBlocks(std::vector<Device>& devices,
+                DeviceType destination,
+                DeviceType source,
+                const size_t& block_id,
+                const size_t& block_count,
+                const size_t& block_status,
+                const bool& flush_block,
+                double& total_duration,
+                double& victim_duration){
+
+  DLOG(INFO) << "COPY : " << block_id << " " << block_count << " " \
       << DeviceTypeToString(source) << " " \
       << "---> " << DeviceTypeToString(destination) << " " \
       << CleanStatus(block_status, true) << "\n";
@@ -524,23 +1298,118 @@ void Copy(std::vector<Device>& devices,
   // Write to destination device
   auto device_offset = GetDeviceOffset(devices, destination);
   auto last_device_type = devices.back().device_type;
-  auto device_cache = devices[device_offset].cache;
+  auto& destination_device = devices[device_offset];
   auto final_block_status = block_status;
-  if(last_device_type == destination){
+  auto is_last_device = (last_device_type == destination);
+  if(is_last_device == true){
     final_block_status = CLEAN_BLOCK;
   }
-  auto victim = device_cache.Put(block_id, final_block_status);
 
-  total_duration += GetReadLatency(devices, source, block_id);
-  total_duration += GetWriteLatency(devices, destination, block_id, flush_block);
+  // Split or merge the trace blocks into destination blocks
+  auto source_block_size = GetBlockSize(devices, source);
+  auto destination_block_size = destination_device.block_size;
+  auto first_block_id = destination_device.GetBlockId(block_id);
+  auto last_block_id = destination_device.GetBlockId(block_id + block_count - 1);
+  auto is_merge = (destination_block_size > source_block_size);
+
+  // The source is read at its own granularity
+  auto byte_count = (last_block_id - first_block_id + 1) * destination_block_size;
+  byte_count = std::max(byte_count, source_block_size);
+  total_duration += GetReadLatency(devices, source, block_id, byte_count);
+
+  for(auto device_block_id = first_block_id;
+      device_block_id <= last_block_id;
+      device_block_id++){
+
+    // Do not lose dirty data already merged into the destination block
+    auto merged_block_status = final_block_status;
+    if(is_merge == true && is_last_device == false){
+      auto current_block_status = destination_device.Get(device_block_id);
+      if(current_block_status == (int) DIRTY_BLOCK){
+        merged_block_status = DIRTY_BLOCK;
+      }
+    }
+
+    auto victim = destination_device.Put(device_block_id,
+                                         merged_block_status);
+
+    total_duration += GetWriteLatency(devices,
+                                      destination,
+                                      destination_device.GetFirstBlockId(device_block_id),
+                                      flush_block,
+                                      destination_block_size);
+
+    // Move victim
+    auto victim_key = victim.block_id;
+    auto victim_status = victim.block_type;
+    if(victim_key != INVALID_KEY){
+      victim_key = destination_device.GetFirstBlockId(victim_key);
+
+      // Evicted flash pages are discarded
+      if(destination == DEVICE_TYPE_DISK && ssd_model){
+        TrimBlocks(victim_key, destination_device.block_factor);
+      }
+    }
+
+    MoveVictim(devices,
+               destination,
+               victim_key,
+               destination_device.block_factor,
+               victim_status,
+               victim_duration);
+  }
+
+}
+
+// MIGRATE TO LOCAL NODE
+
+void MigrateToLocalNode(std::vector<Device>& devices,
+                        DeviceType device_type,
+                        const size_t& block_id,
+                        double& total_duration){
+
+  auto device_offset = GetDeviceOffset(devices, device_type);
+  auto& device = devices[device_offset];
+  if(device.node_count == 1){
+    return;
+  }
+
+  auto device_block_id = device.GetBlockId(block_id);
+  auto source_node = device.Locate(device_block_id);
+  auto local_node = current_numa_node % device.node_count;
+  if(source_node == INVALID_NODE || source_node == local_node){
+    return;
+  }
+
+  DLOG(INFO) << "MIGRATE : " << block_id << " " \
+      << DeviceTypeToString(device_type) << " " \
+      << source_node << " ---> " << local_node << "\n";
+
+  // Increment stats
+  machine_stats.IncrementNumaMigrationCount(device_type);
+
+  // Read from the remote node
+  auto block_status = device.Get(device_block_id);
+  auto first_block_id = device.GetFirstBlockId(device_block_id);
+  total_duration += GetReadLatency(devices, device_type, first_block_id,
+                                   device.block_size);
+
+  // Write to the local node
+  device.Erase(device_block_id);
+  auto victim = device.Put(device_block_id, block_status);
+  total_duration += GetWriteLatency(devices, device_type, first_block_id,
+                                    false, device.block_size);
 
   // Move victim
   auto victim_key = victim.block_id;
-  auto victim_status = victim.block_type;
+  if(victim_key != INVALID_KEY){
+    victim_key = device.GetFirstBlockId(victim_key);
+  }
   MoveVictim(devices,
-             destination,
+             device_type,
              victim_key,
-             victim_status,
+             device.block_factor,
+             victim.block_type,
              total_duration);
 
 }
@@ -565,6 +1434,7 @@ size_t GetSizeRatio(const SizeRatioType& size_ratio){
 void MoveVictim(std::vector<Device>& devices,
                 DeviceType source,
                 const size_t& block_id,
+                const size_t& block_count,
                 const size_t& block_status,
                 double& total_duration){
 
@@ -587,13 +1457,14 @@ void MoveVictim(std::vector<Device>& devices,
       auto destination = GetLowerDevice(devices, source);
 
       // Copy to lower device
-      Copy(devices,
-           destination,
-           source,
-           block_id,
-           block_status,
-           flush_block,
-           total_duration);
+      CopyBlocks(devices,
+                 destination,
+                 source,
+                 block_id,
+                 block_count,
+                 block_status,
+                 flush_block,
+                 total_duration);
     }
   }
 
@@ -601,9 +1472,9 @@ void MoveVictim(std::vector<Device>& devices,
 
 // DEVICE FACTORY
 
-Device DeviceFactory::GetDevice(const DeviceType& device_type,
-                                const configuration& state,
-                                const DeviceType& last_device_type){
+size_t DeviceFactory::GetDeviceSize(const DeviceType& device_type,
+                                    const configuration& state,
+                                    const DeviceType& last_device_type){
 
   // SIZES (4K blocks)
 
@@ -659,12 +1530,44 @@ Device DeviceFactory::GetDevice(const DeviceType& device_type,
         size = 1024 * 1024;
       }
 
+      return size * scale_factor;
+    }
+
+    case DEVICE_TYPE_INVALID:
+    default: {
+      std::cout << "GetDeviceSize: Get invalid device";
+      exit(EXIT_FAILURE);
+    }
+  }
+
+}
+
+Device DeviceFactory::GetDevice(const DeviceType& device_type,
+                                const configuration& state,
+                                const DeviceType& last_device_type){
+
+  switch (device_type){
+    case DEVICE_TYPE_CACHE:
+    case DEVICE_TYPE_DRAM:
+    case DEVICE_TYPE_NVM:
+    case DEVICE_TYPE_DISK:  {
+      auto size = GetDeviceSize(device_type, state, last_device_type);
+
       // Setup clean fraction
       double clean_fraction = 0;
 
+      // Only DRAM and NVM are split across NUMA nodes
+      size_t node_count = 1;
+      if(device_type == DEVICE_TYPE_DRAM || device_type == DEVICE_TYPE_NVM){
+        node_count = state.numa_node_count;
+      }
+
       return Device(device_type,
                     state.caching_type,
-                    size * scale_factor,
+                    size,
+                    state.block_sizes.at(device_type),
+                    node_count,
+                    state.numa_placement_type,
                     clean_fraction
       );
     }
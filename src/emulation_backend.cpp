@@ -0,0 +1,817 @@
+// EMULATION BACKEND SOURCE
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <linux/magic.h>
+#include <random>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+#ifdef HAVE_IO_URING
+#include <sys/syscall.h>
+#endif
+
+#include "emulation_backend.h"
+#include "configuration.h"
+
+namespace machine {
+
+const size_t DirectBackend::ALIGNMENT;
+const size_t MmapBackend::CACHE_LINE_SIZE;
+const size_t MemoryBackend::HUGE_PAGE_SIZE;
+#ifdef HAVE_IO_URING
+const size_t UringBackend::NO_READ_BUFFER;
+#endif
+
+// Emulation keeps its own generator so that the number of backends does not
+// perturb rand(), which drives the simulated migrations
+static std::minstd_rand emulation_generator;
+
+// Fill a buffer with random characters
+static void FillRandom(char* buffer, const size_t& length){
+  const char charset[] =
+      "0123456789"
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+      "abcdefghijklmnopqrstuvwxyz";
+  const size_t max_index = (sizeof(charset) - 1);
+  std::generate_n(buffer, length, [&](){
+    return charset[ emulation_generator() % max_index ];
+  });
+}
+
+// Open a file for direct I/O, falling back to the page cache on file
+// systems (e.g. tmpfs) that do not support O_DIRECT
+static int OpenDirect(const std::string& file_path, const int& open_flags){
+
+  auto fd = open(file_path.c_str(), O_RDWR | O_DIRECT | open_flags);
+  if(fd == -1 && errno == EINVAL){
+    std::cout << "O_DIRECT not supported, using the page cache: " << file_path << "\n";
+    fd = open(file_path.c_str(), O_RDWR | open_flags);
+  }
+
+  if(fd == -1) {
+    std::cout << "Could not open file: " << file_path << "\n";
+    exit(EXIT_FAILURE);
+  }
+
+  return fd;
+}
+
+static char* AllocateAligned(const size_t& size, const size_t& alignment){
+  void* buffer = nullptr;
+  auto status = posix_memalign(&buffer, alignment, size);
+  if(status != 0){
+    std::cout << "Could not allocate aligned buffer: " << size << "\n";
+    exit(EXIT_FAILURE);
+  }
+  return static_cast<char*>(buffer);
+}
+
+// STDIO
+
+StdioBackend::StdioBackend(const std::string& file_path,
+                           const size_t& buffer_size,
+                           const int& open_flags)
+: file_path_(file_path),
+  write_buffer_(buffer_size, 0),
+  read_buffer_(buffer_size, 0){
+
+  FillRandom(&write_buffer_[0], buffer_size);
+
+  auto fd = open(file_path_.c_str(), O_RDWR | open_flags);
+  if(fd != -1){
+    file_pointer_ = fdopen(fd, "r+");
+  }
+  if(file_pointer_ == NULL) {
+    std::cout << "Could not open file: " << file_path_ << "\n";
+    exit(EXIT_FAILURE);
+  }
+
+}
+
+StdioBackend::~StdioBackend(){
+  fclose(file_pointer_);
+}
+
+void StdioBackend::Seek(const off64_t& offset){
+  auto status = fseek(file_pointer_, offset, SEEK_SET);
+  if(status != 0){
+    perror("seek");
+    exit(EXIT_FAILURE);
+  }
+}
+
+void StdioBackend::Read(const off64_t& offset, const size_t& byte_count){
+
+  Seek(offset);
+
+  auto read_size = fread(&read_buffer_[0], byte_count, 1, file_pointer_);
+  if(read_size != 1){
+    std::cout << "Reading error: " << file_path_;
+    std::cout << " "  << "read_size: " << read_size << "\n";
+    perror("read");
+    exit(EXIT_FAILURE);
+  }
+
+}
+
+void StdioBackend::Write(const off64_t& offset, const size_t& byte_count){
+
+  Seek(offset);
+
+  auto write_size = fwrite(write_buffer_.c_str(), byte_count, 1, file_pointer_);
+  if(write_size == 0){
+    std::cout << "Writing error: " << file_path_;
+    std::cout << " "  << "write_size: " << write_size << "\n";
+    perror("write");
+    exit(EXIT_FAILURE);
+  }
+
+}
+
+void StdioBackend::Sync(){
+
+  auto status = fflush(file_pointer_);
+  if(status != 0){
+    perror("fflush");
+    exit(EXIT_FAILURE);
+  }
+
+  status = fsync(fileno(file_pointer_));
+  if(status != 0){
+    perror("fsync");
+    exit(EXIT_FAILURE);
+  }
+
+}
+
+// DIRECT
+
+DirectBackend::DirectBackend(const std::string& file_path,
+                             const size_t& buffer_size,
+                             const bool& data_sync,
+                             const int& open_flags)
+: file_path_(file_path),
+  data_sync_(data_sync){
+
+  buffer_ = AllocateAligned(buffer_size, ALIGNMENT);
+  FillRandom(buffer_, buffer_size);
+
+  fd_ = OpenDirect(file_path_, open_flags);
+
+}
+
+DirectBackend::~DirectBackend(){
+  close(fd_);
+  free(buffer_);
+}
+
+void DirectBackend::Read(const off64_t& offset, const size_t& byte_count){
+
+  auto read_size = pread(fd_, buffer_, byte_count, offset);
+  if(read_size != (ssize_t) byte_count){
+    std::cout << "Reading error: " << file_path_;
+    std::cout << " "  << "read_size: " << read_size << "\n";
+    perror("pread");
+    exit(EXIT_FAILURE);
+  }
+
+}
+
+void DirectBackend::Write(const off64_t& offset, const size_t& byte_count){
+
+  auto write_size = pwrite(fd_, buffer_, byte_count, offset);
+  if(write_size != (ssize_t) byte_count){
+    std::cout << "Writing error: " << file_path_;
+    std::cout << " "  << "write_size: " << write_size << "\n";
+    perror("pwrite");
+    exit(EXIT_FAILURE);
+  }
+
+}
+
+void DirectBackend::Sync(){
+
+  auto status = (data_sync_ == true) ? fdatasync(fd_) : fsync(fd_);
+  if(status != 0){
+    perror("fsync");
+    exit(EXIT_FAILURE);
+  }
+
+}
+
+#ifdef HAVE_IO_URING
+
+// URING
+
+UringBackend::UringBackend(const std::string& file_path,
+                           const size_t& buffer_size,
+                           const size_t& queue_depth,
+                           const bool& data_sync,
+                           const int& open_flags)
+: file_path_(file_path),
+  queue_depth_(queue_depth),
+  data_sync_(data_sync),
+  buffer_size_(buffer_size){
+
+  fd_ = OpenDirect(file_path_, open_flags);
+
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring_fd_ = syscall(__NR_io_uring_setup, queue_depth_, &params);
+  if(ring_fd_ < 0){
+    perror("io_uring_setup");
+    exit(EXIT_FAILURE);
+  }
+
+  // The kernel rounds the depth up to a power of two
+  queue_depth_ = params.sq_entries;
+
+  // Map the submission ring, the submission entries, and the completion ring
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+
+  sq_ring_ = mmap(NULL, sq_ring_size_, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  cq_ring_ = mmap(NULL, cq_ring_size_, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+  void* sqes = mmap(NULL, sqes_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if(sq_ring_ == MAP_FAILED || cq_ring_ == MAP_FAILED || sqes == MAP_FAILED){
+    perror("mmap");
+    exit(EXIT_FAILURE);
+  }
+  sqes_ = static_cast<struct io_uring_sqe*>(sqes);
+
+  auto sq_ring = static_cast<char*>(sq_ring_);
+  sq_head_ = reinterpret_cast<unsigned*>(sq_ring + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(sq_ring + params.sq_off.tail);
+  sq_mask_ = reinterpret_cast<unsigned*>(sq_ring + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<unsigned*>(sq_ring + params.sq_off.array);
+
+  auto cq_ring = static_cast<char*>(cq_ring_);
+  cq_head_ = reinterpret_cast<unsigned*>(cq_ring + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(cq_ring + params.cq_off.tail);
+  cq_mask_ = reinterpret_cast<unsigned*>(cq_ring + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq_ring + params.cq_off.cqes);
+
+  write_buffer_ = AllocateAligned(buffer_size_, DirectBackend::ALIGNMENT);
+  FillRandom(write_buffer_, buffer_size_);
+  read_buffers_ = AllocateAligned(buffer_size_ * queue_depth_, DirectBackend::ALIGNMENT);
+  for(size_t buffer_itr = 0; buffer_itr < queue_depth_; buffer_itr++){
+    free_read_buffers_.push_back(buffer_itr);
+  }
+
+}
+
+UringBackend::~UringBackend(){
+  Drain(0);
+
+  munmap(sqes_, sqes_size_);
+  munmap(cq_ring_, cq_ring_size_);
+  munmap(sq_ring_, sq_ring_size_);
+  close(ring_fd_);
+  close(fd_);
+
+  free(read_buffers_);
+  free(write_buffer_);
+}
+
+void UringBackend::Submit(const uint8_t& opcode,
+                          const off64_t& offset,
+                          const size_t& byte_count,
+                          char* buffer,
+                          const bool& is_foreground,
+                          const size_t& read_buffer){
+
+  // Wait for a free slot
+  if(in_flight_count_ == queue_depth_){
+    Drain(queue_depth_ - 1);
+  }
+
+  auto tail = *sq_tail_;
+  auto index = tail & *sq_mask_;
+  auto sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = opcode;
+  sqe->fd = fd_;
+  sqe->off = offset;
+  sqe->addr = reinterpret_cast<uint64_t>(buffer);
+  sqe->len = byte_count;
+  if(opcode == IORING_OP_FSYNC && data_sync_ == true){
+    sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+  }
+
+  // Completions carry the expected result, the read buffer to free (plus
+  // one, zero for none), and whether a caller waits on them
+  uint64_t buffer_tag = (read_buffer == NO_READ_BUFFER) ? 0 : read_buffer + 1;
+  sqe->user_data = ((uint64_t) byte_count << 32) | (buffer_tag << 1) |
+      (is_foreground ? 1 : 0);
+
+  sq_array_[index] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+  pending_count_++;
+  in_flight_count_++;
+
+}
+
+void UringBackend::Enter(const unsigned& min_complete){
+
+  unsigned flags = (min_complete > 0) ? IORING_ENTER_GETEVENTS : 0;
+  auto status = syscall(__NR_io_uring_enter, ring_fd_, pending_count_,
+                        min_complete, flags, NULL, 0);
+  if(status < 0){
+    if(errno == EINTR){
+      return;
+    }
+    perror("io_uring_enter");
+    exit(EXIT_FAILURE);
+  }
+
+  pending_count_ -= std::min<unsigned>(status, pending_count_);
+
+}
+
+void UringBackend::Reap(){
+
+  auto head = *cq_head_;
+  auto tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+
+  for(; head != tail; head++){
+    auto cqe = &cqes_[head & *cq_mask_];
+    auto expected = cqe->user_data >> 32;
+    auto buffer_tag = (cqe->user_data & 0xffffffff) >> 1;
+
+    if(cqe->res < 0 || (size_t) cqe->res != expected){
+      std::cout << "io_uring error: " << file_path_ << " result: " << cqe->res << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    if((cqe->user_data & 1) == 1){
+      foreground_done_ = true;
+    }
+    if(buffer_tag != 0){
+      free_read_buffers_.push_back(buffer_tag - 1);
+    }
+    in_flight_count_--;
+  }
+
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+}
+
+void UringBackend::Drain(const size_t& in_flight_count){
+  Reap();
+  while(in_flight_count_ > in_flight_count){
+    Enter(1);
+    Reap();
+  }
+}
+
+size_t UringBackend::AcquireReadBuffer(){
+  Reap();
+  while(free_read_buffers_.empty() == true){
+    Enter(1);
+    Reap();
+  }
+
+  auto read_buffer = free_read_buffers_.back();
+  free_read_buffers_.pop_back();
+  return read_buffer;
+}
+
+void UringBackend::Read(const off64_t& offset, const size_t& byte_count){
+
+  auto read_buffer = AcquireReadBuffer();
+  Submit(IORING_OP_READ, offset, byte_count,
+         read_buffers_ + read_buffer * buffer_size_, true, read_buffer);
+
+  // Wait only for this read
+  foreground_done_ = false;
+  Reap();
+  while(foreground_done_ == false){
+    Enter(1);
+    Reap();
+  }
+
+}
+
+void UringBackend::Prefetch(const off64_t& offset, const size_t& byte_count){
+
+  auto read_buffer = AcquireReadBuffer();
+  Submit(IORING_OP_READ, offset, byte_count,
+         read_buffers_ + read_buffer * buffer_size_, false, read_buffer);
+  Enter(0);
+
+}
+
+void UringBackend::Write(const off64_t& offset, const size_t& byte_count){
+
+  Submit(IORING_OP_WRITE, offset, byte_count, write_buffer_, false);
+  Enter(0);
+
+}
+
+void UringBackend::Sync(){
+
+  // Sync does not order against writes that are still in flight
+  Drain(0);
+  Submit(IORING_OP_FSYNC, 0, 0, nullptr, false);
+  Drain(0);
+
+}
+
+#endif
+
+// MMAP
+
+// Busy wait, since sleeping is far coarser than media latencies
+static void SpinDelay(const double& duration_ns){
+  auto start = std::chrono::steady_clock::now();
+  auto duration = std::chrono::duration<double, std::nano>(duration_ns);
+  while(std::chrono::steady_clock::now() - start < duration){
+  }
+}
+
+// Strongest cache line write back the CPU supports
+static PersistType GetCacheLinePersistType(){
+#if defined(__x86_64__)
+  unsigned eax, ebx, ecx, edx;
+  if(__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) != 0){
+    if(ebx & (1 << 24)){
+      return PERSIST_TYPE_CLWB;
+    }
+    if(ebx & (1 << 23)){
+      return PERSIST_TYPE_CLFLUSHOPT;
+    }
+  }
+#endif
+  return PERSIST_TYPE_MSYNC;
+}
+
+MmapBackend::MmapBackend(const std::string& file_path,
+                         const size_t& buffer_size,
+                         const double& extra_latency,
+                         const int& open_flags)
+: file_path_(file_path),
+  extra_latency_(extra_latency),
+  write_buffer_(buffer_size, 0),
+  read_buffer_(buffer_size, 0){
+
+  FillRandom(&write_buffer_[0], buffer_size);
+
+  fd_ = open(file_path_.c_str(), O_RDWR | open_flags);
+  if(fd_ == -1) {
+    std::cout << "Could not open file: " << file_path_ << "\n";
+    exit(EXIT_FAILURE);
+  }
+
+  struct stat file_stat;
+  if(fstat(fd_, &file_stat) != 0){
+    perror("fstat");
+    exit(EXIT_FAILURE);
+  }
+  mapping_size_ = file_stat.st_size;
+  dirty_begin_ = mapping_size_;
+
+  // Stores to a DAX mapping are durable once their cache lines are written
+  // back, as are stores to tmpfs whose page cache is the medium
+  void* mapping = MAP_FAILED;
+  bool in_memory = false;
+#ifdef MAP_SYNC
+  mapping = mmap(NULL, mapping_size_, PROT_READ | PROT_WRITE,
+                 MAP_SHARED_VALIDATE | MAP_SYNC, fd_, 0);
+  in_memory = (mapping != MAP_FAILED);
+#endif
+  if(mapping == MAP_FAILED){
+    mapping = mmap(NULL, mapping_size_, PROT_READ | PROT_WRITE,
+                   MAP_SHARED, fd_, 0);
+  }
+  if(mapping == MAP_FAILED){
+    perror("mmap");
+    exit(EXIT_FAILURE);
+  }
+  mapping_ = static_cast<char*>(mapping);
+
+  struct statfs file_system_stat;
+  if(fstatfs(fd_, &file_system_stat) == 0 &&
+      file_system_stat.f_type == TMPFS_MAGIC){
+    in_memory = true;
+  }
+
+  persist_type_ = (in_memory == true) ? GetCacheLinePersistType() : PERSIST_TYPE_MSYNC;
+
+}
+
+MmapBackend::~MmapBackend(){
+  munmap(mapping_, mapping_size_);
+  close(fd_);
+}
+
+void MmapBackend::FlushCacheLines(const char* address, const size_t& byte_count){
+#if defined(__x86_64__)
+  auto line = reinterpret_cast<uintptr_t>(address) & ~(CACHE_LINE_SIZE - 1);
+  auto end = reinterpret_cast<uintptr_t>(address) + byte_count;
+
+  // Emitted as bytes so that no -mclwb or -mclflushopt is needed
+  for(; line < end; line += CACHE_LINE_SIZE){
+    auto cache_line = reinterpret_cast<volatile char*>(line);
+    if(persist_type_ == PERSIST_TYPE_CLWB){
+      asm volatile(".byte 0x66; xsaveopt %0" : "+m" (*cache_line));
+    }
+    else {
+      asm volatile(".byte 0x66; clflush %0" : "+m" (*cache_line));
+    }
+  }
+#else
+  (void) address;
+  (void) byte_count;
+#endif
+}
+
+void MmapBackend::Read(const off64_t& offset, const size_t& byte_count){
+
+  memcpy(&read_buffer_[0], mapping_ + offset, byte_count);
+
+  if(extra_latency_ > 0){
+    SpinDelay(extra_latency_);
+  }
+
+}
+
+void MmapBackend::Write(const off64_t& offset, const size_t& byte_count){
+
+  memcpy(mapping_ + offset, write_buffer_.c_str(), byte_count);
+
+  if(persist_type_ == PERSIST_TYPE_MSYNC){
+    dirty_begin_ = std::min<size_t>(dirty_begin_, offset);
+    dirty_end_ = std::max<size_t>(dirty_end_, offset + byte_count);
+  }
+  else {
+    FlushCacheLines(mapping_ + offset, byte_count);
+  }
+
+  if(extra_latency_ > 0){
+    SpinDelay(extra_latency_);
+  }
+
+}
+
+void MmapBackend::Sync(){
+
+  if(persist_type_ != PERSIST_TYPE_MSYNC){
+#if defined(__x86_64__)
+    asm volatile("sfence" ::: "memory");
+#endif
+    return;
+  }
+
+  if(dirty_begin_ >= dirty_end_){
+    return;
+  }
+
+  // msync needs a page aligned start
+  auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  auto begin = dirty_begin_ & ~(page_size - 1);
+  auto status = msync(mapping_ + begin, dirty_end_ - begin, MS_SYNC);
+  if(status != 0){
+    perror("msync");
+    exit(EXIT_FAILURE);
+  }
+
+  dirty_begin_ = mapping_size_;
+  dirty_end_ = 0;
+
+}
+
+// MEMORY
+
+// Bytes of the mapping holding the given address that sit on transparent
+// huge pages, from /proc/self/smaps
+static size_t GetAnonHugePageBytes(const void* address){
+
+  std::ifstream smaps("/proc/self/smaps");
+  std::string line;
+  auto target = reinterpret_cast<uintptr_t>(address);
+  bool in_mapping = false;
+  while(std::getline(smaps, line)){
+    uintptr_t begin = 0, end = 0;
+    if(sscanf(line.c_str(), "%lx-%lx ", &begin, &end) == 2){
+      in_mapping = (target >= begin && target < end);
+      continue;
+    }
+
+    size_t kilobytes = 0;
+    if(in_mapping == true &&
+        sscanf(line.c_str(), "AnonHugePages: %lu kB", &kilobytes) == 1){
+      return kilobytes * 1024;
+    }
+  }
+
+  return 0;
+}
+
+MemoryBackend::MemoryBackend(const size_t& memory_size,
+                             const size_t& buffer_size,
+                             const double& read_factor,
+                             const double& write_factor,
+                             const double& extra_latency)
+: read_factor_(read_factor),
+  write_factor_(write_factor),
+  extra_latency_(extra_latency),
+  write_buffer_(buffer_size, 0),
+  read_buffer_(buffer_size, 0){
+
+  FillRandom(&write_buffer_[0], buffer_size);
+
+  // Round up to whole huge pages
+  memory_size_ = (memory_size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+
+  // Reserved huge pages first, then transparent huge pages
+  void* memory = mmap(NULL, memory_size_, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  is_huge_page_backed_ = (memory != MAP_FAILED);
+  bool is_transparent = false;
+  if(memory == MAP_FAILED){
+    memory = mmap(NULL, memory_size_, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(memory != MAP_FAILED){
+      is_transparent = (madvise(memory, memory_size_, MADV_HUGEPAGE) == 0);
+    }
+  }
+  if(memory == MAP_FAILED){
+    perror("mmap");
+    exit(EXIT_FAILURE);
+  }
+  memory_ = static_cast<char*>(memory);
+
+  // Fault in the memory so that accesses do not pay for page faults
+  memset(memory_, 0, memory_size_);
+
+  // madvise only asks; THP may be disabled or out of contiguous memory
+  if(is_transparent == true){
+    is_huge_page_backed_ = (GetAnonHugePageBytes(memory_) > 0);
+  }
+
+  Calibrate();
+
+}
+
+MemoryBackend::~MemoryBackend(){
+  munmap(memory_, memory_size_);
+}
+
+void MemoryBackend::Calibrate(){
+
+  const size_t operation_count = 4096;
+  auto block_size = read_buffer_.size();
+  auto block_count = memory_size_ / block_size;
+  auto byte_count = static_cast<double>(operation_count * block_size);
+
+  auto start = std::chrono::steady_clock::now();
+  for(size_t operation_itr = 0; operation_itr < operation_count; operation_itr++){
+    auto offset = (emulation_generator() % block_count) * block_size;
+    memcpy(&read_buffer_[0], memory_ + offset, block_size);
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+  read_cost_ = std::chrono::duration<double, std::nano>(duration).count() / byte_count;
+
+  start = std::chrono::steady_clock::now();
+  for(size_t operation_itr = 0; operation_itr < operation_count; operation_itr++){
+    auto offset = (emulation_generator() % block_count) * block_size;
+    memcpy(memory_ + offset, write_buffer_.c_str(), block_size);
+  }
+  duration = std::chrono::steady_clock::now() - start;
+  write_cost_ = std::chrono::duration<double, std::nano>(duration).count() / byte_count;
+
+}
+
+void MemoryBackend::Read(const off64_t& offset, const size_t& byte_count){
+
+  memcpy(&read_buffer_[0], memory_ + offset, byte_count);
+
+  auto delay = (read_factor_ - 1) * read_cost_ * byte_count + extra_latency_;
+  if(delay > 0){
+    SpinDelay(delay);
+  }
+
+}
+
+void MemoryBackend::Write(const off64_t& offset, const size_t& byte_count){
+
+  memcpy(memory_ + offset, write_buffer_.c_str(), byte_count);
+
+  auto delay = (write_factor_ - 1) * write_cost_ * byte_count + extra_latency_;
+  if(delay > 0){
+    SpinDelay(delay);
+  }
+
+}
+
+// FACTORY
+
+EmulationBackendType EmulationBackendFactory::GetEmulationBackendType(const configuration& state,
+                                                                      const DeviceType& device_type){
+
+  // DRAM is always emulated in memory
+  if(device_type == DEVICE_TYPE_DRAM){
+    return EMULATION_BACKEND_TYPE_MEMORY;
+  }
+
+  if(device_type == DEVICE_TYPE_NVM &&
+      state.nvm_emulation_backend_type != EMULATION_BACKEND_TYPE_INVALID){
+    return state.nvm_emulation_backend_type;
+  }
+
+  return state.emulation_backend_type;
+}
+
+
+std::unique_ptr<EmulationBackend> EmulationBackendFactory::GetEmulationBackend(const configuration& state,
+                                                                               const DeviceType& device_type,
+                                                                               const EmulationTarget& target,
+                                                                               const size_t& buffer_size){
+
+  auto& file_path = target.file_path;
+  auto& open_flags = target.open_flags;
+
+  auto emulation_backend_type = GetEmulationBackendType(state, device_type);
+
+  switch(emulation_backend_type){
+    case EMULATION_BACKEND_TYPE_STDIO:
+      return std::unique_ptr<EmulationBackend>(new StdioBackend(file_path,
+                                                                buffer_size,
+                                                                open_flags));
+
+    case EMULATION_BACKEND_TYPE_DIRECT:
+      return std::unique_ptr<EmulationBackend>(new DirectBackend(file_path,
+                                                                 buffer_size,
+                                                                 state.data_sync,
+                                                                 open_flags));
+
+    case EMULATION_BACKEND_TYPE_URING: {
+#ifdef HAVE_IO_URING
+      return std::unique_ptr<EmulationBackend>(new UringBackend(file_path,
+                                                                buffer_size,
+                                                                state.io_queue_depth,
+                                                                state.data_sync,
+                                                                open_flags));
+#else
+      std::cout << "io_uring is not available in this build\n";
+      exit(EXIT_FAILURE);
+#endif
+    }
+
+    case EMULATION_BACKEND_TYPE_MMAP: {
+      // Slower media is only injected on the NVM tier
+      auto extra_latency = (device_type == DEVICE_TYPE_NVM) ? state.nvm_extra_latency : 0;
+      auto backend = new MmapBackend(file_path, buffer_size, extra_latency, open_flags);
+      std::cout << "Persisting " << file_path << " with "
+          << PersistTypeToString(backend->GetPersistType()) << "\n";
+      return std::unique_ptr<EmulationBackend>(backend);
+    }
+
+    case EMULATION_BACKEND_TYPE_MEMORY: {
+      // NVM runs slower by its latency type, DRAM at full speed
+      double read_factor = 1, write_factor = 1, extra_latency = 0;
+      if(device_type == DEVICE_TYPE_NVM){
+        read_factor = state.nvm_read_latency;
+        write_factor = state.nvm_write_latency;
+        extra_latency = state.nvm_extra_latency;
+      }
+
+      auto backend = new MemoryBackend(target.file_size,
+                                       buffer_size,
+                                       read_factor,
+                                       write_factor,
+                                       extra_latency);
+      std::cout << "Emulating " << DeviceTypeToString(device_type) << " in "
+          << (backend->IsHugePageBacked() ? "huge page" : "anonymous") << " memory "
+          << "READ: " << backend->GetReadCost() << " ns/B "
+          << "WRITE: " << backend->GetWriteCost() << " ns/B\n";
+      return std::unique_ptr<EmulationBackend>(backend);
+    }
+
+    default: {
+      std::cout << "Invalid emulation backend type: " << emulation_backend_type << "\n";
+      exit(EXIT_FAILURE);
+    }
+  }
+
+}
+
+}  // End machine namespace
@@ -0,0 +1,83 @@
+// GROUP COMMIT SOURCE
+
+#include <algorithm>
+
+#include "group_commit.h"
+
+namespace machine {
+
+GroupCommit::GroupCommit(const size_t& batch_size, const double& window)
+: batch_size_(batch_size),
+  window_(window){
+}
+
+bool GroupCommit::Add(const double& now){
+
+  if(pending_count_ == 0){
+    first_pending_time_ = now;
+  }
+  pending_count_++;
+  pending_time_sum_ += now;
+
+  if(pending_count_ >= batch_size_){
+    return true;
+  }
+
+  return IsDue(now);
+}
+
+bool GroupCommit::IsDue(const double& now) const{
+  return (pending_count_ > 0 && window_ > 0 &&
+      now - first_pending_time_ >= window_);
+}
+
+double GroupCommit::Commit(const double& sync_latency, const double& now){
+
+  if(pending_count_ == 0){
+    return 0;
+  }
+
+  auto latency_share = sync_latency / pending_count_;
+
+  batch_count_++;
+  committed_count_ += pending_count_;
+  sync_latency_ += sync_latency;
+  commit_wait_ += pending_count_ * now - pending_time_sum_;
+
+  pending_count_ = 0;
+  pending_time_sum_ = 0;
+
+  return latency_share;
+}
+
+double GroupCommit::GetSyncLatencyPerBlock() const{
+  return sync_latency_ / std::max<size_t>(committed_count_, 1);
+}
+
+void GroupCommit::ResetStats(){
+  // Stats are reset along with the clock, so pending blocks restart at 0
+  first_pending_time_ = 0;
+  pending_time_sum_ = 0;
+
+  batch_count_ = 0;
+  committed_count_ = 0;
+  sync_latency_ = 0;
+  commit_wait_ = 0;
+}
+
+std::ostream& operator<< (std::ostream& os, const GroupCommit& group_commit){
+
+  size_t batch_count = std::max<size_t>(group_commit.batch_count_, 1);
+  size_t committed_count = std::max<size_t>(group_commit.committed_count_, 1);
+
+  os << "BATCHES: " << group_commit.batch_count_ << " "
+      << "BLOCKS/BATCH: " << (double) group_commit.committed_count_ / batch_count << " "
+      << "SYNC: " << group_commit.sync_latency_ / batch_count / 1000 << " us "
+      << "SYNC/BLOCK: " << group_commit.GetSyncLatencyPerBlock() / 1000 << " us "
+      << "WAIT: " << group_commit.commit_wait_ / committed_count / 1000 << " us "
+      << "PENDING: " << group_commit.pending_count_ << "\n";
+
+  return os;
+}
+
+}  // End machine namespace
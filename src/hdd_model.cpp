@@ -0,0 +1,164 @@
+// HDD MODEL SOURCE
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+#include "hdd_model.h"
+
+namespace machine {
+
+HDDModel::HDDModel(const size_t& page_count,
+                   const size_t& pages_per_track,
+                   const double& rotation_latency,
+                   const double& track_seek_latency,
+                   const double& full_seek_latency,
+                   const size_t& queue_depth)
+: page_count_(page_count),
+  pages_per_track_(pages_per_track),
+  cylinder_count_(std::max<size_t>((page_count + pages_per_track - 1)/pages_per_track, 2)),
+  rotation_latency_(rotation_latency),
+  track_seek_latency_(track_seek_latency),
+  full_seek_latency_(full_seek_latency),
+  queue_depth_(queue_depth){
+}
+
+double HDDModel::GetSeekLatency(const size_t& distance) const{
+
+  if(distance == 0){
+    return 0;
+  }
+
+  // Short seeks are dominated by acceleration, hence the square root
+  auto max_distance = std::max<size_t>(cylinder_count_ - 1, 2);
+  double fraction = (double) (distance - 1) / (max_distance - 1);
+  return track_seek_latency_ +
+      (full_seek_latency_ - track_seek_latency_) * std::sqrt(fraction);
+}
+
+double HDDModel::Access(const size_t& page,
+                        const size_t& page_count,
+                        const double& timestamp){
+
+  // The platter kept turning while the disk sat idle
+  clock_ = std::max(clock_, timestamp);
+
+  auto cylinder = page / pages_per_track_;
+  auto distance = (cylinder > head_cylinder_) ? (cylinder - head_cylinder_) :
+      (head_cylinder_ - cylinder);
+
+  // Seek
+  auto seek_latency = GetSeekLatency(distance);
+  clock_ += seek_latency;
+  if(cylinder != head_cylinder_){
+    is_moving_up_ = (cylinder > head_cylinder_);
+  }
+
+  // Wait for the page to rotate under the head
+  double page_latency = rotation_latency_ / pages_per_track_;
+  double head_sector = std::fmod(clock_, rotation_latency_) / page_latency;
+  double wait_sectors = (double) (page % pages_per_track_) - head_sector;
+  if(wait_sectors < -1e-6){
+    wait_sectors += pages_per_track_;
+  }
+  auto rotation_wait = std::max(wait_sectors, 0.0) * page_latency;
+
+  // Transfer
+  auto transfer_latency = page_count * page_latency;
+
+  auto latency = seek_latency + rotation_wait + transfer_latency;
+  clock_ += rotation_wait + transfer_latency;
+  head_cylinder_ = ((page + page_count - 1) / pages_per_track_) % cylinder_count_;
+
+  access_count_++;
+  seek_distance_ += distance;
+  seek_latency_ += seek_latency;
+  rotation_wait_ += rotation_wait;
+
+  return latency;
+}
+
+bool HDDModel::QueueWrite(const size_t& page, const size_t& page_count){
+
+  QueuedWrite request;
+  request.page = page;
+  request.page_count = page_count;
+  request.slot = queue_.size();
+  queue_.push_back(request);
+  batched_write_count_++;
+
+  return (queue_.size() >= queue_depth_);
+}
+
+std::vector<double> HDDModel::Drain(const double& timestamp){
+
+  std::vector<double> service_times(queue_.size(), 0);
+  if(queue_.empty() == true){
+    return service_times;
+  }
+
+  batch_count_++;
+  std::sort(queue_.begin(), queue_.end(),
+            [](const QueuedWrite& lhs, const QueuedWrite& rhs){
+              return lhs.page < rhs.page;
+            });
+
+  // Split the queue at the head position
+  auto head_page = head_cylinder_ * pages_per_track_;
+  auto split = std::lower_bound(queue_.begin(), queue_.end(), head_page,
+                                [](const QueuedWrite& request, const size_t& page){
+                                  return request.page < page;
+                                });
+
+  // Sweep in the current direction first, then reverse
+  std::vector<QueuedWrite> schedule;
+  if(is_moving_up_ == true){
+    schedule.insert(schedule.end(), split, queue_.end());
+    schedule.insert(schedule.end(), std::make_reverse_iterator(split),
+                    queue_.rend());
+  }
+  else {
+    schedule.insert(schedule.end(), std::make_reverse_iterator(split),
+                    queue_.rend());
+    schedule.insert(schedule.end(), split, queue_.end());
+  }
+  queue_.clear();
+
+  // Each writeback waits only for its own service, not the whole pass
+  for(auto& request : schedule){
+    service_times[request.slot] = Access(request.page,
+                                         request.page_count,
+                                         timestamp);
+  }
+
+  return service_times;
+}
+
+void HDDModel::ResetStats(){
+  access_count_ = 0;
+  seek_distance_ = 0;
+  batch_count_ = 0;
+  batched_write_count_ = 0;
+  seek_latency_ = 0;
+  rotation_wait_ = 0;
+}
+
+std::ostream& operator<< (std::ostream& os, const HDDModel& hdd_model){
+
+  size_t access_count = std::max<size_t>(hdd_model.access_count_, 1);
+
+  os << "HDD: \n";
+  os << std::setw(10) << "HEAD" << " :: "
+      << "ACCESSES: " << hdd_model.access_count_ << " "
+      << "MEAN SEEK: " << hdd_model.seek_distance_ / access_count << " cylinders "
+      << hdd_model.seek_latency_ / access_count / 1000 << " us "
+      << "MEAN ROTATION: " << hdd_model.rotation_wait_ / access_count / 1000 << " us\n";
+  os << std::setw(10) << "SCAN" << " :: "
+      << "BATCHES: " << hdd_model.batch_count_ << " "
+      << "WRITEBACKS: " << hdd_model.batched_write_count_ << " "
+      << "PENDING: " << hdd_model.queue_.size() << "\n";
+
+  return os;
+}
+
+}  // End machine namespace
@@ -11,12 +11,17 @@
 #include "policy_lfu.h"
 #include "policy_lru.h"
 #include "policy_arc.h"
+#include "policy_clock.h"
+#include "policy_clock_pro.h"
+#include "policy_two_q.h"
+#include "policy_lirs.h"
+#include "policy_w_tiny_lfu.h"
 
 namespace machine {
 
-extern int super_block_factor;
+extern size_t super_block_factor;
 
-void PrintCapacity(const size_t block_count);
+void PrintCapacity(const size_t block_count, const size_t block_size);
 
 // Base class for all caching algorithms
 template <typename Key, typename Value, typename Policy>
@@ -29,20 +34,18 @@ class Cache {
 
   Value Get(const Key& key) const;
 
+  void Erase(const Key& key);
+
   size_t GetSize() const;
 
   void Print() const;
 
-  bool IsSequential(const size_t& next);
-
  private:
 
   mutable Policy cache_policy_;
 
   size_t capacity_;
 
-  size_t current_block_;
-
 };
 
 }  // End machine namespace
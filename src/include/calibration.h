@@ -0,0 +1,52 @@
+// CALIBRATION HEADER
+
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "types.h"
+
+namespace machine {
+
+class configuration;
+
+// Measured page latencies of a device (ns)
+struct LatencyProfile {
+
+  double seq_read_latency = 0;
+
+  double seq_write_latency = 0;
+
+  double rnd_read_latency = 0;
+
+  double rnd_write_latency = 0;
+
+  // Streaming bandwidth of large transfers (bytes/ns, i.e. GB/s; 0 if not
+  // measured)
+  double read_bandwidth = 0;
+
+  double write_bandwidth = 0;
+
+};
+
+// Run sequential and random read/write and bandwidth microbenchmarks on a
+// scratch file created in the given directory (and removed afterwards),
+// through the emulation backend of the device
+LatencyProfile CalibrateDevice(const configuration& state,
+                               const DeviceType& device_type,
+                               const std::string& directory,
+                               const size_t& file_size,
+                               const size_t& random_operation_count);
+
+// Calibrate every device with a path and write the latency profile file
+void RunCalibration(const configuration& state);
+
+// Profile file format: one line per device (# starts a comment)
+// DEVICE SEQ_READ SEQ_WRITE RND_READ RND_WRITE [READ_BW WRITE_BW]
+void WriteLatencyProfile(const std::string& profile_file,
+                         const std::map<DeviceType, LatencyProfile>& profiles);
+
+std::map<DeviceType, LatencyProfile> ReadLatencyProfile(const std::string& profile_file);
+
+}  // End machine namespace
@@ -5,11 +5,13 @@
 #include <getopt.h>
 #include <sys/time.h>
 #include <iostream>
+#include <map>
 #include <string>
 #include <vector>
 
 #include "types.h"
 #include "device.h"
+#include "emulation_backend.h"
 
 namespace machine {
 
@@ -36,12 +38,41 @@ class configuration {
   // caching type
   CachingType caching_type;
 
+  // halve lfu frequencies every (factor * capacity) accesses (0: never)
+  size_t lfu_aging_factor;
+
+  // cap on clock usage counts
+  size_t clock_max_usage;
+
+  // 2q queue sizes as fractions of the capacity
+  double two_q_in_ratio;
+
+  double two_q_out_ratio;
+
+  // share of the lirs capacity holding resident hir blocks
+  double lirs_hir_ratio;
+
+  // share of the w-tinylfu capacity used by the admission window
+  double w_tiny_lfu_window_ratio;
+
   // file name
   std::string file_name;
 
   // summary file
   std::string summary_file;
 
+  // latency percentile file
+  std::string latency_file;
+
+  // latency profile (written by calibration, loaded otherwise)
+  std::string latency_profile;
+
+  // latency profile suggested by comparing the model with emulation
+  std::string validation_profile;
+
+  // directories holding the calibration scratch file of each device
+  std::map<DeviceType, std::string> calibration_paths;
+
   // migration frequency
   size_t migration_frequency;
 
@@ -60,6 +91,111 @@ class configuration {
   // Large file mode
   bool large_file_mode;
 
+  // backing file, size, and open flags of each emulated device
+  std::map<DeviceType, EmulationTarget> emulation_targets;
+
+  // write every emulation file once so that later writes do not allocate
+  bool prefault_emulation_files;
+
+  // keep emulation files of the right size from an earlier run
+  bool reuse_emulation_files;
+
+  // flushed blocks synced together (group commit)
+  size_t group_commit_size;
+
+  // longest a flushed block waits for its group commit (us, 0 = no limit)
+  double group_commit_window;
+
+  // how emulated devices perform I/O
+  EmulationBackendType emulation_backend_type;
+
+  // sync emulated writes with fdatasync instead of fsync
+  bool data_sync;
+
+  // emulated requests in flight per device (io_uring backend)
+  size_t io_queue_depth;
+
+  // threads performing emulated I/O (0 = on the simulation thread)
+  size_t io_worker_count;
+
+  // backend of the emulated nvm tier (default: same as the other tiers)
+  EmulationBackendType nvm_emulation_backend_type;
+
+  // extra ns per emulated nvm access (mmap backend)
+  double nvm_extra_latency;
+
+  // block size of each device (in bytes)
+  std::map<DeviceType, size_t> block_sizes;
+
+  // super block factor
+  size_t super_block_factor;
+
+  // number of NUMA nodes
+  size_t numa_node_count;
+
+  // NUMA placement type
+  NumaPlacementType numa_placement_type;
+
+  // NUMA remote access latency multiplier
+  double numa_remote_latency;
+
+  // NUMA node of each client
+  std::vector<size_t> numa_affinity;
+
+  // Optimize
+  bool optimize;
+
+  // price of each device ($/GB)
+  std::map<DeviceType, double> tier_prices;
+
+  // throughput SLO (ops/s)
+  double slo_throughput;
+
+  // latency SLO (ns/op) at slo_percentile
+  double slo_latency;
+
+  // percentile of the op latencies the latency SLO bounds (0-100]
+  double slo_percentile;
+
+  // number of parallel optimizer jobs
+  size_t optimizer_jobs;
+
+  // latency model type
+  LatencyModelType latency_model_type;
+
+  // latency distribution spread (log-normal sigma)
+  double latency_sigma;
+
+  // blocks prefetched along a detected stream (0 disables prefetching)
+  size_t prefetch_depth;
+
+  // model SSD flash translation and garbage collection
+  bool ssd_model;
+
+  // SSD logical capacity (GB)
+  size_t ssd_capacity;
+
+  // SSD spare capacity (fraction of logical capacity)
+  double ssd_over_provisioning;
+
+  // SSD garbage collection victim policy
+  GcPolicyType gc_policy_type;
+
+  // model HDD head movement and elevator scheduling of writebacks
+  bool hdd_model;
+
+  // HDD writebacks queued before a SCAN pass
+  size_t hdd_queue_depth;
+
+  // model NVM write buffering, write bandwidth, and wear
+  bool nvm_model;
+
+  // NVM media write bandwidth (GB/s)
+  double nvm_write_bandwidth;
+
+  // swap the most and least worn NVM regions
+  bool nvm_wear_leveling;
+
   // DERIVED BASED ON HIERARCHY TYPE
 
   // list of devices in hierarchy
@@ -87,4 +223,6 @@ void ParseArguments(int argc, char *argv[], configuration &state);
 
 void ConstructDeviceList(configuration &state);
 
+size_t GetClientNode(const configuration &state, const size_t& client);
+
 }  // namespace machine
@@ -4,15 +4,28 @@
 
 #include <iostream>
 #include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "storage_cache.h"
+#include "stream_detector.h"
 #include "timer.h"
 
 namespace machine {
 
 extern size_t scale_factor;
 
-#define BLOCK_SIZE 1024
+// size of a trace block (in bytes)
+#define DEFAULT_BLOCK_SIZE 4096
+
+const size_t INVALID_NODE = SIZE_MAX;
+
+// NUMA node of the client issuing the current operation
+extern size_t current_numa_node;
+
+// Client issuing the current operation
+extern size_t current_client;
 
 class configuration;
 
@@ -22,51 +35,165 @@ struct Device {
   Device(const DeviceType& device_type,
          const CachingType& caching_type,
          const size_t& device_size,
+         const size_t& block_size,
+         const size_t& node_count,
+         const NumaPlacementType& numa_placement_type,
          const double& clean_fraction)
   : device_type(device_type),
     device_size(device_size),
-    cache(device_type,
-          caching_type,
-          device_size / super_block_factor,
-          clean_fraction){
-    // Nothing to do here!
+    block_size(block_size),
+    block_factor(block_size / DEFAULT_BLOCK_SIZE),
+    node_count(node_count),
+    numa_placement_type(numa_placement_type){
+
+    // Capacity is split evenly across NUMA nodes
+    auto capacity = device_size / (super_block_factor * block_factor);
+    auto node_capacity = std::max<size_t>(capacity / node_count, 1);
+    for(size_t node_itr = 0; node_itr < node_count; node_itr++){
+      caches.push_back(StorageCache(device_type,
+                                    caching_type,
+                                    node_capacity,
+                                    block_size,
+                                    clean_fraction));
+    }
+
+    if(node_count > 1){
+      node_map = std::make_shared<std::unordered_map<size_t, size_t>>();
+    }
+
+    stream_detector = std::make_shared<StreamDetector>();
 
     std::cout << "Initialize Device: " << DeviceTypeToString(device_type)
         << " Capacity: ";
-    PrintCapacity(device_size / super_block_factor);
+    PrintCapacity(GetCapacity(), block_size);
+    std::cout << "Block Size: " << block_size << " B";
+    if(node_count > 1){
+      std::cout << " Nodes: " << node_count;
+    }
     std::cout << "\n";
 
   }
 
+  // put a device block (new blocks are placed based on the NUMA policy)
+  Block Put(const size_t& device_block_id, const size_t& block_status);
+
+  // get the status of a device block
+  int Get(const size_t& device_block_id);
+
+  // remove a device block
+  void Erase(const size_t& device_block_id);
+
+  // NUMA node holding a device block (INVALID_NODE if absent)
+  size_t Locate(const size_t& device_block_id) const;
+
+  // NUMA node where a new device block is placed
+  size_t GetPlacementNode(const size_t& device_block_id) const;
+
+  size_t GetSize() const;
+
+  size_t GetCapacity() const;
+
+  // classify an access to a device block (sequential, strided, or random)
+  PatternType GetPattern(const size_t& device_block_id);
+
+  // device block that holds the given trace block
+  size_t GetBlockId(const size_t& block_id) const {
+    return block_id / block_factor;
+  }
+
+  // first trace block held by the given device block
+  size_t GetFirstBlockId(const size_t& device_block_id) const {
+    return device_block_id * block_factor;
+  }
+
   // type of the device
   DeviceType device_type = DEVICE_TYPE_INVALID;
 
   // size of the device (in pages)
   size_t device_size = 0;
 
-  // storage cache
-  StorageCache cache;
+  // size of a device block (in bytes)
+  size_t block_size = DEFAULT_BLOCK_SIZE;
+
+  // trace blocks per device block
+  size_t block_factor = 1;
+
+  // number of NUMA nodes
+  size_t node_count = 1;
+
+  // NUMA placement policy
+  NumaPlacementType numa_placement_type = NUMA_PLACEMENT_TYPE_FIRST_TOUCH;
+
+  // storage caches (one per NUMA node)
+  std::vector<StorageCache> caches;
+
+  // NUMA node of each cached device block (only with multiple nodes)
+  std::shared_ptr<std::unordered_map<size_t, size_t>> node_map;
+
+  // access pattern detector
+  std::shared_ptr<StreamDetector> stream_detector;
 
 };
 
 // Physical Timer
 extern Timer<std::ratio<1, 1000 * 1000 * 1000>> physical_timer;
 
-size_t GetWriteLatency(std::vector<Device>& devices,
+double GetWriteLatency(std::vector<Device>& devices,
                        DeviceType device_type,
                        const size_t& block_id,
-                       const bool& flush_block);
+                       const bool& flush_block,
+                       const size_t& byte_count);
 
-size_t GetReadLatency(std::vector<Device>& devices,
+double GetReadLatency(std::vector<Device>& devices,
                       DeviceType device_type,
-                      const size_t& block_id);
+                      const size_t& block_id,
+                      const size_t& byte_count);
+
+// Count a hit on a resident NUMA block as local or remote
+void CountNumaHit(std::vector<Device>& devices,
+                  const DeviceType& device_type,
+                  const size_t& block_id);
 
 void BootstrapDeviceMetrics(const configuration &state);
 
 void BootstrapFileSystemForEmulation(const configuration &state);
 
+// Print and reset the internal device models (SSD, HDD, NVM)
+void PrintDeviceModels();
+
+void ResetDeviceModelStats();
+
+// Sync blocks still waiting for a group commit
+void FlushGroupCommits();
+
+// The running trace op finished with the given latency; its flushed blocks
+// still waiting for a group commit charge it their share of the sync, and
+// its writebacks still in the HDD queue their service time
+void WaitOnPendingWrites(const OperationType& operation_type,
+                         const DeviceType& device_type,
+                         const double& latency);
+
+// Wait for the I/O queued on emulation workers
+void DrainIOWorkers();
+
+// Write the latency table corrected by emulation as a latency profile
+void WriteValidationProfile(const std::string& profile_file);
+
+// Print the projected NVM lifetime at the wear rate seen over the duration
+void PrintDeviceLifetime(const double& duration_ns);
+
+// Logical time of the running workload (ns)
+extern double logical_ns;
+
 extern bool emulate;
 
+// Tiers a running prefetch reads from and installs into (invalid
+// otherwise); their accesses stream along the detected pattern and do not
+// train the stream detectors
+extern DeviceType prefetch_source;
+
+extern DeviceType prefetch_destination;
+
 void Copy(std::vector<Device>& devices,
           DeviceType destination,
           DeviceType source,
@@ -75,15 +202,53 @@ void Copy(std::vector<Device>& devices,
           const bool& flush_block,
           double& total_duration);
 
-DeviceType LocateInDevices(std::vector<Device> devices,
+// As above, but the writeback of evicted blocks is charged to
+// victim_duration
+void Copy(std::vector<Device>& devices,
+          DeviceType destination,
+          DeviceType source,
+          const size_t& block_id,
+          const size_t& block_status,
+          const bool& flush_block,
+          double& total_duration,
+          double& victim_duration);
+
+void CopyBlocks(std::vector<Device>& devices,
+                DeviceType destination,
+                DeviceType source,
+                const size_t& block_id,
+                const size_t& block_count,
+                const size_t& block_status,
+                const bool& flush_block,
+                double& total_duration);
+
+void CopyBlocks(std::vector<Device>& devices,
+                DeviceType destination,
+                DeviceType source,
+                const size_t& block_id,
+                const size_t& block_count,
+                const size_t& block_status,
+                const bool& flush_block,
+                double& total_duration,
+                double& victim_duration);
+
+DeviceType LocateInDevices(std::vector<Device>& devices,
                            const size_t& block_id);
 
+void MigrateToLocalNode(std::vector<Device>& devices,
+                        DeviceType device_type,
+                        const size_t& block_id,
+                        double& total_duration);
+
 bool DeviceExists(std::vector<Device>& devices,
                   const DeviceType& device_type);
 
 size_t GetDeviceOffset(std::vector<Device>& devices,
                        const DeviceType& device_type);
 
+size_t GetBlockSize(std::vector<Device>& devices,
+                    const DeviceType& device_type);
+
 class DeviceFactory {
  public:
   DeviceFactory();
@@ -93,6 +258,11 @@ class DeviceFactory {
                           const configuration& state,
                           const DeviceType& last_device_type);
 
+  // size of the device (in pages)
+  static size_t GetDeviceSize(const DeviceType& device_type,
+                              const configuration& state,
+                              const DeviceType& last_device_type);
+
 };
 
 }  // End machine namespace
@@ -0,0 +1,391 @@
+// EMULATION BACKEND HEADER
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef HAVE_IO_URING
+#include <linux/io_uring.h>
+#endif
+
+#include "types.h"
+
+namespace machine {
+
+class configuration;
+
+// Backing file of an emulated device
+struct EmulationTarget {
+
+  std::string file_path;
+
+  // bytes
+  off64_t file_size = 0;
+
+  // extra flags for open (e.g. O_DSYNC)
+  int open_flags = 0;
+
+};
+
+// Performs the I/O of an emulated device on a backing file
+class EmulationBackend {
+ public:
+
+  virtual ~EmulationBackend() {}
+
+  virtual void Read(const off64_t& offset, const size_t& byte_count) = 0;
+
+  // Read ahead without waiting for the data (synchronous by default)
+  virtual void Prefetch(const off64_t& offset, const size_t& byte_count){
+    Read(offset, byte_count);
+  }
+
+  // Writes may complete after returning, but before the next Sync
+  virtual void Write(const off64_t& offset, const size_t& byte_count) = 0;
+
+  // Make written data durable
+  virtual void Sync() = 0;
+
+  // Whether writes and prefetches return before their I/O is done
+  virtual bool IsAsynchronous() const {
+    return false;
+  }
+
+};
+
+// Buffered I/O through stdio
+class StdioBackend : public EmulationBackend {
+ public:
+
+  StdioBackend(const std::string& file_path,
+               const size_t& buffer_size,
+               const int& open_flags = 0);
+
+  ~StdioBackend();
+
+  void Read(const off64_t& offset, const size_t& byte_count);
+
+  void Write(const off64_t& offset, const size_t& byte_count);
+
+  void Sync();
+
+ private:
+
+  void Seek(const off64_t& offset);
+
+  std::string file_path_;
+
+  FILE* file_pointer_ = NULL;
+
+  std::string write_buffer_;
+
+  std::string read_buffer_;
+
+};
+
+// Positioned I/O on a raw descriptor, bypassing the page cache with O_DIRECT
+class DirectBackend : public EmulationBackend {
+ public:
+
+  DirectBackend(const std::string& file_path,
+                const size_t& buffer_size,
+                const bool& data_sync,
+                const int& open_flags = 0);
+
+  ~DirectBackend();
+
+  void Read(const off64_t& offset, const size_t& byte_count);
+
+  void Write(const off64_t& offset, const size_t& byte_count);
+
+  void Sync();
+
+  // O_DIRECT requires offsets, sizes, and buffers aligned to this
+  static const size_t ALIGNMENT = 4096;
+
+ private:
+
+  std::string file_path_;
+
+  int fd_ = -1;
+
+  // sync data only (fdatasync) instead of data and metadata (fsync)
+  bool data_sync_;
+
+  char* buffer_ = nullptr;
+
+};
+
+#ifdef HAVE_IO_URING
+
+// Asynchronous I/O through an io_uring submission queue
+//
+// Writes and prefetches are submitted without waiting and overlap with
+// foreground reads, which wait only for their own completion. Completions
+// are reaped in batches straight from the shared completion ring, so the
+// ring is only entered to submit or when a read, sync, or full queue has
+// to wait.
+class UringBackend : public EmulationBackend {
+ public:
+
+  UringBackend(const std::string& file_path,
+               const size_t& buffer_size,
+               const size_t& queue_depth,
+               const bool& data_sync,
+               const int& open_flags = 0);
+
+  ~UringBackend();
+
+  void Read(const off64_t& offset, const size_t& byte_count);
+
+  void Prefetch(const off64_t& offset, const size_t& byte_count);
+
+  void Write(const off64_t& offset, const size_t& byte_count);
+
+  void Sync();
+
+  bool IsAsynchronous() const {
+    return true;
+  }
+
+  size_t GetInFlightCount() const {
+    return in_flight_count_;
+  }
+
+  size_t GetFreeReadBufferCount() const {
+    return free_read_buffers_.size();
+  }
+
+ private:
+
+  // Queue a request, waiting for a free slot if the queue is full; reads
+  // name the read buffer they fill, which is free again once reaped
+  void Submit(const uint8_t& opcode,
+              const off64_t& offset,
+              const size_t& byte_count,
+              char* buffer,
+              const bool& is_foreground,
+              const size_t& read_buffer = NO_READ_BUFFER);
+
+  // Take a read buffer no read is in flight into, waiting for one if needed
+  size_t AcquireReadBuffer();
+
+  // Submit queued requests and wait for at least min_complete completions
+  void Enter(const unsigned& min_complete);
+
+  // Consume all available completions
+  void Reap();
+
+  // Wait until at most the given number of requests are in flight
+  void Drain(const size_t& in_flight_count);
+
+  std::string file_path_;
+
+  int fd_ = -1;
+
+  int ring_fd_ = -1;
+
+  size_t queue_depth_;
+
+  bool data_sync_;
+
+  // SUBMISSION RING
+
+  void* sq_ring_ = nullptr;
+
+  size_t sq_ring_size_ = 0;
+
+  unsigned* sq_head_ = nullptr;
+
+  unsigned* sq_tail_ = nullptr;
+
+  unsigned* sq_mask_ = nullptr;
+
+  unsigned* sq_array_ = nullptr;
+
+  struct io_uring_sqe* sqes_ = nullptr;
+
+  size_t sqes_size_ = 0;
+
+  // COMPLETION RING
+
+  void* cq_ring_ = nullptr;
+
+  size_t cq_ring_size_ = 0;
+
+  unsigned* cq_head_ = nullptr;
+
+  unsigned* cq_tail_ = nullptr;
+
+  unsigned* cq_mask_ = nullptr;
+
+  struct io_uring_cqe* cqes_ = nullptr;
+
+  // queued but not yet submitted
+  unsigned pending_count_ = 0;
+
+  size_t in_flight_count_ = 0;
+
+  bool foreground_done_ = false;
+
+  // BUFFERS
+
+  size_t buffer_size_;
+
+  char* write_buffer_ = nullptr;
+
+  // one read buffer per queue slot
+  char* read_buffers_ = nullptr;
+
+  // read buffers without a read in flight
+  std::vector<size_t> free_read_buffers_;
+
+  static const size_t NO_READ_BUFFER = ~((size_t) 0);
+
+};
+
+#endif
+
+// Loads and stores on a shared mapping of the file, as a database would use
+// persistent memory
+//
+// On DAX or memory-backed files (tmpfs) stores are persisted by flushing
+// their cache lines (clwb, else clflushopt) and fencing on Sync. Otherwise
+// the written range is persisted with msync. An optional extra latency is
+// spun on every access to approximate media slower than DRAM.
+class MmapBackend : public EmulationBackend {
+ public:
+
+  MmapBackend(const std::string& file_path,
+              const size_t& buffer_size,
+              const double& extra_latency,
+              const int& open_flags = 0);
+
+  ~MmapBackend();
+
+  void Read(const off64_t& offset, const size_t& byte_count);
+
+  void Write(const off64_t& offset, const size_t& byte_count);
+
+  void Sync();
+
+  PersistType GetPersistType() const {
+    return persist_type_;
+  }
+
+  static const size_t CACHE_LINE_SIZE = 64;
+
+ private:
+
+  // Write back the cache lines covering a range
+  void FlushCacheLines(const char* address, const size_t& byte_count);
+
+  std::string file_path_;
+
+  int fd_ = -1;
+
+  char* mapping_ = nullptr;
+
+  size_t mapping_size_ = 0;
+
+  PersistType persist_type_ = PERSIST_TYPE_INVALID;
+
+  // ns spun per access
+  double extra_latency_;
+
+  // range written since the last sync (msync only)
+  size_t dirty_begin_;
+
+  size_t dirty_end_ = 0;
+
+  std::string write_buffer_;
+
+  std::string read_buffer_;
+
+};
+
+// Volatile byte-addressable tier in anonymous (hugepage) memory
+//
+// Slower memories are emulated Quartz-style: the cost of copying a byte is
+// calibrated upfront, and every access spins for the extra time its bytes
+// would take on a medium read_factor/write_factor times slower than DRAM,
+// plus a fixed extra latency.
+class MemoryBackend : public EmulationBackend {
+ public:
+
+  MemoryBackend(const size_t& memory_size,
+                const size_t& buffer_size,
+                const double& read_factor,
+                const double& write_factor,
+                const double& extra_latency);
+
+  ~MemoryBackend();
+
+  void Read(const off64_t& offset, const size_t& byte_count);
+
+  void Write(const off64_t& offset, const size_t& byte_count);
+
+  // Nothing to persist
+  void Sync() {}
+
+  bool IsHugePageBacked() const {
+    return is_huge_page_backed_;
+  }
+
+  // calibrated DRAM copy cost (ns per byte)
+  double GetReadCost() const {
+    return read_cost_;
+  }
+
+  double GetWriteCost() const {
+    return write_cost_;
+  }
+
+  static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+ private:
+
+  void Calibrate();
+
+  char* memory_ = nullptr;
+
+  size_t memory_size_;
+
+  bool is_huge_page_backed_ = false;
+
+  double read_factor_;
+
+  double write_factor_;
+
+  double extra_latency_;
+
+  double read_cost_ = 0;
+
+  double write_cost_ = 0;
+
+  std::string write_buffer_;
+
+  std::string read_buffer_;
+
+};
+
+class EmulationBackendFactory {
+ public:
+
+  // Memory tiers do not need a backing file
+  static EmulationBackendType GetEmulationBackendType(const configuration& state,
+                                                     const DeviceType& device_type);
+
+  // The NVM tier may use its own backend type
+  static std::unique_ptr<EmulationBackend> GetEmulationBackend(const configuration& state,
+                                                               const DeviceType& device_type,
+                                                               const EmulationTarget& target,
+                                                               const size_t& buffer_size);
+
+};
+
+}  // End machine namespace
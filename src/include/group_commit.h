@@ -0,0 +1,70 @@
+// GROUP COMMIT HEADER
+
+#pragma once
+
+#include <ostream>
+
+namespace machine {
+
+// Batches flushed blocks of a device behind a single sync
+//
+// A batch is synced once it holds batch_size blocks or once its oldest
+// block has waited for the window (logical ns, 0 disables the window). The
+// sync latency is split evenly across the blocks that waited on it, and
+// each op is charged the share of its blocks.
+class GroupCommit {
+ public:
+
+  GroupCommit(const size_t& batch_size, const double& window);
+
+  // Queue a flushed block; returns true once the batch should be synced
+  bool Add(const double& now);
+
+  // Whether the pending batch has waited for the window
+  bool IsDue(const double& now) const;
+
+  // Record the sync of the pending batch and return the latency share of
+  // each of its blocks (ns)
+  double Commit(const double& sync_latency, const double& now);
+
+  // Sync latency per committed block (ns)
+  double GetSyncLatencyPerBlock() const;
+
+  size_t GetPendingCount() const {
+    return pending_count_;
+  }
+
+  void ResetStats();
+
+  friend std::ostream& operator<< (std::ostream& os, const GroupCommit& group_commit);
+
+ private:
+
+  size_t batch_size_;
+
+  // ns
+  double window_;
+
+  // PENDING BATCH
+
+  size_t pending_count_ = 0;
+
+  double first_pending_time_ = 0;
+
+  // sum of the times at which pending blocks were queued
+  double pending_time_sum_ = 0;
+
+  // STATS
+
+  size_t batch_count_ = 0;
+
+  size_t committed_count_ = 0;
+
+  double sync_latency_ = 0;
+
+  // time from queueing to commit summed over committed blocks
+  double commit_wait_ = 0;
+
+};
+
+}  // End machine namespace
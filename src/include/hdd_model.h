@@ -0,0 +1,110 @@
+// HDD MODEL HEADER
+
+#pragma once
+
+#include <ostream>
+#include <vector>
+
+namespace machine {
+
+// Mechanical disk with a single head
+//
+// Pages are laid out track by track. Each access pays a seek that grows
+// with the square root of the cylinder distance, waits for the target page
+// to rotate under the head, and transfers at the media rate. Writebacks are
+// queued and serviced in elevator (SCAN) order once the queue fills up.
+// The platter keeps spinning while the disk is idle, so every request
+// carries the logical time it arrives at.
+class HDDModel {
+ public:
+
+  HDDModel(const size_t& page_count,
+           const size_t& pages_per_track,
+           const double& rotation_latency,
+           const double& track_seek_latency,
+           const double& full_seek_latency,
+           const size_t& queue_depth);
+
+  // Service an access arriving at the given time (ns); returns its latency
+  double Access(const size_t& page,
+                const size_t& page_count,
+                const double& timestamp);
+
+  // Queue a writeback; returns true once the queue is full
+  bool QueueWrite(const size_t& page, const size_t& page_count);
+
+  // Service all queued writebacks in elevator order; returns the service
+  // time of each, indexed by its slot (arrival order) in the queue
+  std::vector<double> Drain(const double& timestamp);
+
+  double GetSeekLatency(const size_t& distance) const;
+
+  size_t GetPageCount() const {
+    return page_count_;
+  }
+
+  size_t GetPendingCount() const {
+    return queue_.size();
+  }
+
+  void ResetStats();
+
+  friend std::ostream& operator<< (std::ostream& os, const HDDModel& hdd_model);
+
+ private:
+
+  size_t page_count_;
+
+  size_t pages_per_track_;
+
+  size_t cylinder_count_;
+
+  // latencies (ns)
+  double rotation_latency_;
+
+  double track_seek_latency_;
+
+  double full_seek_latency_;
+
+  struct QueuedWrite {
+
+    size_t page;
+
+    size_t page_count;
+
+    // arrival order in the queue
+    size_t slot;
+
+  };
+
+  // pending writebacks
+  std::vector<QueuedWrite> queue_;
+
+  size_t queue_depth_;
+
+  // HEAD STATE
+
+  size_t head_cylinder_ = 0;
+
+  bool is_moving_up_ = true;
+
+  // time the head is free (ns), which sets the platter angle
+  double clock_ = 0;
+
+  // STATS
+
+  size_t access_count_ = 0;
+
+  size_t seek_distance_ = 0;
+
+  size_t batch_count_ = 0;
+
+  size_t batched_write_count_ = 0;
+
+  double seek_latency_ = 0;
+
+  double rotation_wait_ = 0;
+
+};
+
+}  // End machine namespace
@@ -0,0 +1,137 @@
+// HISTOGRAM HEADER
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace machine {
+
+// Log-bucketed latency histogram (HDR-style)
+//
+// Values below 2^SUB_BUCKET_BITS get their own bucket. Larger values are
+// split into powers of two, each with 2^SUB_BUCKET_BITS linear sub-buckets,
+// so the relative error stays below 2^-SUB_BUCKET_BITS.
+class Histogram {
+ public:
+
+  Histogram()
+  : buckets_(BUCKET_COUNT, 0) {
+  }
+
+  // Record a value (O(1))
+  inline void Record(const double& value) {
+    uint64_t bucket_value = (value > 0) ? (uint64_t) (value + 0.5) : 0;
+    buckets_[GetBucketIndex(bucket_value)]++;
+    count_++;
+    total_ += value;
+    max_ = std::max(max_, value);
+  }
+
+  // Move a recorded value up by delta (O(1))
+  inline void Shift(const double& value, const double& delta) {
+    uint64_t bucket_value = (value > 0) ? (uint64_t) (value + 0.5) : 0;
+    auto& bucket = buckets_[GetBucketIndex(bucket_value)];
+    if(bucket == 0){
+      return;
+    }
+    bucket--;
+    count_--;
+    total_ -= value;
+    Record(value + delta);
+  }
+
+  void Merge(const Histogram& histogram) {
+    for(size_t bucket_itr = 0; bucket_itr < BUCKET_COUNT; bucket_itr++){
+      buckets_[bucket_itr] += histogram.buckets_[bucket_itr];
+    }
+    count_ += histogram.count_;
+    total_ += histogram.total_;
+    max_ = std::max(max_, histogram.max_);
+  }
+
+  void Reset() {
+    std::fill(buckets_.begin(), buckets_.end(), 0);
+    count_ = 0;
+    total_ = 0;
+    max_ = 0;
+  }
+
+  size_t GetCount() const {
+    return count_;
+  }
+
+  double GetMean() const {
+    if(count_ == 0){
+      return 0;
+    }
+    return total_ / count_;
+  }
+
+  double GetMax() const {
+    return max_;
+  }
+
+  // Value at the given percentile (0-100)
+  double GetPercentile(const double& percentile) const {
+    if(count_ == 0){
+      return 0;
+    }
+
+    // Rank of the requested value
+    size_t rank = (size_t) ((percentile / 100) * count_ + 0.5);
+    rank = std::max(rank, (size_t) 1);
+    rank = std::min(rank, count_);
+
+    size_t current_count = 0;
+    for(size_t bucket_itr = 0; bucket_itr < BUCKET_COUNT; bucket_itr++){
+      current_count += buckets_[bucket_itr];
+      if(current_count >= rank){
+        return std::min((double) GetBucketUpperBound(bucket_itr), max_);
+      }
+    }
+
+    return max_;
+  }
+
+  static inline size_t GetBucketIndex(const uint64_t& value) {
+    if(value < SUB_BUCKET_COUNT){
+      return value;
+    }
+
+    size_t shift = (63 - __builtin_clzll(value)) - SUB_BUCKET_BITS;
+    return ((shift + 1) << SUB_BUCKET_BITS) +
+        ((value >> shift) - SUB_BUCKET_COUNT);
+  }
+
+  static inline uint64_t GetBucketUpperBound(const size_t& bucket_index) {
+    if(bucket_index < SUB_BUCKET_COUNT){
+      return bucket_index;
+    }
+
+    size_t shift = (bucket_index >> SUB_BUCKET_BITS) - 1;
+    uint64_t sub_bucket = (bucket_index & (SUB_BUCKET_COUNT - 1)) + SUB_BUCKET_COUNT;
+    return ((sub_bucket + 1) << shift) - 1;
+  }
+
+  static const size_t SUB_BUCKET_BITS = 7;
+
+  static const size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+
+  static const size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+ private:
+
+  // value count in each bucket
+  std::vector<uint64_t> buckets_;
+
+  size_t count_ = 0;
+
+  double total_ = 0;
+
+  double max_ = 0;
+
+};
+
+}  // End machine namespace
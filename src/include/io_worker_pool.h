@@ -0,0 +1,143 @@
+// IO WORKER POOL HEADER
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "emulation_backend.h"
+#include "timer.h"
+#include "types.h"
+
+namespace machine {
+
+class configuration;
+
+// Emulated I/O issued by a client
+struct IORequest {
+
+  DeviceType device_type = DEVICE_TYPE_INVALID;
+
+  // flush syncs the device
+  OperationType operation_type = OPERATION_TYPE_READ;
+
+  off64_t offset = 0;
+
+  size_t byte_count = 0;
+
+};
+
+// Threads that perform emulated I/O on behalf of simulated clients
+//
+// Each worker opens its own backend (and descriptor) for every device and
+// serves a bounded queue in order, so a client's writes reach the device
+// before its syncs. The simulation only waits when a queue is full, or for
+// the reads it needs the data of, which lets emulation drive as many
+// concurrent requests as there are workers.
+class IOWorkerPool {
+ public:
+
+  IOWorkerPool(const configuration& state,
+               const std::map<DeviceType, EmulationTarget>& targets,
+               const size_t& worker_count,
+               const size_t& queue_depth,
+               const size_t& buffer_size);
+
+  ~IOWorkerPool();
+
+  // Queue a request on a worker, waiting while its queue is full; returns
+  // a ticket to wait on
+  size_t Submit(const size_t& worker, const IORequest& request);
+
+  // Wait until the request with the given ticket is done
+  void Wait(const size_t& worker, const size_t& ticket);
+
+  // Wait until every queued request is done
+  void Drain();
+
+  // Sync a device on each of the given workers, after the requests already
+  // queued there, and wait for the syncs; returns the longest sync as
+  // timed on the workers (ns)
+  double Sync(const DeviceType& device_type, const std::set<size_t>& worker_ids);
+
+  bool IsPooled(const DeviceType& device_type) const {
+    return device_types_.count(device_type) != 0;
+  }
+
+  size_t GetWorkerCount() const {
+    return workers_.size();
+  }
+
+  void ResetStats();
+
+  friend std::ostream& operator<< (std::ostream& os, const IOWorkerPool& io_worker_pool);
+
+ private:
+
+  // Per device and operation type
+  struct WorkerStats {
+
+    size_t operation_count[OPERATION_TYPE_COUNT] = {};
+
+    size_t byte_count = 0;
+
+    // ns
+    double service_time[OPERATION_TYPE_COUNT] = {};
+
+  };
+
+  struct Worker {
+
+    std::thread thread;
+
+    std::mutex mutex;
+
+    std::condition_variable has_request;
+
+    std::condition_variable has_space;
+
+    std::condition_variable is_idle;
+
+    std::deque<IORequest> queue;
+
+    bool is_busy = false;
+
+    // requests queued and done so far (tickets count up from 1)
+    size_t submitted_count = 0;
+
+    size_t completed_count = 0;
+
+    bool is_stopping = false;
+
+    // service time of the last sync (ns)
+    double sync_time = 0;
+
+    std::map<DeviceType, std::unique_ptr<EmulationBackend>> backends;
+
+    std::map<DeviceType, WorkerStats> stats;
+
+  };
+
+  void Run(Worker& worker);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  std::map<DeviceType, bool> device_types_;
+
+  size_t queue_depth_;
+
+  // wall time between the last reset and the last drain
+  time_point_ start_;
+
+  time_point_ end_;
+
+};
+
+}  // End machine namespace
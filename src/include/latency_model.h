@@ -0,0 +1,134 @@
+// LATENCY MODEL HEADER
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "types.h"
+#include "distribution.h"
+
+namespace machine {
+
+class configuration;
+
+// Table indices
+enum AccessType {
+  ACCESS_TYPE_READ = 0,
+  ACCESS_TYPE_WRITE = 1,
+
+  ACCESS_TYPE_COUNT = 2
+};
+
+class LatencyModel {
+ public:
+
+  virtual ~LatencyModel() {}
+
+  // Latency (ns) of transferring byte_count bytes
+  virtual double GetLatency(const DeviceType& device_type,
+                            const AccessType& access_type,
+                            const PatternType& pattern_type,
+                            const size_t& byte_count) = 0;
+
+  // Latency (ns) of a single page
+  inline double GetPageLatency(const DeviceType& device_type,
+                               const AccessType& access_type,
+                               const PatternType& pattern_type) const {
+    return latencies_[device_type][access_type][pattern_type];
+  }
+
+  void SetPageLatency(const DeviceType& device_type,
+                      const AccessType& access_type,
+                      const PatternType& pattern_type,
+                      const double& latency);
+
+  // Bandwidth (bytes/ns) used by the size-dependent model
+  inline double GetBandwidth(const DeviceType& device_type,
+                             const AccessType& access_type) const {
+    return bandwidths_[device_type][access_type];
+  }
+
+  void SetBandwidth(const DeviceType& device_type,
+                    const AccessType& access_type,
+                    const double& bandwidth);
+
+ protected:
+
+  // The first page pays the access latency and the rest stream sequentially
+  inline double GetTransferLatency(const DeviceType& device_type,
+                                   const AccessType& access_type,
+                                   const PatternType& pattern_type,
+                                   const size_t& byte_count) const {
+    size_t page_count = (byte_count + PAGE_SIZE - 1)/PAGE_SIZE;
+    if(page_count == 0){
+      return 0;
+    }
+
+    return latencies_[device_type][access_type][pattern_type] +
+        (page_count - 1) * latencies_[device_type][access_type][PATTERN_TYPE_SEQUENTIAL];
+  }
+
+  static constexpr size_t PAGE_SIZE = 4096;
+
+  // per page latencies (ns)
+  double latencies_[DEVICE_TYPE_COUNT][ACCESS_TYPE_COUNT][PATTERN_TYPE_COUNT] = {};
+
+  // transfer bandwidths (bytes/ns)
+  double bandwidths_[DEVICE_TYPE_COUNT][ACCESS_TYPE_COUNT] = {};
+
+};
+
+// Fixed sequential and random latencies per page
+class FixedLatencyModel : public LatencyModel {
+ public:
+
+  double GetLatency(const DeviceType& device_type,
+                    const AccessType& access_type,
+                    const PatternType& pattern_type,
+                    const size_t& byte_count) override;
+
+};
+
+// Fixed latencies scaled by a log-normal factor sampled per operation
+class DistributionLatencyModel : public LatencyModel {
+ public:
+
+  DistributionLatencyModel(const double& sigma,
+                           const unsigned long& seed);
+
+  double GetLatency(const DeviceType& device_type,
+                    const AccessType& access_type,
+                    const PatternType& pattern_type,
+                    const size_t& byte_count) override;
+
+ private:
+
+  static constexpr size_t SAMPLE_COUNT = 4096;
+
+  // precomputed factors with mean one
+  std::vector<double> samples_;
+
+  UniformDistribution generator_;
+
+};
+
+// Access latency plus byte_count / bandwidth
+class SizeLatencyModel : public LatencyModel {
+ public:
+
+  double GetLatency(const DeviceType& device_type,
+                    const AccessType& access_type,
+                    const PatternType& pattern_type,
+                    const size_t& byte_count) override;
+
+};
+
+class LatencyModelFactory {
+ public:
+
+  static std::unique_ptr<LatencyModel> GetLatencyModel(const configuration& state);
+
+};
+
+}  // End machine namespace
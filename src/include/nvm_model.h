@@ -0,0 +1,137 @@
+// NVM MODEL HEADER
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace machine {
+
+// Persistent memory media behind a write-combining buffer
+//
+// Host writes land in a small buffer of 256 B lines where writes to the same
+// line are merged. Lines leave the buffer in LRU order and are written to the
+// media, which drains at a fixed write bandwidth; once the backlog exceeds
+// the buffer, writes stall. Media writes are counted per region to track
+// wear, and wear leveling can periodically swap the most and least worn
+// regions.
+class NVMModel {
+ public:
+
+  NVMModel(const size_t& capacity,
+           const size_t& region_size,
+           const double& write_bandwidth,
+           const size_t& buffer_line_count,
+           const double& endurance,
+           const bool& wear_leveling);
+
+  // Write the given bytes at time now (ns) and return the stall (ns)
+  double Write(const size_t& address,
+               const size_t& byte_count,
+               const double& now);
+
+  size_t GetCapacity() const {
+    return capacity_;
+  }
+
+  // Media bytes written per host byte
+  double GetWriteAmplification() const;
+
+  // Time (s) until the most worn region reaches its endurance at the wear
+  // rate observed over the given duration
+  double GetLifetime(const double& duration_ns) const;
+
+  void ResetStats();
+
+  friend std::ostream& operator<< (std::ostream& os, const NVMModel& nvm_model);
+
+  // size of a media line (in bytes)
+  static const size_t LINE_SIZE = 256;
+
+  // buffer tracks line fill in chunks of this many bytes
+  static const size_t CHUNK_SIZE = LINE_SIZE / 64;
+
+  static const uint64_t FULL_LINE = UINT64_MAX;
+
+  // line writes between wear leveling steps (in region sizes)
+  static const size_t WEAR_LEVELING_PERIOD = 16;
+
+ private:
+
+  struct BufferLine {
+
+    // line address (in lines)
+    size_t line = 0;
+
+    // chunks written since the line entered the buffer
+    uint64_t mask = 0;
+
+    // logical time of the last write
+    size_t last_write = 0;
+
+  };
+
+  void WriteLine(const size_t& line, const uint64_t& mask, const double& now);
+
+  // Write back a buffered line to the media
+  void WriteMedia(const size_t& line, const uint64_t& mask, const double& now);
+
+  // Swap the most and least worn regions
+  void LevelWear(const double& now);
+
+  // media capacity (in bytes)
+  size_t capacity_;
+
+  size_t region_count_;
+
+  size_t lines_per_region_;
+
+  // media write bandwidth (bytes/ns)
+  double write_bandwidth_;
+
+  size_t buffer_line_count_;
+
+  // writes each media line sustains
+  double endurance_;
+
+  bool wear_leveling_;
+
+  std::vector<BufferLine> buffer_;
+
+  // logical region -> physical region and back
+  std::vector<size_t> mapping_;
+
+  std::vector<size_t> reverse_mapping_;
+
+  // line writes per physical region (since creation)
+  std::vector<size_t> wear_;
+
+  // line writes per physical region (since the last reset)
+  std::vector<size_t> window_wear_;
+
+  // time (ns) at which the media drains its backlog
+  double media_free_ns_ = 0;
+
+  size_t writes_since_leveling_ = 0;
+
+  // logical clock
+  size_t clock_ = 0;
+
+  // STATS
+
+  size_t host_byte_count_ = 0;
+
+  size_t media_line_count_ = 0;
+
+  size_t combined_line_count_ = 0;
+
+  size_t partial_line_count_ = 0;
+
+  size_t swap_count_ = 0;
+
+  double stall_latency_ = 0;
+
+};
+
+}  // End machine namespace
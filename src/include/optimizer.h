@@ -0,0 +1,48 @@
+// OPTIMIZER HEADER
+
+#pragma once
+
+#include <vector>
+
+#include "types.h"
+
+namespace machine {
+
+class configuration;
+
+// A point in the hierarchy design space
+struct Candidate {
+
+  HierarchyType hierarchy_type = HIERARCHY_TYPE_INVALID;
+
+  SizeType size_type = SIZE_TYPE_INVALID;
+
+  SizeRatioType size_ratio_type = SIZE_RATIO_TYPE_INVALID;
+
+  CachingType caching_type = CACHING_TYPE_INVALID;
+
+  // hardware cost ($)
+  double cost = 0;
+
+  // throughput (ops/s)
+  double throughput = 0;
+
+  // op latency at the SLO percentile (ns)
+  double latency = 0;
+
+};
+
+std::vector<Candidate> GetCandidates(const configuration& state);
+
+double GetCandidateCost(const Candidate& candidate,
+                        const configuration& state);
+
+bool IsFeasible(const Candidate& candidate,
+                const configuration& state);
+
+// Candidates not dominated in (lower cost, higher throughput)
+std::vector<Candidate> GetParetoFrontier(const std::vector<Candidate>& candidates);
+
+void RunOptimizer(configuration& state);
+
+}  // End machine namespace
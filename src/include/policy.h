@@ -23,6 +23,8 @@ class ICachePolicy {
 
   virtual Value Get(const Key& key) = 0;
 
+  virtual void Erase(const Key& key) = 0;
+
   virtual size_t GetSize() const = 0;
 
   virtual void Print() const = 0;
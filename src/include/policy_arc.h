@@ -2,84 +2,65 @@
 
 #pragma once
 
-#include <deque>
-#include <vector>
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <vector>
 
 #include <glog/logging.h>
 
 #include "macros.h"
 #include "policy.h"
+#include "policy_index.h"
 
 namespace machine {
 
-#define MAX(a,b) (((a)>(b))?(a):(b))
-
+// Adaptive replacement cache
+//
+// Resident (T1, T2) and ghost (B1, B2) entries share one node pool of twice
+// the capacity. A single index maps each key to its node, which records the
+// list it is on, and the lists are threaded through the pool, so every
+// operation is O(1).
 template <typename Key, typename Value>
 class ARCCachePolicy : public ICachePolicy<Key, Value> {
  public:
 
   ARCCachePolicy(const size_t& capacity,
                  UNUSED_ATTRIBUTE const double& clean_fraction)
- : capacity_(capacity),
+ : nodes_(2 * capacity),
+   index_(2 * capacity),
+   capacity_(capacity),
    p(0){
-    // Nothing to do here!
-  }
 
-  ~ARCCachePolicy() = default;
-
-  bool DequeContains(const std::deque<Key>& deque, const Key& key) const {
-    auto location = std::find(deque.begin(), deque.end(), key);
-    if (location != deque.end()) {
-      return true;
+    if(capacity_ == 0 || capacity_ >= INVALID_SLOT / 4){
+      std::cout << "Invalid ARC capacity: " << capacity_ << "\n";
+      exit(EXIT_FAILURE);
     }
-    return false;
-  }
 
-  void DequeErase(std::deque<Key>& deque, const Key& key){
-    auto location = std::find(deque.begin(), deque.end(), key);
-    if (location != deque.end()) {
-      deque.erase(location);
-    }
-  }
+    InitializeFreeList(nodes_, free_list_);
 
-  void DequePrint(std::string deque_name, const std::deque<Key>& deque) const{
-    std::stringstream str;
-    str << deque_name << " :: ";
-    for(auto entry : deque){
-      str << entry << " ";
-    }
-    str << "\n";
-    DLOG(INFO) << str.str();
   }
 
-  void Check(){
+  ~ARCCachePolicy() = default;
 
-    // Print
-    DLOG(INFO) << "\n+++++++++++++++++++++++++++++++++++++\n";
-    //DequePrint("T1", T1);
-    //DequePrint("B1",B1);
-    //DequePrint("T2",T2);
-    //DequePrint("B2",B2);
-    DLOG(INFO) << "+++++++++++++++++++++++++++++++++++++\n";
+  void Check(){
 
     if (GetSize() > capacity_) {
       DLOG(INFO) << "Capacity exceeded \n";
       exit(EXIT_FAILURE);
     }
 
-    if(p > capacity_ || p < 0){
+    if(p > capacity_){
       DLOG(INFO) << "p exceeds capacity \n";
       exit(EXIT_FAILURE);
     }
 
-    if(T1.size() + B1.size() > capacity_){
+    if(T1.GetSize() + B1.GetSize() > capacity_){
       DLOG(INFO) << "L1 exceeds capacity \n";
       exit(EXIT_FAILURE);
     }
 
-    if(T1.size() + B1.size() + T2.size() + B2.size() > 2 * capacity_){
+    if(T1.GetSize() + B1.GetSize() + T2.GetSize() + B2.GetSize() > 2 * capacity_){
       DLOG(INFO) << "L1 + L2 exceeds 2 * capacity \n";
       exit(EXIT_FAILURE);
     }
@@ -89,146 +70,109 @@ class ARCCachePolicy : public ICachePolicy<Key, Value> {
   void Touch(const Key& key) {
 
     // check if key exists
-    if(cache_items_map.count(key) == 0){
+    auto node = index_.Find(key);
+    if(node == INVALID_SLOT ||
+        (nodes_[node].list != LIST_T1 && nodes_[node].list != LIST_T2)){
       DLOG(INFO) << "KEY NOT FOUND: " << key << "\n";
       exit(EXIT_FAILURE);
     }
 
-    if (DequeContains(T1, key)) {
-      DLOG(INFO) << "T1 contains key\n";
-      DequeErase(T1, key);
-      T2.push_front(key);
-      DLOG(INFO) << "Move from T1 to T2\n";
-    }
-    else if (DequeContains(T2, key)){
-      DLOG(INFO) << "T2 contains key\n";
-      DequeErase(T2, key);
-      T2.push_front(key);
-      DLOG(INFO) << "Move from T1 to T2\n";
-    }
-    else{
-      DLOG(INFO) << "KEY NOT FOUND IN T1 & T2: " << key << "\n";
-      exit(EXIT_FAILURE);
-    }
+    TouchNode(node);
 
   }
 
-  Key Replace(const Key& key) {
-    DLOG(INFO) << "ARC REPLACE : " << key << "\n";
-
-    Key victim_key = INVALID_KEY;
-    bool T1_not_empty = (T1.empty() == false);
-    bool in_B2 = DequeContains(B2, key);
-    bool len_T1_eq_P = (T1.size() == p);
-    bool len_T1_gt_P = (T1.size() > p);
-
-    if(T1_not_empty && ((len_T1_eq_P && in_B2) || len_T1_gt_P)){
-      DLOG(INFO) << "Evict from T1 to B1\n";
-      victim_key = T1.back();
-      T1.pop_back();
-      B1.push_front(victim_key);
-    }
-    else {
-      DLOG(INFO) << "Evict from T2 to B2\n";
-      victim_key = T2.back();
-      T2.pop_back();
-      B2.push_front(victim_key);
-    }
-
-    return victim_key;
-  }
-
   Block Put(const Key& key, const Value& value) {
     Block victim;
     Key victim_key = INVALID_KEY;
     Value victim_value = INVALID_KEY;
+    uint32_t victim_node = INVALID_SLOT;
 
-    // Check if key in T1
-    if (DequeContains(T1, key)) {
-      DLOG(INFO) << "T1 contains key\n";
-      DequeErase(T1, key);
-      T2.push_front(key);
-      DLOG(INFO) << "Move from T1 to T2\n";
-    }
-    // Check if key in T2
-    else if (DequeContains(T2, key)){
-      DLOG(INFO) << "T2 contains key\n";
-      DequeErase(T2, key);
-      T2.push_front(key);
-      DLOG(INFO) << "Keep in T2\n";
+    auto node = index_.Find(key);
+    auto list = (node == INVALID_SLOT) ? LIST_NONE : nodes_[node].list;
+
+    // Check if key in T1 or T2
+    if (list == LIST_T1 || list == LIST_T2) {
+      DLOG(INFO) << "T1 or T2 contains key\n";
+      TouchNode(node);
     }
     // Check if key in B1
-    else if(DequeContains(B1, key)){
+    else if(list == LIST_B1){
       DLOG(INFO) << "B1 contains key\n";
-      size_t size_ratio = B2.size()/B1.size();
-      size_t b_ratio = MAX(size_ratio, 1);
+      size_t size_ratio = B2.GetSize()/B1.GetSize();
+      size_t b_ratio = std::max<size_t>(size_ratio, 1);
       p = std::min(capacity_, p + b_ratio);
       DLOG(INFO) << "Adapt p\n";
 
-      victim_key = Replace(key);
+      victim_node = Replace(false);
 
-      DequeErase(B1, key);
-      T2.push_front(key);
+      B1.Unlink(nodes_, node);
+      MoveTo(T2, node, LIST_T2);
       DLOG(INFO) << "Move from B1 to T2\n";
     }
     // Check if key in B2
-    else if(DequeContains(B2, key)){
+    else if(list == LIST_B2){
       DLOG(INFO) << "B2 contains key\n";
-      size_t size_ratio = B1.size()/B2.size();
-      size_t b_ratio = MAX(size_ratio, 1);
+      size_t size_ratio = B1.GetSize()/B2.GetSize();
+      size_t b_ratio = std::max<size_t>(size_ratio, 1);
       if(p >= b_ratio) {
-        p = MAX(0, p - b_ratio);
+        p = p - b_ratio;
       }
       DLOG(INFO) << "Adapt p\n";
 
-      victim_key = Replace(key);
+      victim_node = Replace(true);
 
-      DequeErase(B2, key);
-      T2.push_front(key);
+      B2.Unlink(nodes_, node);
+      MoveTo(T2, node, LIST_T2);
       DLOG(INFO) << "Move from B2 to T2\n";
     }
     // Key not found in T1, T2, B1, and B2
     else {
       DLOG(INFO) << "Completely new key\n";
 
-      auto l1 = T1.size() + B1.size();
-      auto l2 = T2.size() + B2.size();
+      auto l1 = T1.GetSize() + B1.GetSize();
+      auto l2 = T2.GetSize() + B2.GetSize();
       auto l1_plus_l2 = l1 + l2;
 
       // CASE 1: |L1| = c
       if(l1 == capacity_){
-        if(T1.size() < capacity_){
-          B1.pop_back();
-          victim_key = Replace(key);
+        if(T1.GetSize() < capacity_){
+          Forget(B1.PopBack(nodes_));
+          victim_node = Replace(false);
           DLOG(INFO) << "Make space in B1\n";
         }
         else {
-          victim_key = T1.back();
-          T1.pop_back();
+          // evicted without a ghost entry
+          auto evicted_node = T1.PopBack(nodes_);
+          victim_key = nodes_[evicted_node].key;
+          victim_value = nodes_[evicted_node].value;
+          Forget(evicted_node);
           DLOG(INFO) << "Make space in T1\n";
         }
       }
       // CASE 2: |L1|< c and |L1|+ |L2|≥ c
       else if(l1 < capacity_ && l1_plus_l2 >= capacity_) {
         if(l1_plus_l2 == 2 * capacity_){
-          B2.pop_back();
+          Forget(B2.PopBack(nodes_));
           DLOG(INFO) << "Make space in B2\n";
         }
 
-        victim_key = Replace(key);
+        victim_node = Replace(false);
       }
 
-      T1.push_front(key);
+      node = free_list_.PopFront(nodes_);
+      nodes_[node].key = key;
+      index_.Insert(key, node);
+      MoveTo(T1, node, LIST_T1);
       DLOG(INFO) << "Move to T1\n";
     }
 
     // update value of element
-    cache_items_map[key] = value;
+    nodes_[node].value = value;
 
-    // evict victim
-    if(victim_key != INVALID_KEY){
-      victim_value = cache_items_map[victim_key];
-      cache_items_map.erase(victim_key);
+    // evicted to a ghost list
+    if(victim_node != INVALID_SLOT){
+      victim_key = nodes_[victim_node].key;
+      victim_value = nodes_[victim_node].value;
     }
 
     // Run integrity checks
@@ -242,36 +186,58 @@ class ARCCachePolicy : public ICachePolicy<Key, Value> {
 
   Value Get(const Key& key){
 
-    auto elem_it = cache_items_map.find(key);
-    if (elem_it == cache_items_map.end()) {
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT ||
+        (nodes_[node].list != LIST_T1 && nodes_[node].list != LIST_T2)) {
       return INVALID_VALUE;
     }
 
     // Touch element
-    Touch(key);
+    TouchNode(node);
 
-    // Run integrity checks
-    //Check();
+    return nodes_[node].value;
+  }
+
+  void Erase(const Key& key){
+
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT) {
+      return;
+    }
+
+    auto list = nodes_[node].list;
+    if(list == LIST_T1){
+      T1.Unlink(nodes_, node);
+    }
+    else if(list == LIST_T2){
+      T2.Unlink(nodes_, node);
+    }
+    else {
+      return;
+    }
+
+    Forget(node);
 
-    return elem_it->second;
   }
 
   size_t GetSize() const{
-    return cache_items_map.size();
+    return T1.GetSize() + T2.GetSize();
   }
 
   void Print() const{
 
-    auto current_size = cache_items_map.size();
+    auto current_size = GetSize();
     std::cout << "OCCUPIED: " << (current_size * 100)/capacity_ << " %\n";
 
     size_t block_itr = 0;
     size_t print_block_count = 100;
-    for(auto& cache_item : cache_items_map){
-      if(block_itr++ >= print_block_count){
-        break;
+    for(auto list : {&T1, &T2}){
+      for(auto node = list->GetFront(); node != INVALID_SLOT; node = nodes_[node].next){
+        if(block_itr++ >= print_block_count){
+          break;
+        }
+        std::cout << nodes_[node].key << CleanStatus(nodes_[node].value, false) << " ";
       }
-      std::cout << cache_item.first << CleanStatus(cache_item.second, false) << " ";
     }
 
     if(print_block_count > 0) {
@@ -282,13 +248,81 @@ class ARCCachePolicy : public ICachePolicy<Key, Value> {
 
  private:
 
-  std::deque<Key> T1;
-  std::deque<Key> B1;
+  enum ListType : uint8_t {
+    LIST_NONE = 0,
+    LIST_T1 = 1,
+    LIST_B1 = 2,
+    LIST_T2 = 3,
+    LIST_B2 = 4
+  };
+
+  struct Node {
+    Key key = Key();
+    Value value = Value();
+    uint32_t prev = INVALID_SLOT;
+    uint32_t next = INVALID_SLOT;
+    ListType list = LIST_NONE;
+  };
+
+  void MoveTo(NodeList& target, const uint32_t& node, const ListType& list){
+    target.PushFront(nodes_, node);
+    nodes_[node].list = list;
+  }
+
+  // Hit on a resident entry
+  void TouchNode(const uint32_t& node){
+    if(nodes_[node].list == LIST_T1){
+      DLOG(INFO) << "Move from T1 to T2\n";
+      T1.Unlink(nodes_, node);
+      MoveTo(T2, node, LIST_T2);
+    }
+    else {
+      DLOG(INFO) << "Keep in T2\n";
+      T2.MoveToFront(nodes_, node);
+    }
+  }
+
+  // Drop an unlinked node from the index and the pool
+  void Forget(const uint32_t& node){
+    index_.Erase(nodes_[node].key);
+    nodes_[node].list = LIST_NONE;
+    free_list_.PushFront(nodes_, node);
+  }
+
+  // Move the LRU entry of T1 or T2 to its ghost list and return it
+  uint32_t Replace(const bool& in_B2) {
+    DLOG(INFO) << "ARC REPLACE\n";
+
+    uint32_t victim_node = INVALID_SLOT;
+    bool T1_not_empty = (T1.IsEmpty() == false);
+    bool len_T1_eq_P = (T1.GetSize() == p);
+    bool len_T1_gt_P = (T1.GetSize() > p);
+
+    if(T1_not_empty && ((len_T1_eq_P && in_B2) || len_T1_gt_P || T2.IsEmpty())){
+      DLOG(INFO) << "Evict from T1 to B1\n";
+      victim_node = T1.PopBack(nodes_);
+      MoveTo(B1, victim_node, LIST_B1);
+    }
+    else if(T2.IsEmpty() == false) {
+      DLOG(INFO) << "Evict from T2 to B2\n";
+      victim_node = T2.PopBack(nodes_);
+      MoveTo(B2, victim_node, LIST_B2);
+    }
+
+    return victim_node;
+  }
+
+  std::vector<Node> nodes_;
+
+  KeyIndex<Key> index_;
+
+  NodeList T1;
+  NodeList B1;
 
-  std::deque<Key> T2;
-  std::deque<Key> B2;
+  NodeList T2;
+  NodeList B2;
 
-  std::unordered_map<Key, Value> cache_items_map;
+  NodeList free_list_;
 
   size_t capacity_;
 
@@ -0,0 +1,242 @@
+// CLOCK HEADER
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "macros.h"
+#include "policy.h"
+#include "policy_index.h"
+
+namespace machine {
+
+// cap on the usage count of a CLOCK frame (1: second chance)
+extern size_t clock_max_usage;
+
+// CLOCK sweep over a fixed array of frames, as in PostgreSQL's buffer manager
+//
+// A hit only bumps the usage count of its frame, up to clock_max_usage.
+// To find a victim the hand sweeps the frames, decrementing non-zero
+// counts, and takes the first frame whose count is zero. New blocks start
+// at a count of one. Usage counts and frame validity are kept in packed
+// bit arrays.
+template <typename Key, typename Value>
+class CLOCKCachePolicy : public ICachePolicy<Key, Value> {
+ public:
+
+  CLOCKCachePolicy(const size_t& capacity,
+                   UNUSED_ATTRIBUTE const double& clean_fraction)
+  : keys_(capacity),
+    values_(capacity),
+    usage_counts_(capacity),
+    valid_(capacity),
+    free_frames_(capacity),
+    index_(capacity),
+    max_usage_(clock_max_usage),
+    capacity_(capacity){
+
+    if(capacity_ == 0 || capacity_ >= INVALID_SLOT / 2){
+      std::cout << "Invalid CLOCK capacity: " << capacity_ << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    if(max_usage_ == 0 || max_usage_ > USAGE_MASK){
+      std::cout << "Invalid CLOCK max usage: " << max_usage_ << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    // Hand out frames in order
+    for(size_t frame_itr = 0; frame_itr < capacity_; frame_itr++){
+      free_frames_[frame_itr] = capacity_ - 1 - frame_itr;
+    }
+    free_frame_count_ = capacity_;
+
+  }
+
+  ~CLOCKCachePolicy() = default;
+
+  void Check(){
+
+    if (GetSize() > capacity_) {
+      std::cout << "Capacity exceeded \n";
+      exit(EXIT_FAILURE);
+    }
+
+  }
+
+  void Touch(const Key& key){
+
+    // check if key exists
+    auto frame = index_.Find(key);
+    if(frame == INVALID_SLOT){
+      std::cout << "KEY NOT FOUND: " << key << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    TouchFrame(frame);
+
+  }
+
+  Block Put(const Key& key, const Value& value){
+    Block victim;
+    Key victim_key = INVALID_KEY;
+    Value victim_value = INVALID_VALUE;
+
+    auto frame = index_.Find(key);
+    if (frame == INVALID_SLOT) {
+      // add new element to the cache
+
+      if (free_frame_count_ > 0) {
+        frame = free_frames_[--free_frame_count_];
+      }
+      else {
+        frame = Sweep();
+        victim_key = keys_[frame];
+        victim_value = values_[frame];
+
+        // evict victim
+        index_.Erase(victim_key);
+      }
+
+      // insert new element
+      keys_[frame] = key;
+      values_[frame] = value;
+      usage_counts_.Set(frame, 1);
+      valid_.Set(frame, 1);
+      index_.Insert(key, frame);
+    }
+    else {
+
+      // update previous value of element
+      values_[frame] = value;
+
+      // Touch element
+      TouchFrame(frame);
+
+    }
+
+    // Run integrity checks
+    Check();
+
+    // return victim
+    victim.block_id = victim_key;
+    victim.block_type = victim_value;
+    return victim;
+  }
+
+  Value Get(const Key& key){
+
+    auto frame = index_.Find(key);
+    if (frame == INVALID_SLOT) {
+      return INVALID_VALUE;
+    }
+
+    // Touch element
+    TouchFrame(frame);
+
+    return values_[frame];
+  }
+
+  void Erase(const Key& key){
+
+    auto frame = index_.Find(key);
+    if (frame == INVALID_SLOT) {
+      return;
+    }
+
+    index_.Erase(key);
+    valid_.Set(frame, 0);
+    usage_counts_.Set(frame, 0);
+    free_frames_[free_frame_count_++] = frame;
+
+  }
+
+  size_t GetSize() const{
+    return capacity_ - free_frame_count_;
+  }
+
+  // Usage count of a cached key (0 if absent)
+  size_t GetUsageCount(const Key& key) const{
+    auto frame = index_.Find(key);
+    if (frame == INVALID_SLOT) {
+      return 0;
+    }
+    return usage_counts_.Get(frame);
+  }
+
+  void Print() const{
+
+    std::cout << "OCCUPIED: " << (GetSize() * 100)/capacity_ << " %\n";
+
+    size_t block_itr = 0;
+    size_t print_block_count = 100;
+    for(size_t frame_itr = 0; frame_itr < capacity_; frame_itr++){
+      if(valid_.Get(frame_itr) == 0){
+        continue;
+      }
+      if(block_itr++ >= print_block_count){
+        break;
+      }
+      std::cout << keys_[frame_itr] << CleanStatus(values_[frame_itr], false) << " ";
+    }
+
+    if(print_block_count > 0) {
+      std::cout << "\n-------------------------------\n";
+    }
+
+  }
+
+ private:
+
+  static const uint8_t USAGE_MASK = PackedArray<4>::MASK;
+
+  void TouchFrame(const uint32_t& frame){
+    auto usage_count = usage_counts_.Get(frame);
+    if(usage_count < max_usage_){
+      usage_counts_.Set(frame, usage_count + 1);
+    }
+  }
+
+  // Advance the hand to a frame with no usage left (all frames are valid)
+  uint32_t Sweep(){
+    while(true){
+      auto frame = hand_;
+      hand_ = (hand_ + 1 == capacity_) ? 0 : hand_ + 1;
+
+      auto usage_count = usage_counts_.Get(frame);
+      if(usage_count == 0){
+        return frame;
+      }
+      usage_counts_.Set(frame, usage_count - 1);
+    }
+  }
+
+  std::vector<Key> keys_;
+
+  std::vector<Value> values_;
+
+  PackedArray<4> usage_counts_;
+
+  PackedArray<1> valid_;
+
+  // stack of unused frames
+  std::vector<uint32_t> free_frames_;
+
+  size_t free_frame_count_ = 0;
+
+  KeyIndex<Key> index_;
+
+  uint32_t hand_ = 0;
+
+  size_t max_usage_;
+
+  size_t capacity_;
+
+};
+
+template <typename Key, typename Value>
+const uint8_t CLOCKCachePolicy<Key, Value>::USAGE_MASK;
+
+}  // End machine namespace
@@ -0,0 +1,435 @@
+// CLOCK-PRO HEADER
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "macros.h"
+#include "policy.h"
+#include "policy_index.h"
+
+namespace machine {
+
+// CLOCK-Pro (Jiang, Chen and Zhang, USENIX ATC 2005)
+//
+// Resident hot and cold blocks and non-resident cold blocks (test entries)
+// share one circular list swept by three hands. A cold block starts a test
+// period when it is inserted, which lasts until HAND_test passes it.
+// HAND_cold promotes a referenced cold block to hot if it is still in its
+// test period, and otherwise starts a new period for it at the list head;
+// it evicts unreferenced cold blocks, keeping those in their test period
+// as test entries. HAND_hot demotes unreferenced hot blocks, and HAND_test
+// ends test periods and retires test entries. A hit on a test entry brings
+// the block back hot and grows the cold target, which starts at its
+// minimum, while a test period that ends unused shrinks it. The list is
+// threaded through a node pool of twice the capacity and page states,
+// reference bits and test periods live in packed bit arrays.
+template <typename Key, typename Value>
+class CLOCKProCachePolicy : public ICachePolicy<Key, Value> {
+ public:
+
+  CLOCKProCachePolicy(const size_t& capacity,
+                      UNUSED_ATTRIBUTE const double& clean_fraction)
+  : nodes_(2 * capacity + 1),
+    page_types_(2 * capacity + 1),
+    references_(2 * capacity + 1),
+    test_periods_(2 * capacity + 1),
+    index_(2 * capacity + 1),
+    cold_target_(MIN_COLD_TARGET),
+    capacity_(capacity){
+
+    if(capacity_ == 0 || capacity_ >= INVALID_SLOT / 4){
+      std::cout << "Invalid CLOCK-Pro capacity: " << capacity_ << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    InitializeFreeList(nodes_, free_list_);
+
+  }
+
+  ~CLOCKProCachePolicy() = default;
+
+  void Check(){
+
+    if (GetSize() > capacity_) {
+      std::cout << "Capacity exceeded \n";
+      exit(EXIT_FAILURE);
+    }
+
+    if (test_count_ > capacity_) {
+      std::cout << "Test entries exceed capacity \n";
+      exit(EXIT_FAILURE);
+    }
+
+  }
+
+  void Touch(const Key& key){
+
+    // check if key exists
+    auto node = index_.Find(key);
+    if(node == INVALID_SLOT || page_types_.Get(node) == PAGE_TYPE_TEST){
+      std::cout << "KEY NOT FOUND: " << key << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    references_.Set(node, 1);
+
+  }
+
+  Block Put(const Key& key, const Value& value){
+    Block victim;
+    victim_key_ = INVALID_KEY;
+    victim_value_ = INVALID_VALUE;
+
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT) {
+      // new block starts cold
+      Add(key, value, PAGE_TYPE_COLD);
+      cold_count_++;
+    }
+    else if (page_types_.Get(node) != PAGE_TYPE_TEST) {
+
+      // update previous value of element
+      nodes_[node].value = value;
+
+      // Touch element
+      references_.Set(node, 1);
+
+    }
+    else {
+      // re-referenced during its test period
+      if (cold_target_ < capacity_) {
+        cold_target_++;
+      }
+      test_count_--;
+      Remove(node);
+      Add(key, value, PAGE_TYPE_HOT);
+      hot_count_++;
+    }
+
+    // Run integrity checks
+    Check();
+
+    // return victim
+    victim.block_id = victim_key_;
+    victim.block_type = victim_value_;
+    return victim;
+  }
+
+  Value Get(const Key& key){
+
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT || page_types_.Get(node) == PAGE_TYPE_TEST) {
+      return INVALID_VALUE;
+    }
+
+    // Touch element
+    references_.Set(node, 1);
+
+    return nodes_[node].value;
+  }
+
+  void Erase(const Key& key){
+
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT) {
+      return;
+    }
+
+    switch(page_types_.Get(node)){
+      case PAGE_TYPE_HOT:
+        hot_count_--;
+        break;
+      case PAGE_TYPE_COLD:
+        cold_count_--;
+        break;
+      default:
+        // keep the history of non-resident blocks
+        return;
+    }
+
+    Remove(node);
+
+  }
+
+  size_t GetSize() const{
+    return hot_count_ + cold_count_;
+  }
+
+  size_t GetHotCount() const{
+    return hot_count_;
+  }
+
+  size_t GetTestCount() const{
+    return test_count_;
+  }
+
+  size_t GetColdTarget() const{
+    return cold_target_;
+  }
+
+  void Print() const{
+
+    std::cout << "OCCUPIED: " << (GetSize() * 100)/capacity_ << " %\n";
+
+    // resident blocks from the hot hand on
+    size_t block_itr = 0;
+    size_t print_block_count = 100;
+    auto node = hand_hot_;
+    for(size_t node_itr = 0; node_itr < ring_size_; node_itr++){
+      if(page_types_.Get(node) != PAGE_TYPE_TEST){
+        if(block_itr++ >= print_block_count){
+          break;
+        }
+        std::cout << nodes_[node].key << CleanStatus(nodes_[node].value, false) << " ";
+      }
+      node = nodes_[node].next;
+    }
+
+    if(print_block_count > 0) {
+      std::cout << "\n-------------------------------\n";
+    }
+
+  }
+
+ private:
+
+  enum PageType : uint8_t {
+    PAGE_TYPE_FREE = 0,
+    PAGE_TYPE_HOT = 1,
+    PAGE_TYPE_COLD = 2,
+    PAGE_TYPE_TEST = 3
+  };
+
+  struct Node {
+    Key key = Key();
+    Value value = Value();
+    uint32_t prev = INVALID_SLOT;
+    uint32_t next = INVALID_SLOT;
+  };
+
+  // Insert a block at the list head; makes room first. New cold blocks
+  // start their test period.
+  void Add(const Key& key, const Value& value, const PageType& page_type){
+    Evict();
+
+    auto node = free_list_.PopFront(nodes_);
+    nodes_[node].key = key;
+    nodes_[node].value = value;
+    page_types_.Set(node, page_type);
+    references_.Set(node, 0);
+    test_periods_.Set(node, page_type == PAGE_TYPE_COLD);
+    index_.Insert(key, node);
+
+    Link(node);
+  }
+
+  // Unlink a block from the clock and free it
+  void Remove(const uint32_t& node){
+    index_.Erase(nodes_[node].key);
+    page_types_.Set(node, PAGE_TYPE_FREE);
+
+    Unlink(node);
+
+    free_list_.PushFront(nodes_, node);
+  }
+
+  // Link a block at the list head, right behind HAND_hot, so that the
+  // hands reach it last
+  void Link(const uint32_t& node){
+    if(ring_size_ == 0){
+      nodes_[node].prev = node;
+      nodes_[node].next = node;
+      hand_hot_ = node;
+      hand_cold_ = node;
+      hand_test_ = node;
+    }
+    else {
+      auto prev = nodes_[hand_hot_].prev;
+      nodes_[node].prev = prev;
+      nodes_[node].next = hand_hot_;
+      nodes_[prev].next = node;
+      nodes_[hand_hot_].prev = node;
+    }
+    ring_size_++;
+  }
+
+  // Unlink a block from the clock, moving hands on it back by one
+  void Unlink(const uint32_t& node){
+    auto prev = nodes_[node].prev;
+    auto next = nodes_[node].next;
+    if(--ring_size_ == 0){
+      hand_hot_ = INVALID_SLOT;
+      hand_cold_ = INVALID_SLOT;
+      hand_test_ = INVALID_SLOT;
+    }
+    else {
+      if(hand_hot_ == node){
+        hand_hot_ = prev;
+      }
+      if(hand_cold_ == node){
+        hand_cold_ = prev;
+      }
+      if(hand_test_ == node){
+        hand_test_ = prev;
+      }
+      nodes_[prev].next = next;
+      nodes_[next].prev = prev;
+    }
+  }
+
+  void Evict(){
+    while(capacity_ <= hot_count_ + cold_count_){
+      RunHandCold();
+    }
+  }
+
+  // Move HAND_cold by one block, then let HAND_hot bring the hot blocks
+  // back within their target
+  void RunHandCold(){
+    StepHandCold();
+    while(capacity_ - cold_target_ < hot_count_){
+      StepHandHot();
+    }
+  }
+
+  // A hand that reaches the one ahead of it pushes it forward by one step
+  // (HAND_hot pushes HAND_test, which pushes HAND_cold)
+
+  void StepHandCold(){
+    auto node = hand_cold_;
+    if(page_types_.Get(node) == PAGE_TYPE_COLD){
+      if(references_.Get(node) == 1){
+        references_.Set(node, 0);
+        // re-referenced within its test period
+        if(test_periods_.Get(node) == 1){
+          page_types_.Set(node, PAGE_TYPE_HOT);
+          test_periods_.Set(node, 0);
+          cold_count_--;
+          hot_count_++;
+        }
+        // too late to be hot: start a new test period at the list head
+        else if(ring_size_ > 1){
+          test_periods_.Set(node, 1);
+          Unlink(node);
+          Link(node);
+        }
+      }
+      // One victim per Put; when pushed again while retiring test
+      // entries, the hand leaves further cold blocks for later
+      else if(victim_key_ == INVALID_KEY){
+        victim_key_ = nodes_[node].key;
+        victim_value_ = nodes_[node].value;
+        cold_count_--;
+        if(test_periods_.Get(node) == 0){
+          Remove(node);
+        }
+        else {
+          page_types_.Set(node, PAGE_TYPE_TEST);
+          test_count_++;
+          while(capacity_ < test_count_){
+            StepHandTest();
+          }
+        }
+      }
+    }
+    if(ring_size_ > 0){
+      hand_cold_ = nodes_[hand_cold_].next;
+    }
+  }
+
+  void StepHandHot(){
+    if(hand_hot_ == hand_test_){
+      StepHandTest();
+    }
+
+    auto node = hand_hot_;
+    if(page_types_.Get(node) == PAGE_TYPE_HOT){
+      if(references_.Get(node) == 1){
+        references_.Set(node, 0);
+      }
+      else {
+        page_types_.Set(node, PAGE_TYPE_COLD);
+        hot_count_--;
+        cold_count_++;
+      }
+    }
+    hand_hot_ = nodes_[hand_hot_].next;
+  }
+
+  void StepHandTest(){
+    if(hand_test_ == hand_cold_){
+      StepHandCold();
+    }
+
+    // A test period that ends without a re-reference shrinks the cold target
+    auto node = hand_test_;
+    auto page_type = page_types_.Get(node);
+    if(page_type == PAGE_TYPE_TEST){
+      Remove(node);
+      test_count_--;
+      ShrinkColdTarget();
+    }
+    else if(page_type == PAGE_TYPE_COLD && test_periods_.Get(node) == 1){
+      test_periods_.Set(node, 0);
+      ShrinkColdTarget();
+    }
+    if(ring_size_ > 0){
+      hand_test_ = nodes_[hand_test_].next;
+    }
+  }
+
+  void ShrinkColdTarget(){
+    if(cold_target_ > MIN_COLD_TARGET){
+      cold_target_--;
+    }
+  }
+
+  static const size_t MIN_COLD_TARGET = 1;
+
+  std::vector<Node> nodes_;
+
+  PackedArray<2> page_types_;
+
+  PackedArray<1> references_;
+
+  // resident cold blocks still in their test period
+  PackedArray<1> test_periods_;
+
+  KeyIndex<Key> index_;
+
+  NodeList free_list_;
+
+  // CLOCK
+
+  size_t ring_size_ = 0;
+
+  uint32_t hand_hot_ = INVALID_SLOT;
+
+  uint32_t hand_cold_ = INVALID_SLOT;
+
+  uint32_t hand_test_ = INVALID_SLOT;
+
+  // COUNTS
+
+  size_t hot_count_ = 0;
+
+  size_t cold_count_ = 0;
+
+  size_t test_count_ = 0;
+
+  // adaptive number of resident cold blocks
+  size_t cold_target_;
+
+  size_t capacity_;
+
+  // block evicted by the current Put
+  Key victim_key_ = INVALID_KEY;
+
+  Value victim_value_ = INVALID_VALUE;
+
+};
+
+}  // End machine namespace
@@ -2,23 +2,39 @@
 
 #pragma once
 
-#include <list>
-#include <unordered_map>
-#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
 
 #include "macros.h"
 #include "policy.h"
+#include "policy_index.h"
 
 namespace machine {
 
+// FIFO over a circular array of entries
+//
+// Blocks are appended at the tail of a ring and evicted from its head, and
+// the shared key index maps each key to its ring slot, so nothing is
+// allocated after construction. Erased blocks leave a hole that eviction
+// skips. The ring has twice the capacity, so when the tail catches up with
+// the head the live entries are compacted at most once per capacity
+// inserts.
 template <typename Key, typename Value>
 class FIFOCachePolicy : public ICachePolicy<Key, Value> {
  public:
 
   FIFOCachePolicy(const size_t& capacity,
                   UNUSED_ATTRIBUTE const double& clean_fraction)
- : capacity_(capacity){
-    // Nothing to do here!
+ : ring_(2 * capacity),
+   index_(capacity),
+   capacity_(capacity){
+
+    if(capacity_ == 0 || capacity_ >= INVALID_SLOT / 4){
+      std::cout << "Invalid FIFO capacity: " << capacity_ << "\n";
+      exit(EXIT_FAILURE);
+    }
+
   }
 
   ~FIFOCachePolicy() = default;
@@ -41,29 +57,39 @@ class FIFOCachePolicy : public ICachePolicy<Key, Value> {
     Key victim_key = INVALID_KEY;
     Value victim_value = INVALID_VALUE;
 
-    auto entry_location = cache_items_map.find(key);
-    if (entry_location == cache_items_map.end()) {
+    auto slot = index_.Find(key);
+    if (slot == INVALID_SLOT) {
       // add new element to the cache
 
       // check capacity
       if (GetSize() + 1 > capacity_) {
-        victim_key = fifo_queue.back();
-        victim_value = cache_items_map[victim_key];
+        SkipHoles();
+        victim_key = ring_[head_].key;
+        victim_value = ring_[head_].value;
         //std::cout << "Victim: " << victim_key << "\n";
 
         // evict victim
-        fifo_queue.pop_back();
-        cache_items_map.erase(victim_key);
+        Remove(head_);
+        SkipHoles();
+      }
+
+      if (used_ == ring_.size()) {
+        Compact();
       }
 
       // insert new element
-      fifo_queue.emplace_front(key);
-      cache_items_map[key] = value;
+      auto tail = Wrap(head_ + used_);
+      ring_[tail].key = key;
+      ring_[tail].value = value;
+      ring_[tail].live = true;
+      index_.Insert(key, tail);
+      used_++;
+      size_++;
     }
     else {
 
       // update previous value of element
-      cache_items_map[key] = value;
+      ring_[slot].value = value;
 
       // Touch element
       Touch(key);
@@ -81,33 +107,49 @@ class FIFOCachePolicy : public ICachePolicy<Key, Value> {
 
   Value Get(const Key& key){
 
-    auto elem_it = cache_items_map.find(key);
-    if (elem_it == cache_items_map.end()) {
+    auto slot = index_.Find(key);
+    if (slot == INVALID_SLOT) {
       return INVALID_VALUE;
     }
 
     // Touch element
     Touch(key);
 
-    return elem_it->second;
+    return ring_[slot].value;
+  }
+
+  void Erase(const Key& key){
+
+    auto slot = index_.Find(key);
+    if (slot == INVALID_SLOT) {
+      return;
+    }
+
+    Remove(slot);
+    SkipHoles();
+
   }
 
   size_t GetSize() const{
-    return cache_items_map.size();
+    return size_;
   }
 
   void Print() const{
 
-    auto current_size = cache_items_map.size();
-    std::cout << "OCCUPIED: " << (current_size * 100)/capacity_ << " %\n";
+    std::cout << "OCCUPIED: " << (size_ * 100)/capacity_ << " %\n";
 
+    // oldest first
     size_t block_itr = 0;
     size_t print_block_count = 100;
-    for(auto& cache_item : cache_items_map){
+    for(size_t used_itr = 0; used_itr < used_; used_itr++){
+      auto& entry = ring_[Wrap(head_ + used_itr)];
+      if(entry.live == false){
+        continue;
+      }
       if(block_itr++ >= print_block_count){
         break;
       }
-      std::cout << cache_item.first << CleanStatus(cache_item.second, false) << " ";
+      std::cout << entry.key << CleanStatus(entry.value, false) << " ";
     }
 
     if(print_block_count > 0) {
@@ -118,9 +160,60 @@ class FIFOCachePolicy : public ICachePolicy<Key, Value> {
 
  private:
 
-  std::list<Key> fifo_queue;
+  struct Entry {
+    Key key = Key();
+    Value value = Value();
+    // false for empty slots and holes left by Erase
+    bool live = false;
+  };
+
+  size_t Wrap(const size_t& position) const {
+    return (position < ring_.size()) ? position : position - ring_.size();
+  }
+
+  void Remove(const size_t& slot){
+    index_.Erase(ring_[slot].key);
+    ring_[slot].live = false;
+    size_--;
+  }
+
+  // Advance the head to the oldest live entry
+  void SkipHoles(){
+    while(used_ > 0 && ring_[head_].live == false){
+      head_ = Wrap(head_ + 1);
+      used_--;
+    }
+  }
+
+  // Close the holes, keeping insertion order
+  void Compact(){
+    size_t live_count = 0;
+    for(size_t used_itr = 0; used_itr < used_; used_itr++){
+      auto from = Wrap(head_ + used_itr);
+      if(ring_[from].live == false){
+        continue;
+      }
+      auto to = Wrap(head_ + live_count++);
+      if(from != to){
+        ring_[to] = ring_[from];
+        ring_[from].live = false;
+        index_.Insert(ring_[to].key, to);
+      }
+    }
+    used_ = live_count;
+  }
+
+  std::vector<Entry> ring_;
+
+  KeyIndex<Key> index_;
+
+  // oldest slot
+  size_t head_ = 0;
+
+  // slots from the head to the tail, including holes
+  size_t used_ = 0;
 
-  std::unordered_map<Key, Value> cache_items_map;
+  size_t size_ = 0;
 
   size_t capacity_;
 
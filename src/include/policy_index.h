@@ -0,0 +1,254 @@
+// POLICY INDEX HEADER
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace machine {
+
+// no node in a pool / empty index slot
+const uint32_t INVALID_SLOT = UINT32_MAX;
+
+// Maps keys to node slots of a policy's node pool
+//
+// Open addressing with linear probing, kept at most half full. Deletion
+// shifts later entries of the probe sequence back instead of leaving
+// tombstones, so lookups stay short under insert/erase churn and the table
+// never allocates after construction.
+template <typename Key>
+class KeyIndex {
+ public:
+
+  KeyIndex(const size_t& capacity = 1){
+    size_t slot_count = 2;
+    shift_ = 63;
+    while(slot_count < 2 * capacity){
+      slot_count *= 2;
+      shift_--;
+    }
+    slots_.resize(slot_count);
+    mask_ = slot_count - 1;
+  }
+
+  // Node of the key, else INVALID_SLOT
+  uint32_t Find(const Key& key) const {
+    return slots_[FindSlot(key)].node;
+  }
+
+  // Adds the key, or points it to a new node if present
+  void Insert(const Key& key, const uint32_t& node){
+    auto slot = FindSlot(key);
+    slots_[slot].key = key;
+    slots_[slot].node = node;
+  }
+
+  void Erase(const Key& key){
+    auto slot = FindSlot(key);
+    if(slots_[slot].node == INVALID_SLOT){
+      return;
+    }
+
+    auto next_slot = (slot + 1) & mask_;
+    while(slots_[next_slot].node != INVALID_SLOT){
+      auto home_slot = GetHomeSlot(slots_[next_slot].key);
+      if(((next_slot - home_slot) & mask_) >= ((next_slot - slot) & mask_)){
+        slots_[slot] = slots_[next_slot];
+        slot = next_slot;
+      }
+      next_slot = (next_slot + 1) & mask_;
+    }
+    slots_[slot].node = INVALID_SLOT;
+  }
+
+ private:
+
+  struct Slot {
+    Key key = Key();
+    uint32_t node = INVALID_SLOT;
+  };
+
+  // Fibonacci hashing spreads sequential keys
+  size_t GetHomeSlot(const Key& key) const {
+    uint64_t hash = std::hash<Key>()(key);
+    return (hash * 0x9E3779B97F4A7C15ULL) >> shift_;
+  }
+
+  // Slot holding the key, else the empty slot ending its probe sequence
+  size_t FindSlot(const Key& key) const {
+    auto slot = GetHomeSlot(key);
+    while(slots_[slot].node != INVALID_SLOT && slots_[slot].key != key){
+      slot = (slot + 1) & mask_;
+    }
+    return slot;
+  }
+
+  std::vector<Slot> slots_;
+
+  size_t mask_;
+
+  size_t shift_;
+
+};
+
+// Doubly-linked list threaded through a node pool by 32-bit indices
+//
+// Nodes need prev and next members. The list only holds indices, so it
+// stays valid when the policy (and its pool) is copied.
+class NodeList {
+ public:
+
+  template <typename Node>
+  void PushFront(std::vector<Node>& nodes, const uint32_t& node){
+    nodes[node].prev = INVALID_SLOT;
+    nodes[node].next = head_;
+    if(head_ != INVALID_SLOT){
+      nodes[head_].prev = node;
+    }
+    else {
+      tail_ = node;
+    }
+    head_ = node;
+    size_++;
+  }
+
+  template <typename Node>
+  void PushBack(std::vector<Node>& nodes, const uint32_t& node){
+    if(tail_ == INVALID_SLOT){
+      PushFront(nodes, node);
+      return;
+    }
+    InsertAfter(nodes, tail_, node);
+  }
+
+  // Link node right after position, which must be on this list
+  template <typename Node>
+  void InsertAfter(std::vector<Node>& nodes,
+                   const uint32_t& position,
+                   const uint32_t& node){
+    auto next = nodes[position].next;
+    nodes[node].prev = position;
+    nodes[node].next = next;
+    nodes[position].next = node;
+    if(next != INVALID_SLOT){
+      nodes[next].prev = node;
+    }
+    else {
+      tail_ = node;
+    }
+    size_++;
+  }
+
+  template <typename Node>
+  void Unlink(std::vector<Node>& nodes, const uint32_t& node){
+    auto prev = nodes[node].prev;
+    auto next = nodes[node].next;
+    if(prev != INVALID_SLOT){
+      nodes[prev].next = next;
+    }
+    else {
+      head_ = next;
+    }
+    if(next != INVALID_SLOT){
+      nodes[next].prev = prev;
+    }
+    else {
+      tail_ = prev;
+    }
+    size_--;
+  }
+
+  template <typename Node>
+  void MoveToFront(std::vector<Node>& nodes, const uint32_t& node){
+    if(node == head_){
+      return;
+    }
+    Unlink(nodes, node);
+    PushFront(nodes, node);
+  }
+
+  template <typename Node>
+  uint32_t PopFront(std::vector<Node>& nodes){
+    auto node = head_;
+    Unlink(nodes, node);
+    return node;
+  }
+
+  template <typename Node>
+  uint32_t PopBack(std::vector<Node>& nodes){
+    auto node = tail_;
+    Unlink(nodes, node);
+    return node;
+  }
+
+  uint32_t GetFront() const {
+    return head_;
+  }
+
+  uint32_t GetBack() const {
+    return tail_;
+  }
+
+  size_t GetSize() const {
+    return size_;
+  }
+
+  bool IsEmpty() const {
+    return size_ == 0;
+  }
+
+ private:
+
+  uint32_t head_ = INVALID_SLOT;
+
+  uint32_t tail_ = INVALID_SLOT;
+
+  size_t size_ = 0;
+
+};
+
+// Fixed-size array of BITS-wide fields packed into 64-bit words, for
+// per-block reference bits, usage counts, and states
+template <unsigned BITS>
+class PackedArray {
+  static_assert(BITS > 0 && 64 % BITS == 0, "fields must not straddle words");
+
+ public:
+
+  PackedArray(const size_t& size = 0)
+  : words_((size * BITS + 63) / 64, 0){
+  }
+
+  uint8_t Get(const size_t& position) const {
+    auto bit = position * BITS;
+    return (words_[bit / 64] >> (bit % 64)) & MASK;
+  }
+
+  void Set(const size_t& position, const uint8_t& value){
+    auto bit = position * BITS;
+    auto& word = words_[bit / 64];
+    word &= ~(MASK << (bit % 64));
+    word |= (static_cast<uint64_t>(value) & MASK) << (bit % 64);
+  }
+
+  static const uint64_t MASK = (1ULL << BITS) - 1;
+
+ private:
+
+  std::vector<uint64_t> words_;
+
+};
+
+template <unsigned BITS>
+const uint64_t PackedArray<BITS>::MASK;
+
+// Put every node of a fresh pool on the free list
+template <typename Node>
+void InitializeFreeList(std::vector<Node>& nodes, NodeList& free_list){
+  for(size_t node_itr = nodes.size(); node_itr > 0; node_itr--){
+    free_list.PushFront(nodes, node_itr - 1);
+  }
+}
+
+}  // End machine namespace
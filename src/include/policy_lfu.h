@@ -2,25 +2,54 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
-#include <unordered_map>
-#include <map>
+#include <cstdint>
 #include <iostream>
+#include <vector>
 
 #include "macros.h"
 #include "policy.h"
+#include "policy_index.h"
 
 namespace machine {
 
+// halve LFU frequencies every (lfu_aging_factor * capacity) accesses
+// (0: never age)
+extern size_t lfu_aging_factor;
+
+// LFU over frequency buckets
+//
+// Buckets hold the blocks of one frequency in an intrusive list and are
+// themselves kept in a list ordered by frequency, so a hit moves its block
+// to the next bucket and an eviction takes the first block of the first
+// bucket, both in O(1). Ties are broken by recency: a block that reaches a
+// frequency later is evicted later, except that new blocks are evicted
+// before older blocks that are still at frequency one.
+//
+// With aging, all frequencies are periodically halved so that blocks that
+// were only hot in the past (e.g. during warm-up) can be evicted again.
+// Halving walks every block once, which is O(1) amortized over the period.
 template <typename Key, typename Value>
 class LFUCachePolicy : public ICachePolicy<Key, Value> {
  public:
-  using lfu_iterator = typename std::multimap<std::size_t, Key>::iterator;
 
   LFUCachePolicy(const size_t& capacity,
                  UNUSED_ATTRIBUTE const double& clean_fraction)
-  : capacity_(capacity){
-    // Nothing to do here!
+  : nodes_(capacity),
+    buckets_(capacity + 1),
+    index_(capacity),
+    aging_period_(lfu_aging_factor * capacity),
+    capacity_(capacity){
+
+    if(capacity_ == 0 || capacity_ >= INVALID_SLOT / 2){
+      std::cout << "Invalid LFU capacity: " << capacity_ << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    InitializeFreeList(nodes_, free_list_);
+    InitializeFreeList(buckets_, free_buckets_);
+
   }
 
   ~LFUCachePolicy() override = default;
@@ -37,20 +66,13 @@ class LFUCachePolicy : public ICachePolicy<Key, Value> {
   void Touch(const Key& key){
 
     // check if key exists
-    if(lfu_storage.count(key) == 0){
+    auto node = index_.Find(key);
+    if(node == INVALID_SLOT){
       std::cout << "KEY NOT FOUND: " << key << "\n";
       exit(EXIT_FAILURE);
     }
 
-    // get the previous frequency value of a key
-    auto elem_for_update = lfu_storage[key];
-    auto updated_elem = std::make_pair(elem_for_update->first + 1,
-                                       elem_for_update->second);
-
-    // update the previous value
-    frequency_storage.erase(elem_for_update);
-    lfu_storage[key] = frequency_storage.emplace_hint(frequency_storage.cend(),
-                                                      std::move(updated_elem));
+    TouchNode(node);
 
   }
 
@@ -59,40 +81,50 @@ class LFUCachePolicy : public ICachePolicy<Key, Value> {
     Key victim_key = INVALID_KEY;
     Value victim_value = INVALID_VALUE;
 
-    auto entry_location = cache_items_map.find(key);
-    if (entry_location == cache_items_map.end()) {
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT) {
       // add new element to the cache
 
       // check capacity
       if (GetSize() + 1 > capacity_) {
-        victim_key = frequency_storage.cbegin()->second;
-        victim_value = cache_items_map[victim_key];
-        //std::cout << "Victim: " << victim_key << "\n";
+        auto victim_node = buckets_[bucket_list_.GetFront()].entries.GetFront();
+        victim_key = nodes_[victim_node].key;
+        victim_value = nodes_[victim_node].value;
 
         // evict victim
-        frequency_storage.erase(lfu_storage[victim_key]);
-        lfu_storage.erase(victim_key);
-        cache_items_map.erase(victim_key);
+        Remove(victim_node);
       }
 
       // insert new element
       constexpr std::size_t INIT_FREQUENCY = 1;
-      lfu_storage[key] = frequency_storage.emplace_hint(frequency_storage.cbegin(),
-                                                        INIT_FREQUENCY,
-                                                        key);
-      cache_items_map[key] = value;
+      auto bucket = bucket_list_.GetFront();
+      if(bucket == INVALID_SLOT || buckets_[bucket].frequency != INIT_FREQUENCY){
+        bucket = free_buckets_.PopFront(buckets_);
+        buckets_[bucket].frequency = INIT_FREQUENCY;
+        bucket_list_.PushFront(buckets_, bucket);
+      }
+
+      node = free_list_.PopFront(nodes_);
+      nodes_[node].key = key;
+      nodes_[node].value = value;
+      nodes_[node].bucket = bucket;
+      buckets_[bucket].entries.PushFront(nodes_, node);
+      index_.Insert(key, node);
+      size_++;
 
     }
     else {
 
       // update previous value of element
-      cache_items_map[key] = value;
+      nodes_[node].value = value;
 
       // Touch element
-      Touch(key);
+      TouchNode(node);
 
     }
 
+    Age();
+
     // Run integrity checks
     Check();
 
@@ -104,33 +136,58 @@ class LFUCachePolicy : public ICachePolicy<Key, Value> {
 
   Value Get(const Key& key){
 
-    auto elem_it = cache_items_map.find(key);
-    if (elem_it == cache_items_map.end()) {
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT) {
       return INVALID_VALUE;
     }
 
     // Touch element
-    Touch(key);
+    TouchNode(node);
+    Age();
+
+    return nodes_[node].value;
+  }
+
+  void Erase(const Key& key){
+
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT) {
+      return;
+    }
+
+    Remove(node);
 
-    return elem_it->second;
   }
 
   size_t GetSize() const{
-    return cache_items_map.size();
+    return size_;
+  }
+
+  // Frequency of a cached key (0 if absent)
+  size_t GetFrequency(const Key& key) const{
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT) {
+      return 0;
+    }
+    return buckets_[nodes_[node].bucket].frequency;
   }
 
   void Print() const{
 
-    auto current_size = cache_items_map.size();
-    std::cout << "OCCUPIED: " << (current_size * 100)/capacity_ << " %\n";
+    std::cout << "OCCUPIED: " << (size_ * 100)/capacity_ << " %\n";
 
+    // least frequently used first
     size_t block_itr = 0;
     size_t print_block_count = 100;
-    for(auto& cache_item : cache_items_map){
-      if(block_itr++ >= print_block_count){
-        break;
+    for(auto bucket = bucket_list_.GetFront(); bucket != INVALID_SLOT;
+        bucket = buckets_[bucket].next){
+      auto& entries = buckets_[bucket].entries;
+      for(auto node = entries.GetFront(); node != INVALID_SLOT; node = nodes_[node].next){
+        if(block_itr++ >= print_block_count){
+          break;
+        }
+        std::cout << nodes_[node].key << CleanStatus(nodes_[node].value, false) << " ";
       }
-      std::cout << cache_item.first << CleanStatus(cache_item.second, false) << " ";
     }
 
     if(print_block_count > 0) {
@@ -141,11 +198,108 @@ class LFUCachePolicy : public ICachePolicy<Key, Value> {
 
  private:
 
-  std::multimap<std::size_t, Key> frequency_storage;
+  struct Node {
+    Key key = Key();
+    Value value = Value();
+    uint32_t prev = INVALID_SLOT;
+    uint32_t next = INVALID_SLOT;
+    uint32_t bucket = INVALID_SLOT;
+  };
+
+  struct Bucket {
+    size_t frequency = 0;
+    // evicted from the front
+    NodeList entries;
+    uint32_t prev = INVALID_SLOT;
+    uint32_t next = INVALID_SLOT;
+  };
+
+  // Move a block to the bucket of the next frequency
+  void TouchNode(const uint32_t& node){
+    auto bucket = nodes_[node].bucket;
+    auto frequency = buckets_[bucket].frequency + 1;
+
+    auto next_bucket = buckets_[bucket].next;
+    if(next_bucket == INVALID_SLOT || buckets_[next_bucket].frequency != frequency){
+      next_bucket = free_buckets_.PopFront(buckets_);
+      buckets_[next_bucket].frequency = frequency;
+      bucket_list_.InsertAfter(buckets_, bucket, next_bucket);
+    }
+
+    buckets_[bucket].entries.Unlink(nodes_, node);
+    buckets_[next_bucket].entries.PushBack(nodes_, node);
+    nodes_[node].bucket = next_bucket;
+    ReleaseBucket(bucket);
+  }
+
+  void Remove(const uint32_t& node){
+    auto bucket = nodes_[node].bucket;
+    buckets_[bucket].entries.Unlink(nodes_, node);
+    ReleaseBucket(bucket);
+
+    index_.Erase(nodes_[node].key);
+    free_list_.PushFront(nodes_, node);
+    size_--;
+  }
+
+  void ReleaseBucket(const uint32_t& bucket){
+    if(buckets_[bucket].entries.IsEmpty() == false){
+      return;
+    }
+    bucket_list_.Unlink(buckets_, bucket);
+    free_buckets_.PushFront(buckets_, bucket);
+  }
+
+  // Halve all frequencies once per aging period
+  void Age(){
+    if(aging_period_ == 0 || ++access_count_ < aging_period_){
+      return;
+    }
+    access_count_ = 0;
+
+    auto bucket = bucket_list_.GetFront();
+    while(bucket != INVALID_SLOT){
+      auto next_bucket = buckets_[bucket].next;
+      auto frequency = std::max<size_t>(buckets_[bucket].frequency / 2, 1);
+      buckets_[bucket].frequency = frequency;
+
+      // Merge into the previous bucket if it now has the same frequency,
+      // keeping the blocks of lower original frequency first
+      auto prev_bucket = buckets_[bucket].prev;
+      if(prev_bucket != INVALID_SLOT && buckets_[prev_bucket].frequency == frequency){
+        auto& entries = buckets_[bucket].entries;
+        while(entries.IsEmpty() == false){
+          auto node = entries.PopFront(nodes_);
+          buckets_[prev_bucket].entries.PushBack(nodes_, node);
+          nodes_[node].bucket = prev_bucket;
+        }
+        ReleaseBucket(bucket);
+      }
+
+      bucket = next_bucket;
+    }
+  }
+
+  std::vector<Node> nodes_;
+
+  // one per distinct frequency, plus one while a block moves up
+  std::vector<Bucket> buckets_;
+
+  KeyIndex<Key> index_;
+
+  // ascending frequency
+  NodeList bucket_list_;
+
+  NodeList free_buckets_;
+
+  NodeList free_list_;
+
+  // accesses between halvings (0: no aging)
+  size_t aging_period_;
 
-  std::unordered_map<Key, lfu_iterator> lfu_storage;
+  size_t access_count_ = 0;
 
-  std::unordered_map<Key, Value> cache_items_map;
+  size_t size_ = 0;
 
   size_t capacity_;
 
@@ -0,0 +1,378 @@
+// LIRS HEADER
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "macros.h"
+#include "policy.h"
+#include "policy_index.h"
+
+namespace machine {
+
+// share of the LIRS capacity holding resident HIR blocks
+extern double lirs_hir_ratio;
+
+// LIRS (Jiang and Zhang, SIGMETRICS 2002)
+//
+// Blocks are ranked by reuse distance rather than recency. LIR blocks (low
+// inter-reference recency) fill most of the cache and are never evicted
+// directly; a small share holds resident HIR blocks in the FIFO queue Q,
+// which is where victims come from. The recency stack S holds LIR blocks
+// and recently seen HIR blocks, resident or not, and always ends in an LIR
+// block. A HIR block referenced again while still in S has a shorter reuse
+// distance than the oldest LIR block, so the two swap status. Non-resident
+// entries are capped at the capacity, dropping the oldest first.
+//
+// S and Q (or the list of non-resident entries) are threaded through the
+// same node pool with separate links, so every operation is O(1) amortized.
+template <typename Key, typename Value>
+class LIRSCachePolicy : public ICachePolicy<Key, Value> {
+ public:
+
+  LIRSCachePolicy(const size_t& capacity,
+                  UNUSED_ATTRIBUTE const double& clean_fraction)
+  : nodes_(2 * capacity),
+    stack_links_(2 * capacity),
+    queue_links_(2 * capacity),
+    index_(2 * capacity),
+    capacity_(capacity){
+
+    if(capacity_ == 0 || capacity_ >= INVALID_SLOT / 4){
+      std::cout << "Invalid LIRS capacity: " << capacity_ << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    // at least one resident HIR block, unless that is the whole cache
+    size_t hir_capacity = lirs_hir_ratio * capacity_;
+    hir_capacity = std::max<size_t>(hir_capacity, 1);
+    lir_capacity_ = capacity_ - std::min(hir_capacity, capacity_);
+    if(lir_capacity_ == 0 && capacity_ > 1){
+      lir_capacity_ = 1;
+    }
+
+    InitializeFreeList(queue_links_, free_list_);
+
+  }
+
+  ~LIRSCachePolicy() = default;
+
+  void Check(){
+
+    if (GetSize() > capacity_) {
+      std::cout << "Capacity exceeded \n";
+      exit(EXIT_FAILURE);
+    }
+
+    if (lir_count_ > lir_capacity_) {
+      std::cout << "LIR blocks exceed their capacity \n";
+      exit(EXIT_FAILURE);
+    }
+
+    if (nonresident_list_.GetSize() > capacity_) {
+      std::cout << "Non-resident entries exceed capacity \n";
+      exit(EXIT_FAILURE);
+    }
+
+  }
+
+  void Touch(const Key& key){
+
+    // check if key exists
+    auto node = index_.Find(key);
+    if(node == INVALID_SLOT || nodes_[node].status == STATUS_NONRESIDENT){
+      std::cout << "KEY NOT FOUND: " << key << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    TouchNode(node);
+
+  }
+
+  Block Put(const Key& key, const Value& value){
+    Block victim;
+    victim_key_ = INVALID_KEY;
+    victim_value_ = INVALID_VALUE;
+
+    auto node = index_.Find(key);
+    auto status = (node == INVALID_SLOT) ? STATUS_NONE : nodes_[node].status;
+
+    if (status == STATUS_LIR || status == STATUS_HIR) {
+      TouchNode(node);
+    }
+    else {
+      if (status == STATUS_NONRESIDENT) {
+        // keep it out of reach of the non-resident cap while evicting
+        nonresident_list_.Unlink(queue_links_, node);
+      }
+
+      if (GetSize() + 1 > capacity_) {
+        Evict();
+      }
+
+      if (status == STATUS_NONE) {
+        node = free_list_.PopFront(queue_links_);
+        nodes_[node].key = key;
+        nodes_[node].in_stack = false;
+        index_.Insert(key, node);
+      }
+
+      // a non-resident block in S was re-referenced within the reuse
+      // distance of the oldest LIR block
+      if (status == STATUS_NONRESIDENT || lir_count_ < lir_capacity_) {
+        MakeLIR(node);
+      }
+      else {
+        nodes_[node].status = STATUS_HIR;
+        PushOnStack(node);
+        hir_list_.PushBack(queue_links_, node);
+        Prune();
+      }
+    }
+
+    // update value of element
+    nodes_[node].value = value;
+
+    // Run integrity checks
+    Check();
+
+    // return victim
+    victim.block_id = victim_key_;
+    victim.block_type = victim_value_;
+    return victim;
+  }
+
+  Value Get(const Key& key){
+
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT || nodes_[node].status == STATUS_NONRESIDENT) {
+      return INVALID_VALUE;
+    }
+
+    // Touch element
+    TouchNode(node);
+
+    return nodes_[node].value;
+  }
+
+  void Erase(const Key& key){
+
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT) {
+      return;
+    }
+
+    auto status = nodes_[node].status;
+    if(status == STATUS_LIR){
+      lir_count_--;
+    }
+    else if(status == STATUS_HIR){
+      hir_list_.Unlink(queue_links_, node);
+    }
+    else {
+      // keep the history of non-resident blocks
+      return;
+    }
+
+    if(nodes_[node].in_stack){
+      stack_.Unlink(stack_links_, node);
+    }
+    Forget(node);
+    Prune();
+
+  }
+
+  size_t GetSize() const{
+    return lir_count_ + hir_list_.GetSize();
+  }
+
+  size_t GetLIRCount() const{
+    return lir_count_;
+  }
+
+  size_t GetNonResidentCount() const{
+    return nonresident_list_.GetSize();
+  }
+
+  void Print() const{
+
+    std::cout << "OCCUPIED: " << (GetSize() * 100)/capacity_ << " %\n";
+
+    // LIR blocks from the top of S, then resident HIR blocks
+    size_t block_itr = 0;
+    size_t print_block_count = 100;
+    for(auto node = stack_.GetFront(); node != INVALID_SLOT;
+        node = stack_links_[node].next){
+      if(nodes_[node].status != STATUS_LIR){
+        continue;
+      }
+      if(block_itr++ >= print_block_count){
+        break;
+      }
+      std::cout << nodes_[node].key << CleanStatus(nodes_[node].value, false) << " ";
+    }
+    for(auto node = hir_list_.GetFront(); node != INVALID_SLOT;
+        node = queue_links_[node].next){
+      if(block_itr++ >= print_block_count){
+        break;
+      }
+      std::cout << nodes_[node].key << CleanStatus(nodes_[node].value, false) << " ";
+    }
+
+    if(print_block_count > 0) {
+      std::cout << "\n-------------------------------\n";
+    }
+
+  }
+
+ private:
+
+  enum Status : uint8_t {
+    STATUS_NONE = 0,
+    STATUS_LIR = 1,
+    STATUS_HIR = 2,
+    STATUS_NONRESIDENT = 3
+  };
+
+  struct Node {
+    Key key = Key();
+    Value value = Value();
+    Status status = STATUS_NONE;
+    bool in_stack = false;
+  };
+
+  struct Link {
+    uint32_t prev = INVALID_SLOT;
+    uint32_t next = INVALID_SLOT;
+  };
+
+  // Move a block to the top of S
+  void PushOnStack(const uint32_t& node){
+    if(nodes_[node].in_stack){
+      stack_.MoveToFront(stack_links_, node);
+    }
+    else {
+      stack_.PushFront(stack_links_, node);
+      nodes_[node].in_stack = true;
+    }
+  }
+
+  // Hit on a resident block
+  void TouchNode(const uint32_t& node){
+    if(nodes_[node].status == STATUS_LIR){
+      auto was_bottom = (stack_.GetBack() == node);
+      stack_.MoveToFront(stack_links_, node);
+      if(was_bottom){
+        Prune();
+      }
+    }
+    else if(nodes_[node].in_stack){
+      hir_list_.Unlink(queue_links_, node);
+      MakeLIR(node);
+    }
+    else {
+      PushOnStack(node);
+      hir_list_.Unlink(queue_links_, node);
+      hir_list_.PushBack(queue_links_, node);
+      Prune();
+    }
+  }
+
+  // Turn a block that is not on Q into an LIR block on top of S, demoting
+  // the oldest LIR blocks if there are now too many
+  void MakeLIR(const uint32_t& node){
+    nodes_[node].status = STATUS_LIR;
+    lir_count_++;
+    PushOnStack(node);
+    Prune();
+
+    while(lir_count_ > lir_capacity_){
+      auto bottom = stack_.PopBack(stack_links_);
+      nodes_[bottom].in_stack = false;
+      nodes_[bottom].status = STATUS_HIR;
+      lir_count_--;
+      hir_list_.PushBack(queue_links_, bottom);
+      Prune();
+    }
+  }
+
+  // Pop HIR entries off the bottom of S until it ends in an LIR block (S
+  // empties while there are none)
+  void Prune(){
+    while(stack_.IsEmpty() == false &&
+          nodes_[stack_.GetBack()].status != STATUS_LIR){
+      auto bottom = stack_.PopBack(stack_links_);
+      nodes_[bottom].in_stack = false;
+      if(nodes_[bottom].status == STATUS_NONRESIDENT){
+        nonresident_list_.Unlink(queue_links_, bottom);
+        Forget(bottom);
+      }
+    }
+  }
+
+  // Evict the front of Q; it stays in S as a non-resident entry if there
+  void Evict(){
+    auto node = hir_list_.PopFront(queue_links_);
+    victim_key_ = nodes_[node].key;
+    victim_value_ = nodes_[node].value;
+
+    if(nodes_[node].in_stack == false){
+      Forget(node);
+      return;
+    }
+
+    nodes_[node].status = STATUS_NONRESIDENT;
+    nonresident_list_.PushBack(queue_links_, node);
+    if(nonresident_list_.GetSize() > capacity_){
+      auto oldest = nonresident_list_.PopFront(queue_links_);
+      stack_.Unlink(stack_links_, oldest);
+      Forget(oldest);
+    }
+  }
+
+  // Drop an unlinked node from the index and the pool
+  void Forget(const uint32_t& node){
+    index_.Erase(nodes_[node].key);
+    nodes_[node].status = STATUS_NONE;
+    nodes_[node].in_stack = false;
+    free_list_.PushFront(queue_links_, node);
+  }
+
+  std::vector<Node> nodes_;
+
+  // links on S
+  std::vector<Link> stack_links_;
+
+  // links on Q, the non-resident list, or the free list
+  std::vector<Link> queue_links_;
+
+  KeyIndex<Key> index_;
+
+  // recency stack S (top at the front)
+  NodeList stack_;
+
+  // resident HIR blocks Q (evicted from the front)
+  NodeList hir_list_;
+
+  // non-resident HIR entries on S (oldest at the front)
+  NodeList nonresident_list_;
+
+  NodeList free_list_;
+
+  size_t lir_count_ = 0;
+
+  size_t lir_capacity_;
+
+  size_t capacity_;
+
+  // block evicted by the current Put
+  Key victim_key_ = INVALID_KEY;
+
+  Value victim_value_ = INVALID_VALUE;
+
+};
+
+}  // End machine namespace
@@ -2,23 +2,37 @@
 
 #pragma once
 
-#include <list>
-#include <unordered_map>
+#include <iostream>
+#include <vector>
 
 #include "macros.h"
 #include "policy.h"
+#include "policy_index.h"
 
 namespace machine {
 
+// LRU over a pool of intrusive nodes
+//
+// Nodes live in one array sized to the capacity and are linked by 32-bit
+// indices, so Put/Get/Erase never allocate. A hit costs one index probe
+// sequence and one node access.
 template <typename Key, typename Value>
 class LRUCachePolicy : public ICachePolicy<Key, Value> {
  public:
-  using lru_iterator = typename std::list<Key>::iterator;
 
   LRUCachePolicy(const size_t& capacity,
                  UNUSED_ATTRIBUTE const double& clean_fraction)
-  : capacity_(capacity){
-    // Nothing to do here!
+  : nodes_(capacity),
+    index_(capacity),
+    capacity_(capacity){
+
+    if(capacity_ == 0 || capacity_ >= INVALID_SLOT / 2){
+      std::cout << "Invalid LRU capacity: " << capacity_ << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    InitializeFreeList(nodes_, free_list_);
+
   }
 
   ~LRUCachePolicy() = default;
@@ -35,51 +49,50 @@ class LRUCachePolicy : public ICachePolicy<Key, Value> {
   void Touch(const Key& key) {
 
     // check if key exists
-    if(key_finder.count(key) == 0){
+    auto node = index_.Find(key);
+    if(node == INVALID_SLOT){
       std::cout << "KEY NOT FOUND: " << key << "\n";
       exit(EXIT_FAILURE);
     }
 
-    // move the touched element at the beginning of the lru_queue
-    lru_queue.erase(key_finder[key]);
-    lru_queue.emplace_front(key);
-    key_finder[key] = lru_queue.begin();
+    lru_queue_.MoveToFront(nodes_, node);
 
   }
 
   Block Put(const Key& key, const Value& value){
     Block victim;
     Key victim_key = INVALID_KEY;
-    Value victim_value = INVALID_KEY;
+    Value victim_value = INVALID_VALUE;
 
-    auto entry_location = cache_items_map.find(key);
-    if (entry_location == cache_items_map.end()) {
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT) {
       // add new element to the cache
 
       // check capacity
       if (GetSize() + 1 > capacity_) {
-        victim_key = lru_queue.back();
-        victim_value = cache_items_map[victim_key];
-        //std::cout << "Victim: " << victim_key << "\n";
+        auto victim_node = lru_queue_.PopBack(nodes_);
+        victim_key = nodes_[victim_node].key;
+        victim_value = nodes_[victim_node].value;
 
         // evict victim
-        key_finder.erase(victim_key);
-        lru_queue.pop_back();
-        cache_items_map.erase(victim_key);
+        index_.Erase(victim_key);
+        free_list_.PushFront(nodes_, victim_node);
       }
 
       // insert new element
-      lru_queue.emplace_front(key);
-      key_finder[key] = lru_queue.begin();
-      cache_items_map[key] = value;
+      node = free_list_.PopFront(nodes_);
+      nodes_[node].key = key;
+      nodes_[node].value = value;
+      lru_queue_.PushFront(nodes_, node);
+      index_.Insert(key, node);
     }
     else {
 
       // update previous value of element
-      cache_items_map[key] = value;
+      nodes_[node].value = value;
 
       // Touch element
-      Touch(key);
+      lru_queue_.MoveToFront(nodes_, node);
 
     }
 
@@ -94,33 +107,46 @@ class LRUCachePolicy : public ICachePolicy<Key, Value> {
 
   Value Get(const Key& key){
 
-    auto elem_it = cache_items_map.find(key);
-    if (elem_it == cache_items_map.end()) {
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT) {
       return INVALID_VALUE;
     }
 
     // Touch element
-    Touch(key);
+    lru_queue_.MoveToFront(nodes_, node);
+
+    return nodes_[node].value;
+  }
+
+  void Erase(const Key& key){
+
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT) {
+      return;
+    }
+
+    index_.Erase(key);
+    lru_queue_.Unlink(nodes_, node);
+    free_list_.PushFront(nodes_, node);
 
-    return elem_it->second;
   }
 
   size_t GetSize() const{
-    return cache_items_map.size();
+    return lru_queue_.GetSize();
   }
 
   void Print() const{
 
-    auto current_size = cache_items_map.size();
-    std::cout << "OCCUPIED: " << (current_size * 100)/capacity_ << " %\n";
+    std::cout << "OCCUPIED: " << (GetSize() * 100)/capacity_ << " %\n";
 
+    // most recently used first
     size_t block_itr = 0;
     size_t print_block_count = 100;
-    for(auto& cache_item : cache_items_map){
+    for(auto node = lru_queue_.GetFront(); node != INVALID_SLOT; node = nodes_[node].next){
       if(block_itr++ >= print_block_count){
         break;
       }
-      std::cout << cache_item.first << CleanStatus(cache_item.second, false) << " ";
+      std::cout << nodes_[node].key << CleanStatus(nodes_[node].value, false) << " ";
     }
 
     if(print_block_count > 0) {
@@ -131,11 +157,21 @@ class LRUCachePolicy : public ICachePolicy<Key, Value> {
 
  private:
 
-  std::list<Key> lru_queue;
+  struct Node {
+    Key key = Key();
+    Value value = Value();
+    uint32_t prev = INVALID_SLOT;
+    uint32_t next = INVALID_SLOT;
+  };
+
+  std::vector<Node> nodes_;
+
+  KeyIndex<Key> index_;
 
-  std::unordered_map<Key, lru_iterator> key_finder;
+  // most recently used first
+  NodeList lru_queue_;
 
-  std::unordered_map<Key, Value> cache_items_map;
+  NodeList free_list_;
 
   size_t capacity_;
 
@@ -0,0 +1,274 @@
+// 2Q HEADER
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "macros.h"
+#include "policy.h"
+#include "policy_index.h"
+
+namespace machine {
+
+// size of A1in and A1out as fractions of the 2Q capacity
+extern double two_q_in_ratio;
+
+extern double two_q_out_ratio;
+
+// 2Q (Johnson and Shasha, VLDB 1994)
+//
+// New blocks enter A1in, a FIFO that a scan only passes through. Blocks
+// evicted from A1in leave their key in A1out, and only a block that is
+// referenced again while remembered there is admitted to Am, the LRU of
+// blocks with proven reuse. Space is reclaimed from A1in while it is over
+// its share, else from Am. All queues share one node pool and key index.
+template <typename Key, typename Value>
+class TwoQCachePolicy : public ICachePolicy<Key, Value> {
+ public:
+
+  TwoQCachePolicy(const size_t& capacity,
+                  UNUSED_ATTRIBUTE const double& clean_fraction)
+  : in_capacity_(two_q_in_ratio * capacity),
+    out_capacity_(two_q_out_ratio * capacity),
+    capacity_(capacity){
+
+    if(capacity_ == 0 || capacity_ + out_capacity_ >= INVALID_SLOT / 2){
+      std::cout << "Invalid 2Q capacity: " << capacity_ << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    nodes_.resize(capacity_ + out_capacity_);
+    index_ = KeyIndex<Key>(capacity_ + out_capacity_);
+    InitializeFreeList(nodes_, free_list_);
+
+  }
+
+  ~TwoQCachePolicy() = default;
+
+  void Check(){
+
+    if (GetSize() > capacity_) {
+      std::cout << "Capacity exceeded \n";
+      exit(EXIT_FAILURE);
+    }
+
+    if (A1out.GetSize() > out_capacity_) {
+      std::cout << "A1out exceeds its capacity \n";
+      exit(EXIT_FAILURE);
+    }
+
+  }
+
+  void Touch(const Key& key){
+
+    // check if key exists
+    auto node = index_.Find(key);
+    if(node == INVALID_SLOT || nodes_[node].list == LIST_A1OUT){
+      std::cout << "KEY NOT FOUND: " << key << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    TouchNode(node);
+
+  }
+
+  Block Put(const Key& key, const Value& value){
+    Block victim;
+    victim_key_ = INVALID_KEY;
+    victim_value_ = INVALID_VALUE;
+
+    auto node = index_.Find(key);
+    auto list = (node == INVALID_SLOT) ? LIST_NONE : nodes_[node].list;
+
+    if (list == LIST_A1IN || list == LIST_AM) {
+      TouchNode(node);
+    }
+    else if (list == LIST_A1OUT) {
+      // referenced again while remembered: admit to Am
+      A1out.Unlink(nodes_, node);
+      if (GetSize() + 1 > capacity_) {
+        Reclaim();
+      }
+      MoveTo(Am, node, LIST_AM);
+    }
+    else {
+      // add new element to A1in
+      if (GetSize() + 1 > capacity_) {
+        Reclaim();
+      }
+
+      node = free_list_.PopFront(nodes_);
+      nodes_[node].key = key;
+      index_.Insert(key, node);
+      MoveTo(A1in, node, LIST_A1IN);
+    }
+
+    // update value of element
+    nodes_[node].value = value;
+
+    // Run integrity checks
+    Check();
+
+    // return victim
+    victim.block_id = victim_key_;
+    victim.block_type = victim_value_;
+    return victim;
+  }
+
+  Value Get(const Key& key){
+
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT || nodes_[node].list == LIST_A1OUT) {
+      return INVALID_VALUE;
+    }
+
+    // Touch element
+    TouchNode(node);
+
+    return nodes_[node].value;
+  }
+
+  void Erase(const Key& key){
+
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT) {
+      return;
+    }
+
+    auto list = nodes_[node].list;
+    if(list == LIST_A1IN){
+      A1in.Unlink(nodes_, node);
+    }
+    else if(list == LIST_AM){
+      Am.Unlink(nodes_, node);
+    }
+    else {
+      // keep the history of non-resident blocks
+      return;
+    }
+
+    Forget(node);
+
+  }
+
+  size_t GetSize() const{
+    return A1in.GetSize() + Am.GetSize();
+  }
+
+  // Number of blocks admitted to Am
+  size_t GetHotCount() const{
+    return Am.GetSize();
+  }
+
+  void Print() const{
+
+    std::cout << "OCCUPIED: " << (GetSize() * 100)/capacity_ << " %\n";
+
+    size_t block_itr = 0;
+    size_t print_block_count = 100;
+    for(auto list : {&Am, &A1in}){
+      for(auto node = list->GetFront(); node != INVALID_SLOT; node = nodes_[node].next){
+        if(block_itr++ >= print_block_count){
+          break;
+        }
+        std::cout << nodes_[node].key << CleanStatus(nodes_[node].value, false) << " ";
+      }
+    }
+
+    if(print_block_count > 0) {
+      std::cout << "\n-------------------------------\n";
+    }
+
+  }
+
+ private:
+
+  enum ListType : uint8_t {
+    LIST_NONE = 0,
+    LIST_A1IN = 1,
+    LIST_A1OUT = 2,
+    LIST_AM = 3
+  };
+
+  struct Node {
+    Key key = Key();
+    Value value = Value();
+    uint32_t prev = INVALID_SLOT;
+    uint32_t next = INVALID_SLOT;
+    ListType list = LIST_NONE;
+  };
+
+  void MoveTo(NodeList& target, const uint32_t& node, const ListType& list){
+    target.PushFront(nodes_, node);
+    nodes_[node].list = list;
+  }
+
+  // Hit on a resident entry (A1in is a FIFO, so only Am reorders)
+  void TouchNode(const uint32_t& node){
+    if(nodes_[node].list == LIST_AM){
+      Am.MoveToFront(nodes_, node);
+    }
+  }
+
+  // Drop an unlinked node from the index and the pool
+  void Forget(const uint32_t& node){
+    index_.Erase(nodes_[node].key);
+    nodes_[node].list = LIST_NONE;
+    free_list_.PushFront(nodes_, node);
+  }
+
+  // Evict the oldest block of A1in, remembering its key in A1out, or the
+  // LRU block of Am
+  void Reclaim(){
+    uint32_t victim_node = INVALID_SLOT;
+
+    if(A1in.GetSize() > in_capacity_ || Am.IsEmpty()){
+      victim_node = A1in.PopBack(nodes_);
+      victim_key_ = nodes_[victim_node].key;
+      victim_value_ = nodes_[victim_node].value;
+
+      MoveTo(A1out, victim_node, LIST_A1OUT);
+      if(A1out.GetSize() > out_capacity_){
+        Forget(A1out.PopBack(nodes_));
+      }
+    }
+    else {
+      victim_node = Am.PopBack(nodes_);
+      victim_key_ = nodes_[victim_node].key;
+      victim_value_ = nodes_[victim_node].value;
+
+      Forget(victim_node);
+    }
+  }
+
+  std::vector<Node> nodes_;
+
+  KeyIndex<Key> index_;
+
+  // resident, first referenced (FIFO)
+  NodeList A1in;
+
+  // non-resident keys evicted from A1in (FIFO)
+  NodeList A1out;
+
+  // resident, referenced again after leaving A1in (LRU)
+  NodeList Am;
+
+  NodeList free_list_;
+
+  size_t in_capacity_;
+
+  size_t out_capacity_;
+
+  size_t capacity_;
+
+  // block evicted by the current Put
+  Key victim_key_ = INVALID_KEY;
+
+  Value victim_value_ = INVALID_VALUE;
+
+};
+
+}  // End machine namespace
@@ -0,0 +1,421 @@
+// W-TINYLFU HEADER
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include "macros.h"
+#include "policy.h"
+#include "policy_index.h"
+
+namespace machine {
+
+// share of the W-TinyLFU capacity used by the admission window
+extern double w_tiny_lfu_window_ratio;
+
+// Approximate access frequencies for TinyLFU admission
+//
+// A Count-Min sketch of 4-bit counters (four rows of the capacity rounded
+// up to a power of two) behind a doorkeeper bloom filter: the first access
+// to a key since the last reset only sets its doorkeeper bits, later ones
+// increment its counters. After ten accesses per counter column all
+// counters are halved and the doorkeeper is cleared, so the sketch follows
+// shifts in popularity. This takes two bytes per entry for the counters
+// and four for the doorkeeper.
+class FrequencySketch {
+ public:
+
+  FrequencySketch(const size_t& capacity = 1){
+    width_ = 1;
+    while(width_ < capacity){
+      width_ *= 2;
+    }
+    counters_ = PackedArray<4>(ROW_COUNT * width_);
+    doorkeeper_ = PackedArray<1>(DOORKEEPER_BITS * width_);
+    sample_size_ = SAMPLE_FACTOR * width_;
+  }
+
+  // Count an access to the key
+  void Increment(const uint64_t& key_hash){
+    auto hash = Mix(key_hash);
+    access_count_++;
+
+    if(CheckDoorkeeper(hash) == false){
+      for(size_t probe_itr = 0; probe_itr < DOORKEEPER_PROBE_COUNT; probe_itr++){
+        doorkeeper_.Set(GetDoorkeeperBit(hash, probe_itr), 1);
+      }
+    }
+    else {
+      for(size_t row_itr = 0; row_itr < ROW_COUNT; row_itr++){
+        auto counter = GetCounter(hash, row_itr);
+        auto count = counters_.Get(counter);
+        if(count < COUNTER_MAX){
+          counters_.Set(counter, count + 1);
+        }
+      }
+    }
+
+    if(access_count_ >= sample_size_){
+      Reset();
+    }
+  }
+
+  // Estimated accesses since the last reset (at most 16)
+  size_t Estimate(const uint64_t& key_hash) const {
+    auto hash = Mix(key_hash);
+    size_t frequency = COUNTER_MAX;
+    for(size_t row_itr = 0; row_itr < ROW_COUNT; row_itr++){
+      frequency = std::min<size_t>(frequency, counters_.Get(GetCounter(hash, row_itr)));
+    }
+
+    // the doorkeeper holds the first access
+    if(CheckDoorkeeper(hash) == true){
+      frequency++;
+    }
+    return frequency;
+  }
+
+  // Halve all counters and clear the doorkeeper
+  void Reset(){
+    for(size_t counter_itr = 0; counter_itr < ROW_COUNT * width_; counter_itr++){
+      counters_.Set(counter_itr, counters_.Get(counter_itr) / 2);
+    }
+    doorkeeper_ = PackedArray<1>(DOORKEEPER_BITS * width_);
+    access_count_ = 0;
+  }
+
+ private:
+
+  static const size_t ROW_COUNT = 4;
+
+  static const size_t COUNTER_MAX = PackedArray<4>::MASK;
+
+  // doorkeeper bits and hash probes per counter column
+  static const size_t DOORKEEPER_BITS = 32;
+
+  static const size_t DOORKEEPER_PROBE_COUNT = 2;
+
+  // accesses per counter column between resets
+  static const size_t SAMPLE_FACTOR = 10;
+
+  // Finalizer of MurmurHash3, as std::hash is the identity for integers
+  static uint64_t Mix(uint64_t hash){
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  // Double hashing: probe i of a key is h1 + i * h2
+  static uint64_t GetProbe(const uint64_t& hash, const size_t& probe_itr){
+    return hash + probe_itr * ((hash >> 32) | 1);
+  }
+
+  size_t GetCounter(const uint64_t& hash, const size_t& row_itr) const {
+    return row_itr * width_ + (GetProbe(hash, row_itr) & (width_ - 1));
+  }
+
+  size_t GetDoorkeeperBit(const uint64_t& hash, const size_t& probe_itr) const {
+    return GetProbe(hash, ROW_COUNT + probe_itr) & (DOORKEEPER_BITS * width_ - 1);
+  }
+
+  bool CheckDoorkeeper(const uint64_t& hash) const {
+    for(size_t probe_itr = 0; probe_itr < DOORKEEPER_PROBE_COUNT; probe_itr++){
+      if(doorkeeper_.Get(GetDoorkeeperBit(hash, probe_itr)) == 0){
+        return false;
+      }
+    }
+    return true;
+  }
+
+  PackedArray<4> counters_;
+
+  PackedArray<1> doorkeeper_;
+
+  // counters per row (power of two)
+  size_t width_;
+
+  size_t sample_size_;
+
+  size_t access_count_ = 0;
+
+};
+
+// W-TinyLFU (Einziger, Friedman and Manes, ACM TOS 2017)
+//
+// New blocks enter a small LRU window. A block pushed out of the window
+// only enters the main region if the frequency sketch estimates it was
+// accessed more often than the block the main region would evict, so
+// one-hit wonders are dropped instead of displacing reused blocks. The
+// main region is a segmented LRU: blocks hit in probation move to the
+// protected segment (80% of the main region), whose LRU blocks fall back
+// to probation. All segments share one node pool and key index.
+template <typename Key, typename Value>
+class WTinyLFUCachePolicy : public ICachePolicy<Key, Value> {
+ public:
+
+  WTinyLFUCachePolicy(const size_t& capacity,
+                      UNUSED_ATTRIBUTE const double& clean_fraction)
+  : nodes_(capacity),
+    index_(capacity),
+    sketch_(capacity),
+    capacity_(capacity){
+
+    if(capacity_ == 0 || capacity_ >= INVALID_SLOT / 2){
+      std::cout << "Invalid W-TinyLFU capacity: " << capacity_ << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    size_t window_capacity = w_tiny_lfu_window_ratio * capacity_;
+    window_capacity_ = std::min(std::max<size_t>(window_capacity, 1), capacity_);
+    protected_capacity_ = (capacity_ - window_capacity_) * 8 / 10;
+
+    InitializeFreeList(nodes_, free_list_);
+
+  }
+
+  ~WTinyLFUCachePolicy() = default;
+
+  void Check(){
+
+    if (GetSize() > capacity_) {
+      std::cout << "Capacity exceeded \n";
+      exit(EXIT_FAILURE);
+    }
+
+    if (protected_list_.GetSize() > protected_capacity_) {
+      std::cout << "Protected segment exceeds its capacity \n";
+      exit(EXIT_FAILURE);
+    }
+
+  }
+
+  void Touch(const Key& key){
+
+    // check if key exists
+    auto node = index_.Find(key);
+    if(node == INVALID_SLOT){
+      std::cout << "KEY NOT FOUND: " << key << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    TouchNode(node);
+
+  }
+
+  Block Put(const Key& key, const Value& value){
+    Block victim;
+    Key victim_key = INVALID_KEY;
+    Value victim_value = INVALID_VALUE;
+
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT) {
+      // add new element to the window
+      sketch_.Increment(GetHash(key));
+
+      if (GetSize() + 1 > capacity_) {
+        auto victim_node = SelectVictim();
+        victim_key = nodes_[victim_node].key;
+        victim_value = nodes_[victim_node].value;
+
+        // evict victim
+        Remove(victim_node);
+      }
+
+      node = free_list_.PopFront(nodes_);
+      nodes_[node].key = key;
+      nodes_[node].value = value;
+      index_.Insert(key, node);
+      MoveTo(window_list_, node, SEGMENT_WINDOW);
+
+      // the window overflows into probation (the candidate was admitted)
+      if (window_list_.GetSize() > window_capacity_) {
+        MoveTo(probation_list_, window_list_.PopBack(nodes_), SEGMENT_PROBATION);
+      }
+    }
+    else {
+
+      // update previous value of element
+      nodes_[node].value = value;
+
+      // Touch element
+      TouchNode(node);
+
+    }
+
+    // Run integrity checks
+    Check();
+
+    // return victim
+    victim.block_id = victim_key;
+    victim.block_type = victim_value;
+    return victim;
+  }
+
+  Value Get(const Key& key){
+
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT) {
+      return INVALID_VALUE;
+    }
+
+    // Touch element
+    TouchNode(node);
+
+    return nodes_[node].value;
+  }
+
+  void Erase(const Key& key){
+
+    auto node = index_.Find(key);
+    if (node == INVALID_SLOT) {
+      return;
+    }
+
+    Remove(node);
+
+  }
+
+  size_t GetSize() const{
+    return window_list_.GetSize() + probation_list_.GetSize() +
+        protected_list_.GetSize();
+  }
+
+  // Estimated recent accesses of a key, cached or not
+  size_t GetFrequency(const Key& key) const{
+    return sketch_.Estimate(GetHash(key));
+  }
+
+  void Print() const{
+
+    std::cout << "OCCUPIED: " << (GetSize() * 100)/capacity_ << " %\n";
+
+    size_t block_itr = 0;
+    size_t print_block_count = 100;
+    for(auto list : {&window_list_, &protected_list_, &probation_list_}){
+      for(auto node = list->GetFront(); node != INVALID_SLOT; node = nodes_[node].next){
+        if(block_itr++ >= print_block_count){
+          break;
+        }
+        std::cout << nodes_[node].key << CleanStatus(nodes_[node].value, false) << " ";
+      }
+    }
+
+    if(print_block_count > 0) {
+      std::cout << "\n-------------------------------\n";
+    }
+
+  }
+
+ private:
+
+  enum Segment : uint8_t {
+    SEGMENT_NONE = 0,
+    SEGMENT_WINDOW = 1,
+    SEGMENT_PROBATION = 2,
+    SEGMENT_PROTECTED = 3
+  };
+
+  struct Node {
+    Key key = Key();
+    Value value = Value();
+    uint32_t prev = INVALID_SLOT;
+    uint32_t next = INVALID_SLOT;
+    Segment segment = SEGMENT_NONE;
+  };
+
+  static uint64_t GetHash(const Key& key){
+    return std::hash<Key>()(key);
+  }
+
+  NodeList& GetList(const Segment& segment){
+    switch(segment){
+      case SEGMENT_WINDOW:
+        return window_list_;
+      case SEGMENT_PROBATION:
+        return probation_list_;
+      default:
+        return protected_list_;
+    }
+  }
+
+  void MoveTo(NodeList& target, const uint32_t& node, const Segment& segment){
+    target.PushFront(nodes_, node);
+    nodes_[node].segment = segment;
+  }
+
+  // Hit on a cached block
+  void TouchNode(const uint32_t& node){
+    sketch_.Increment(GetHash(nodes_[node].key));
+
+    auto segment = nodes_[node].segment;
+    if(segment != SEGMENT_PROBATION){
+      GetList(segment).MoveToFront(nodes_, node);
+      return;
+    }
+
+    probation_list_.Unlink(nodes_, node);
+    MoveTo(protected_list_, node, SEGMENT_PROTECTED);
+    if(protected_list_.GetSize() > protected_capacity_){
+      MoveTo(probation_list_, protected_list_.PopBack(nodes_), SEGMENT_PROBATION);
+    }
+  }
+
+  // Block to make room for a new one. While the window is full its LRU
+  // block (the candidate) is about to be pushed into the main region, so
+  // it competes with the block the main region would evict (the rival) and
+  // the one with the lower estimated frequency loses; ties keep the rival.
+  uint32_t SelectVictim() const{
+    auto rival = probation_list_.IsEmpty() ?
+        protected_list_.GetBack() : probation_list_.GetBack();
+    if(rival == INVALID_SLOT){
+      return window_list_.GetBack();
+    }
+    if(window_list_.GetSize() < window_capacity_){
+      return rival;
+    }
+
+    auto candidate = window_list_.GetBack();
+    auto candidate_frequency = sketch_.Estimate(GetHash(nodes_[candidate].key));
+    auto rival_frequency = sketch_.Estimate(GetHash(nodes_[rival].key));
+    return (candidate_frequency > rival_frequency) ? rival : candidate;
+  }
+
+  void Remove(const uint32_t& node){
+    GetList(nodes_[node].segment).Unlink(nodes_, node);
+    index_.Erase(nodes_[node].key);
+    nodes_[node].segment = SEGMENT_NONE;
+    free_list_.PushFront(nodes_, node);
+  }
+
+  std::vector<Node> nodes_;
+
+  KeyIndex<Key> index_;
+
+  // LRU of new blocks
+  NodeList window_list_;
+
+  // main region: segmented LRU
+  NodeList probation_list_;
+
+  NodeList protected_list_;
+
+  NodeList free_list_;
+
+  FrequencySketch sketch_;
+
+  size_t window_capacity_;
+
+  size_t protected_capacity_;
+
+  size_t capacity_;
+
+};
+
+}  // End machine namespace
@@ -0,0 +1,130 @@
+// SSD MODEL HEADER
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "types.h"
+
+namespace machine {
+
+// Flash translation layer with page-level mapping
+//
+// Logical pages are written out of place into the active erase block. When
+// free erase blocks run low, garbage collection picks a victim block,
+// relocates its valid pages, and erases it. The time spent doing so is
+// returned to the caller so that it can be charged to the triggering write.
+class SSDModel {
+ public:
+
+  SSDModel(const size_t& logical_page_count,
+           const double& over_provisioning,
+           const size_t& pages_per_block,
+           const GcPolicyType& gc_policy_type);
+
+  // Flash latencies (ns) used by garbage collection
+  void SetLatencies(const double& read_latency,
+                    const double& program_latency,
+                    const double& erase_latency);
+
+  // Write a logical page and return the garbage collection latency (ns)
+  double Write(const size_t& logical_page);
+
+  // Discard a logical page
+  void Trim(const size_t& logical_page);
+
+  // Fill every logical page once to reach the steady state of a used drive
+  void Precondition();
+
+  size_t GetLogicalPageCount() const {
+    return logical_page_count_;
+  }
+
+  // Flash pages written per host page
+  double GetWriteAmplification() const;
+
+  void ResetStats();
+
+  friend std::ostream& operator<< (std::ostream& os, const SSDModel& ssd_model);
+
+  static const uint32_t INVALID_PAGE = UINT32_MAX;
+
+  // keep at least this many free erase blocks
+  static const size_t GC_THRESHOLD = 2;
+
+ private:
+
+  struct EraseBlock {
+
+    // valid pages in the block
+    size_t valid_count = 0;
+
+    // next page to program
+    size_t write_pointer = 0;
+
+    // times the block was erased
+    size_t erase_count = 0;
+
+    // logical time of the last host write of the data it holds (relocated
+    // pages keep that of their source block)
+    size_t last_write = 0;
+
+  };
+
+  // Next free physical page in the host or GC active block
+  size_t AllocatePage(const bool& is_gc, double& gc_latency);
+
+  void InvalidatePage(const size_t& physical_page);
+
+  // Reclaim one erase block and return the time spent (ns)
+  double CollectGarbage();
+
+  size_t SelectVictim() const;
+
+  size_t logical_page_count_;
+
+  size_t pages_per_block_;
+
+  GcPolicyType gc_policy_type_;
+
+  // logical page -> physical page
+  std::vector<uint32_t> mapping_;
+
+  // physical page -> logical page
+  std::vector<uint32_t> reverse_mapping_;
+
+  std::vector<EraseBlock> blocks_;
+
+  std::vector<size_t> free_blocks_;
+
+  size_t host_block_;
+
+  size_t gc_block_;
+
+  // logical clock
+  size_t clock_ = 0;
+
+  // flash latencies (ns)
+  double read_latency_ = 0;
+
+  double program_latency_ = 0;
+
+  double erase_latency_ = 0;
+
+  // STATS
+
+  size_t host_page_count_ = 0;
+
+  size_t flash_page_count_ = 0;
+
+  size_t trim_count_ = 0;
+
+  size_t gc_count_ = 0;
+
+  double gc_latency_ = 0;
+
+};
+
+}  // End machine namespace
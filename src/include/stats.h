@@ -3,9 +3,11 @@
 #pragma once
 
 #include <map>
+#include <ostream>
 #include <utility>
 
 #include "types.h"
+#include "histogram.h"
 
 namespace machine {
 
@@ -25,8 +27,44 @@ class Stats{
 
   void IncrementSyncCount(DeviceType device_type);
 
+  void IncrementReadBytes(DeviceType device_type, size_t byte_count);
+
+  void IncrementWriteBytes(DeviceType device_type, size_t byte_count);
+
+  void IncrementNumaHitCount(DeviceType device_type, bool is_local);
+
+  void IncrementNumaMigrationCount(DeviceType device_type);
+
   void IncrementOpCount(DeviceType source_device_type, DeviceType destination_device_type);
 
+  inline void IncrementPatternCount(DeviceType device_type,
+                                    PatternType pattern_type){
+    pattern_ops[device_type][pattern_type]++;
+  }
+
+  void IncrementPrefetchCount(DeviceType device_type);
+
+  // Record the latency of a trace operation served by the given device
+  inline void RecordLatency(OperationType operation_type,
+                            DeviceType device_type,
+                            double latency){
+    latency_histograms[operation_type][device_type].Record(latency);
+  }
+
+  // Charge extra latency to a trace operation already recorded
+  inline void ChargeLatency(OperationType operation_type,
+                            DeviceType device_type,
+                            double latency,
+                            double extra_latency){
+    latency_histograms[operation_type][device_type].Shift(latency, extra_latency);
+  }
+
+  // Latency histogram of an operation type across all devices
+  Histogram GetLatencyHistogram(OperationType operation_type) const;
+
+  // Write latency percentiles (one line per operation type and device)
+  void WriteLatencies(std::ostream& os) const;
+
   friend std::ostream& operator<< (std::ostream& stream, const Stats& stats);
 
  //private:
@@ -43,9 +81,33 @@ class Stats{
   // Sync op count
   std::map<DeviceType, size_t> sync_ops;
 
+  // Read byte count
+  std::map<DeviceType, size_t> read_bytes;
+
+  // Write byte count
+  std::map<DeviceType, size_t> write_bytes;
+
+  // Local NUMA hit count
+  std::map<DeviceType, size_t> local_ops;
+
+  // Remote NUMA hit count
+  std::map<DeviceType, size_t> remote_ops;
+
+  // NUMA migration count
+  std::map<DeviceType, size_t> migration_ops;
+
   // Op tracker
   std::map<DeviceType, std::map<DeviceType, size_t>> movement_ops;
 
+  // Access pattern count
+  size_t pattern_ops[DEVICE_TYPE_COUNT][PATTERN_TYPE_COUNT] = {};
+
+  // Prefetched block count
+  std::map<DeviceType, size_t> prefetch_ops;
+
+  // Latency histograms (ns) per operation type and serving device
+  Histogram latency_histograms[OPERATION_TYPE_COUNT][DEVICE_TYPE_COUNT];
+
 };
 
 }  // End machine namespace
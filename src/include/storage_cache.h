@@ -14,20 +14,21 @@ class StorageCache {
   StorageCache(DeviceType device_type,
                CachingType caching_type,
                size_t capacity,
+               size_t block_size,
                double clean_fraction = 0);
 
   Block Put(const int& key, const int& value);
 
   int Get(const int& key) const;
 
+  void Erase(const int& key);
+
   size_t GetSize() const;
 
   size_t GetCapacity() const{
     return capacity_;
   }
 
-  bool IsSequential(const size_t& next);
-
   friend std::ostream& operator<< (std::ostream& stream,
                                    const StorageCache& cache);
 
@@ -43,12 +44,22 @@ class StorageCache {
 
   Cache<int, int, ARCCachePolicy<int, int>>* arc_cache = nullptr;
 
-  // current block accessed
-  size_t current_ = 0;
+  Cache<int, int, CLOCKCachePolicy<int, int>>* clock_cache = nullptr;
+
+  Cache<int, int, CLOCKProCachePolicy<int, int>>* clock_pro_cache = nullptr;
+
+  Cache<int, int, TwoQCachePolicy<int, int>>* two_q_cache = nullptr;
+
+  Cache<int, int, LIRSCachePolicy<int, int>>* lirs_cache = nullptr;
+
+  Cache<int, int, WTinyLFUCachePolicy<int, int>>* w_tiny_lfu_cache = nullptr;
 
   // capacity
   size_t capacity_ = 0;
 
+  // block size (in bytes)
+  size_t block_size_ = 0;
+
   // clean fraction
   double clean_fraction_ = 0;
 
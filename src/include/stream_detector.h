@@ -0,0 +1,63 @@
+// STREAM DETECTOR HEADER
+
+#pragma once
+
+#include <vector>
+
+#include "types.h"
+
+namespace machine {
+
+// Access pattern detector that follows several concurrent streams
+//
+// Each stream remembers its last block and stride. An access that extends a
+// stream by one block is sequential, an access that repeats a stream's stride
+// is strided, and anything else is random and starts a new stream in place
+// of the least recently used one.
+class StreamDetector {
+ public:
+
+  StreamDetector(size_t stream_count = DEFAULT_STREAM_COUNT,
+                 size_t max_stride = DEFAULT_MAX_STRIDE);
+
+  // Classify an access to the given block and update the streams
+  PatternType Classify(const size_t& block_id);
+
+  // Stride (in blocks) of the sequential or strided stream that last
+  // accessed the given block (0 if there is none)
+  long GetStride(const size_t& block_id) const;
+
+  static const size_t DEFAULT_STREAM_COUNT = 16;
+
+  static const size_t DEFAULT_MAX_STRIDE = 64;
+
+ private:
+
+  struct Stream {
+
+    // last block accessed
+    size_t last_block = 0;
+
+    // distance between the last two blocks
+    long stride = 0;
+
+    // pattern of the last access
+    PatternType pattern_type = PATTERN_TYPE_RANDOM;
+
+    // logical time of the last access
+    size_t last_access = 0;
+
+    bool valid = false;
+
+  };
+
+  std::vector<Stream> streams_;
+
+  size_t max_stride_;
+
+  // logical clock
+  size_t clock_ = 0;
+
+};
+
+}  // End machine namespace
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 namespace machine {
@@ -71,8 +72,64 @@ enum CachingType {
   CACHING_TYPE_LFU = 2,
   CACHING_TYPE_LRU = 3,
   CACHING_TYPE_ARC = 4,
+  CACHING_TYPE_CLOCK = 5,
+  CACHING_TYPE_CLOCK_PRO = 6,
+  CACHING_TYPE_TWO_Q = 7,
+  CACHING_TYPE_LIRS = 8,
+  CACHING_TYPE_W_TINY_LFU = 9,
 
-  CACHING_TYPE_MAX = 4
+  CACHING_TYPE_MAX = 9
+};
+
+enum NumaPlacementType {
+  NUMA_PLACEMENT_TYPE_INVALID = 0,
+
+  NUMA_PLACEMENT_TYPE_FIRST_TOUCH = 1,
+  NUMA_PLACEMENT_TYPE_INTERLEAVE = 2,
+  NUMA_PLACEMENT_TYPE_MIGRATE = 3,
+
+  NUMA_PLACEMENT_TYPE_MAX = 3
+};
+
+enum LatencyModelType {
+  LATENCY_MODEL_TYPE_INVALID = 0,
+
+  LATENCY_MODEL_TYPE_FIXED = 1,
+  LATENCY_MODEL_TYPE_DISTRIBUTION = 2,
+  LATENCY_MODEL_TYPE_SIZE = 3,
+
+  LATENCY_MODEL_TYPE_MAX = 3
+};
+
+enum GcPolicyType {
+  GC_POLICY_TYPE_INVALID = 0,
+
+  GC_POLICY_TYPE_GREEDY = 1,
+  GC_POLICY_TYPE_COST_BENEFIT = 2,
+
+  GC_POLICY_TYPE_MAX = 2
+};
+
+enum EmulationBackendType {
+  EMULATION_BACKEND_TYPE_INVALID = 0,
+
+  EMULATION_BACKEND_TYPE_STDIO = 1,
+  EMULATION_BACKEND_TYPE_DIRECT = 2,
+  EMULATION_BACKEND_TYPE_URING = 3,
+  EMULATION_BACKEND_TYPE_MMAP = 4,
+  EMULATION_BACKEND_TYPE_MEMORY = 5,
+
+  EMULATION_BACKEND_TYPE_MAX = 5
+};
+
+enum PersistType {
+  PERSIST_TYPE_INVALID = 0,
+
+  PERSIST_TYPE_CLWB = 1,
+  PERSIST_TYPE_CLFLUSHOPT = 2,
+  PERSIST_TYPE_MSYNC = 3,
+
+  PERSIST_TYPE_MAX = 3
 };
 
 enum DeviceType {
@@ -81,13 +138,36 @@ enum DeviceType {
   DEVICE_TYPE_CACHE = 2,
   DEVICE_TYPE_DRAM = 3,
   DEVICE_TYPE_NVM = 4,
-  DEVICE_TYPE_DISK = 5
+  DEVICE_TYPE_DISK = 5,
+
+  DEVICE_TYPE_MAX = 5
+};
+
+// size of tables indexed by device type
+const size_t DEVICE_TYPE_COUNT = DEVICE_TYPE_MAX + 1;
+
+enum PatternType {
+  PATTERN_TYPE_SEQUENTIAL = 0,
+  PATTERN_TYPE_STRIDED = 1,
+  PATTERN_TYPE_RANDOM = 2,
+
+  PATTERN_TYPE_COUNT = 3
+};
+
+enum OperationType {
+  OPERATION_TYPE_READ = 0,
+  OPERATION_TYPE_WRITE = 1,
+  OPERATION_TYPE_FLUSH = 2,
 
+  OPERATION_TYPE_COUNT = 3
 };
 
 
 DeviceType GetLastDevice(const HierarchyType& hierarchy_type);
 
+// Device type with the given name (DEVICE_TYPE_INVALID if there is none)
+DeviceType StringToDeviceType(const std::string& device_name);
+
 std::string HierarchyTypeToString(const HierarchyType& hierarchy_type);
 
 std::string DiskModeTypeToString(const DiskModeType& disk_mode_type);
@@ -102,5 +182,19 @@ std::string CachingTypeToString(const CachingType& caching_type);
 
 std::string DeviceTypeToString(const DeviceType& device_type);
 
+std::string NumaPlacementTypeToString(const NumaPlacementType& numa_placement_type);
+
+std::string LatencyModelTypeToString(const LatencyModelType& latency_model_type);
+
+std::string GcPolicyTypeToString(const GcPolicyType& gc_policy_type);
+
+std::string EmulationBackendTypeToString(const EmulationBackendType& emulation_backend_type);
+
+std::string PersistTypeToString(const PersistType& persist_type);
+
+std::string OperationTypeToString(const OperationType& operation_type);
+
+std::string PatternTypeToString(const PatternType& pattern_type);
+
 
 }  // End machine namespace
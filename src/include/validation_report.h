@@ -0,0 +1,71 @@
+// VALIDATION REPORT HEADER
+
+#pragma once
+
+#include <map>
+#include <ostream>
+#include <tuple>
+
+#include "calibration.h"
+#include "histogram.h"
+#include "latency_model.h"
+#include "types.h"
+
+namespace machine {
+
+// Modeled versus measured latency of emulated I/O
+//
+// Every emulated access is recorded with the latency the model predicted
+// and the latency the emulator measured, per device, access type, and
+// pattern. The ratio of the two gives the error distribution, and scaling
+// each page latency of the table by the mean ratio suggests a corrected
+// table for this host.
+class ValidationReport {
+ public:
+
+  void Record(const DeviceType& device_type,
+              const AccessType& access_type,
+              const PatternType& pattern_type,
+              const double& page_latency,
+              const double& modeled_latency,
+              const double& measured_latency);
+
+  // Page latency scaled by measured / modeled (the table value if unseen)
+  double GetSuggestedLatency(const LatencyModel& latency_model,
+                             const DeviceType& device_type,
+                             const AccessType& access_type,
+                             const PatternType& pattern_type) const;
+
+  // Suggested latencies of every recorded device in the calibration
+  // profile layout (strided accesses are left out)
+  std::map<DeviceType, LatencyProfile> GetSuggestedProfiles(const LatencyModel& latency_model) const;
+
+  void Reset();
+
+  friend std::ostream& operator<< (std::ostream& os, const ValidationReport& validation_report);
+
+ private:
+
+  typedef std::tuple<DeviceType, AccessType, PatternType> Key;
+
+  struct Entry {
+
+    // table value when recorded (ns)
+    double page_latency = 0;
+
+    double modeled_total = 0;
+
+    double measured_total = 0;
+
+    Histogram measured;
+
+    // measured / modeled (%)
+    Histogram ratio;
+
+  };
+
+  std::map<Key, Entry> entries_;
+
+};
+
+}  // End machine namespace
@@ -8,4 +8,7 @@ namespace machine {
 
 void RunMachineTest();
 
+// Replay the trace and return the throughput (ops/s)
+double MachineHelper();
+
 }  // namespace machine
@@ -0,0 +1,241 @@
+// IO WORKER POOL SOURCE
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+#include "io_worker_pool.h"
+#include "configuration.h"
+
+namespace machine {
+
+IOWorkerPool::IOWorkerPool(const configuration& state,
+                           const std::map<DeviceType, EmulationTarget>& targets,
+                           const size_t& worker_count,
+                           const size_t& queue_depth,
+                           const size_t& buffer_size)
+: queue_depth_(queue_depth){
+
+  // Memory tiers are not I/O and stay on the simulation thread
+  for(auto& entry : targets){
+    if(EmulationBackendFactory::GetEmulationBackendType(state, entry.first) !=
+        EMULATION_BACKEND_TYPE_MEMORY){
+      device_types_[entry.first] = true;
+    }
+  }
+
+  for(size_t worker_itr = 0; worker_itr < worker_count; worker_itr++){
+    std::unique_ptr<Worker> worker(new Worker());
+    for(auto& entry : device_types_){
+      worker->backends[entry.first] =
+          EmulationBackendFactory::GetEmulationBackend(state,
+                                                       entry.first,
+                                                       targets.at(entry.first),
+                                                       buffer_size);
+    }
+    workers_.push_back(std::move(worker));
+  }
+
+  for(auto& worker : workers_){
+    worker->thread = std::thread(&IOWorkerPool::Run, this, std::ref(*worker));
+  }
+
+  start_ = end_ = clock_::now();
+
+}
+
+IOWorkerPool::~IOWorkerPool(){
+
+  Drain();
+
+  for(auto& worker : workers_){
+    {
+      std::lock_guard<std::mutex> lock(worker->mutex);
+      worker->is_stopping = true;
+    }
+    worker->has_request.notify_one();
+  }
+
+  for(auto& worker : workers_){
+    worker->thread.join();
+  }
+
+}
+
+size_t IOWorkerPool::Submit(const size_t& worker_id, const IORequest& request){
+
+  auto& worker = *workers_[worker_id % workers_.size()];
+
+  size_t ticket = 0;
+  {
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    worker.has_space.wait(lock, [&](){
+      return worker.queue.size() < queue_depth_;
+    });
+    worker.queue.push_back(request);
+    ticket = ++worker.submitted_count;
+  }
+
+  worker.has_request.notify_one();
+
+  return ticket;
+}
+
+void IOWorkerPool::Wait(const size_t& worker_id, const size_t& ticket){
+
+  // Requests are served in order, so the count tells when ours is done
+  auto& worker = *workers_[worker_id % workers_.size()];
+  std::unique_lock<std::mutex> lock(worker.mutex);
+  worker.is_idle.wait(lock, [&](){
+    return worker.completed_count >= ticket;
+  });
+
+}
+
+void IOWorkerPool::Drain(){
+
+  for(auto& worker : workers_){
+    std::unique_lock<std::mutex> lock(worker->mutex);
+    worker->is_idle.wait(lock, [&](){
+      return worker->queue.empty() && worker->is_busy == false;
+    });
+  }
+
+  end_ = clock_::now();
+
+}
+
+double IOWorkerPool::Sync(const DeviceType& device_type,
+                          const std::set<size_t>& worker_ids){
+
+  IORequest request;
+  request.device_type = device_type;
+  request.operation_type = OPERATION_TYPE_FLUSH;
+
+  for(auto worker_id : worker_ids){
+    Submit(worker_id, request);
+  }
+
+  // The syncs run in parallel, so the slowest one is the commit latency
+  double sync_time = 0;
+  for(auto worker_id : worker_ids){
+    auto& worker = *workers_[worker_id % workers_.size()];
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    worker.is_idle.wait(lock, [&](){
+      return worker.queue.empty() && worker.is_busy == false;
+    });
+    sync_time = std::max(sync_time, worker.sync_time);
+  }
+
+  return sync_time;
+}
+
+void IOWorkerPool::Run(Worker& worker){
+
+  Timer<std::ratio<1, 1000 * 1000 * 1000>> service_timer;
+
+  while(true){
+    IORequest request;
+    {
+      std::unique_lock<std::mutex> lock(worker.mutex);
+      worker.has_request.wait(lock, [&](){
+        return worker.is_stopping == true || worker.queue.empty() == false;
+      });
+      if(worker.queue.empty() == true){
+        return;
+      }
+
+      request = worker.queue.front();
+      worker.queue.pop_front();
+      worker.is_busy = true;
+    }
+    worker.has_space.notify_one();
+
+    auto& backend = worker.backends[request.device_type];
+    service_timer.Reset();
+    service_timer.Start();
+    switch(request.operation_type){
+      case OPERATION_TYPE_READ:
+        backend->Read(request.offset, request.byte_count);
+        break;
+      case OPERATION_TYPE_WRITE:
+        backend->Write(request.offset, request.byte_count);
+        break;
+      case OPERATION_TYPE_FLUSH:
+        backend->Sync();
+        break;
+      default:
+        break;
+    }
+    service_timer.Stop();
+
+    {
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      auto& stats = worker.stats[request.device_type];
+      stats.operation_count[request.operation_type]++;
+      stats.service_time[request.operation_type] += service_timer.GetDuration();
+      stats.byte_count += request.byte_count;
+      if(request.operation_type == OPERATION_TYPE_FLUSH){
+        worker.sync_time = service_timer.GetDuration();
+      }
+      worker.completed_count++;
+      worker.is_busy = false;
+    }
+    worker.is_idle.notify_all();
+  }
+
+}
+
+void IOWorkerPool::ResetStats(){
+
+  // Requests issued before the reset are not counted
+  Drain();
+
+  for(auto& worker : workers_){
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    worker->stats.clear();
+  }
+
+  start_ = end_ = clock_::now();
+
+}
+
+std::ostream& operator<< (std::ostream& os, const IOWorkerPool& io_worker_pool){
+
+  auto duration = std::chrono::duration<double>(io_worker_pool.end_ - io_worker_pool.start_).count();
+  duration = std::max(duration, 1e-9);
+
+  os << "IO WORKERS: " << io_worker_pool.workers_.size() << "\n";
+  for(auto& entry : io_worker_pool.device_types_){
+    auto device_type = entry.first;
+
+    // Sum over workers
+    IOWorkerPool::WorkerStats total;
+    for(auto& worker : io_worker_pool.workers_){
+      std::lock_guard<std::mutex> lock(worker->mutex);
+      if(worker->stats.count(device_type) == 0){
+        continue;
+      }
+      auto& stats = worker->stats.at(device_type);
+      for(size_t type_itr = 0; type_itr < OPERATION_TYPE_COUNT; type_itr++){
+        total.operation_count[type_itr] += stats.operation_count[type_itr];
+        total.service_time[type_itr] += stats.service_time[type_itr];
+      }
+      total.byte_count += stats.byte_count;
+    }
+
+    os << std::setw(10) << DeviceTypeToString(device_type) << " :: ";
+    for(size_t type_itr = 0; type_itr < OPERATION_TYPE_COUNT; type_itr++){
+      auto operation_count = std::max<size_t>(total.operation_count[type_itr], 1);
+      auto label = (type_itr == OPERATION_TYPE_FLUSH) ? "SYNC" :
+          OperationTypeToString((OperationType) type_itr);
+      os << label << ": " << total.operation_count[type_itr] << " "
+          << total.service_time[type_itr] / operation_count / 1000 << " us ";
+    }
+    os << "THROUGHPUT: " << total.byte_count / duration / (1024 * 1024) << " MB/s\n";
+  }
+
+  return os;
+}
+
+}  // End machine namespace
@@ -0,0 +1,105 @@
+// LATENCY MODEL SOURCE
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+#include "latency_model.h"
+#include "configuration.h"
+
+namespace machine {
+
+// LATENCY MODEL
+
+void LatencyModel::SetPageLatency(const DeviceType& device_type,
+                                  const AccessType& access_type,
+                                  const PatternType& pattern_type,
+                                  const double& latency){
+  latencies_[device_type][access_type][pattern_type] = latency;
+}
+
+void LatencyModel::SetBandwidth(const DeviceType& device_type,
+                                const AccessType& access_type,
+                                const double& bandwidth){
+  bandwidths_[device_type][access_type] = bandwidth;
+}
+
+// FIXED
+
+double FixedLatencyModel::GetLatency(const DeviceType& device_type,
+                                     const AccessType& access_type,
+                                     const PatternType& pattern_type,
+                                     const size_t& byte_count){
+  return GetTransferLatency(device_type, access_type, pattern_type, byte_count);
+}
+
+// DISTRIBUTION
+
+DistributionLatencyModel::DistributionLatencyModel(const double& sigma,
+                                                   const unsigned long& seed)
+: samples_(SAMPLE_COUNT),
+  generator_(seed){
+
+  // Log-normal factors with unit mean
+  std::mt19937 engine(seed);
+  std::lognormal_distribution<double> distribution(-sigma * sigma / 2, sigma);
+  for(auto& sample : samples_){
+    sample = distribution(engine);
+  }
+
+}
+
+double DistributionLatencyModel::GetLatency(const DeviceType& device_type,
+                                            const AccessType& access_type,
+                                            const PatternType& pattern_type,
+                                            const size_t& byte_count){
+  auto factor = samples_[generator_.next_u32() & (SAMPLE_COUNT - 1)];
+  return factor * GetTransferLatency(device_type, access_type, pattern_type,
+                                     byte_count);
+}
+
+// SIZE
+
+double SizeLatencyModel::GetLatency(const DeviceType& device_type,
+                                    const AccessType& access_type,
+                                    const PatternType& pattern_type,
+                                    const size_t& byte_count){
+  if(byte_count == 0){
+    return 0;
+  }
+
+  auto bandwidth = bandwidths_[device_type][access_type];
+  auto page_latency = latencies_[device_type][access_type][pattern_type];
+  if(bandwidth == 0){
+    return page_latency;
+  }
+
+  // Setup cost is whatever the page latency spends beyond the transfer
+  auto setup_latency = std::max(page_latency - PAGE_SIZE/bandwidth, 0.0);
+  return setup_latency + byte_count/bandwidth;
+}
+
+// LATENCY MODEL FACTORY
+
+std::unique_ptr<LatencyModel> LatencyModelFactory::GetLatencyModel(const configuration& state){
+
+  switch(state.latency_model_type){
+    case LATENCY_MODEL_TYPE_FIXED:
+      return std::unique_ptr<LatencyModel>(new FixedLatencyModel());
+
+    case LATENCY_MODEL_TYPE_DISTRIBUTION:
+      return std::unique_ptr<LatencyModel>(
+          new DistributionLatencyModel(state.latency_sigma, generator_seed));
+
+    case LATENCY_MODEL_TYPE_SIZE:
+      return std::unique_ptr<LatencyModel>(new SizeLatencyModel());
+
+    default: {
+      std::cout << "Invalid latency model type: " << state.latency_model_type << "\n";
+      exit(EXIT_FAILURE);
+    }
+  }
+
+}
+
+}  // End machine namespace
@@ -0,0 +1,228 @@
+// NVM MODEL SOURCE
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+
+#include "nvm_model.h"
+
+namespace machine {
+
+const size_t NVMModel::LINE_SIZE;
+
+const size_t NVMModel::CHUNK_SIZE;
+
+const uint64_t NVMModel::FULL_LINE;
+
+const size_t NVMModel::WEAR_LEVELING_PERIOD;
+
+NVMModel::NVMModel(const size_t& capacity,
+                   const size_t& region_size,
+                   const double& write_bandwidth,
+                   const size_t& buffer_line_count,
+                   const double& endurance,
+                   const bool& wear_leveling)
+: capacity_(capacity),
+  region_count_(std::max<size_t>((capacity + region_size - 1)/region_size, 1)),
+  lines_per_region_(std::max<size_t>(region_size / LINE_SIZE, 1)),
+  write_bandwidth_(write_bandwidth),
+  buffer_line_count_(buffer_line_count),
+  endurance_(endurance),
+  wear_leveling_(wear_leveling){
+
+  mapping_.resize(region_count_);
+  reverse_mapping_.resize(region_count_);
+  for(size_t region_itr = 0; region_itr < region_count_; region_itr++){
+    mapping_[region_itr] = region_itr;
+    reverse_mapping_[region_itr] = region_itr;
+  }
+
+  wear_.resize(region_count_, 0);
+  window_wear_.resize(region_count_, 0);
+
+}
+
+double NVMModel::Write(const size_t& address,
+                       const size_t& byte_count,
+                       const double& now){
+
+  host_byte_count_ += byte_count;
+
+  // Wait for room in the media queue, which holds as much as the buffer
+  auto queue_latency = buffer_line_count_ * LINE_SIZE / write_bandwidth_;
+  auto stall = std::max(media_free_ns_ - now - queue_latency, 0.0);
+  stall_latency_ += stall;
+
+  // Split the write into lines and the chunks it covers in each line
+  auto first_line = address / LINE_SIZE;
+  auto last_line = (address + byte_count - 1) / LINE_SIZE;
+  for(auto line = first_line; line <= last_line; line++){
+    auto begin = std::max(address, line * LINE_SIZE) - line * LINE_SIZE;
+    auto end = std::min(address + byte_count, (line + 1) * LINE_SIZE) - line * LINE_SIZE;
+
+    auto first_chunk = begin / CHUNK_SIZE;
+    auto last_chunk = (end - 1) / CHUNK_SIZE;
+    uint64_t mask = FULL_LINE;
+    if(last_chunk - first_chunk + 1 < 64){
+      mask = ((((uint64_t) 1) << (last_chunk - first_chunk + 1)) - 1) << first_chunk;
+    }
+
+    WriteLine(line, mask, now + stall);
+  }
+
+  return stall;
+}
+
+void NVMModel::WriteLine(const size_t& line,
+                         const uint64_t& mask,
+                         const double& now){
+
+  clock_++;
+
+  // Merge with a buffered line
+  for(auto& buffer_line : buffer_){
+    if(buffer_line.line == line){
+      buffer_line.mask |= mask;
+      buffer_line.last_write = clock_;
+      combined_line_count_++;
+      return;
+    }
+  }
+
+  // Write back the least recently written line
+  if(buffer_.size() == buffer_line_count_){
+    auto victim = std::min_element(buffer_.begin(), buffer_.end(),
+                                   [](const BufferLine& a, const BufferLine& b){
+      return a.last_write < b.last_write;
+    });
+    WriteMedia(victim->line, victim->mask, now);
+    buffer_.erase(victim);
+  }
+
+  BufferLine buffer_line;
+  buffer_line.line = line;
+  buffer_line.mask = mask;
+  buffer_line.last_write = clock_;
+  buffer_.push_back(buffer_line);
+
+}
+
+void NVMModel::WriteMedia(const size_t& line,
+                          const uint64_t& mask,
+                          const double& now){
+
+  // Partial lines need a read-modify-write on the media
+  if(mask != FULL_LINE){
+    partial_line_count_++;
+  }
+
+  auto region = (line / lines_per_region_) % region_count_;
+  auto physical_region = mapping_[region];
+  wear_[physical_region]++;
+  window_wear_[physical_region]++;
+  media_line_count_++;
+
+  media_free_ns_ = std::max(media_free_ns_, now) + LINE_SIZE / write_bandwidth_;
+
+  if(wear_leveling_ == true){
+    writes_since_leveling_++;
+    if(writes_since_leveling_ >= WEAR_LEVELING_PERIOD * lines_per_region_){
+      writes_since_leveling_ = 0;
+      LevelWear(now);
+    }
+  }
+
+}
+
+void NVMModel::LevelWear(const double& now){
+
+  auto hot_region = std::max_element(wear_.begin(), wear_.end()) - wear_.begin();
+  auto cold_region = std::min_element(wear_.begin(), wear_.end()) - wear_.begin();
+
+  // Not worth moving two regions for less than one region of wear
+  if(wear_[hot_region] - wear_[cold_region] < lines_per_region_){
+    return;
+  }
+
+  // Swap the contents of both regions
+  auto hot_logical_region = reverse_mapping_[hot_region];
+  auto cold_logical_region = reverse_mapping_[cold_region];
+  mapping_[hot_logical_region] = cold_region;
+  mapping_[cold_logical_region] = hot_region;
+  reverse_mapping_[hot_region] = cold_logical_region;
+  reverse_mapping_[cold_region] = hot_logical_region;
+
+  // Both regions are rewritten
+  for(auto region : {hot_region, cold_region}){
+    wear_[region] += lines_per_region_;
+    window_wear_[region] += lines_per_region_;
+  }
+  media_line_count_ += 2 * lines_per_region_;
+  media_free_ns_ = std::max(media_free_ns_, now) +
+      2 * lines_per_region_ * LINE_SIZE / write_bandwidth_;
+  swap_count_++;
+
+}
+
+double NVMModel::GetWriteAmplification() const{
+  if(host_byte_count_ == 0){
+    return 1;
+  }
+  return (double) media_line_count_ * LINE_SIZE / host_byte_count_;
+}
+
+double NVMModel::GetLifetime(const double& duration_ns) const{
+
+  auto max_wear = *std::max_element(window_wear_.begin(), window_wear_.end());
+  if(max_wear == 0 || duration_ns <= 0){
+    return std::numeric_limits<double>::infinity();
+  }
+
+  // Lines within a region wear evenly
+  double wear_rate = (double) max_wear / lines_per_region_ /
+      (duration_ns / (1000 * 1000 * 1000));
+  return endurance_ / wear_rate;
+}
+
+void NVMModel::ResetStats(){
+  host_byte_count_ = 0;
+  media_line_count_ = 0;
+  combined_line_count_ = 0;
+  partial_line_count_ = 0;
+  swap_count_ = 0;
+  stall_latency_ = 0;
+  std::fill(window_wear_.begin(), window_wear_.end(), 0);
+
+  // Logical time restarts with the stats
+  media_free_ns_ = 0;
+}
+
+std::ostream& operator<< (std::ostream& os, const NVMModel& nvm_model){
+
+  auto max_wear = *std::max_element(nvm_model.window_wear_.begin(),
+                                    nvm_model.window_wear_.end());
+  size_t worn_region_count = nvm_model.region_count_ -
+      std::count(nvm_model.window_wear_.begin(), nvm_model.window_wear_.end(), 0);
+
+  os << "NVM: \n";
+  os << std::setw(10) << "BUFFER" << " :: "
+      << "HOST BYTES: " << nvm_model.host_byte_count_ << " "
+      << "COMBINED LINES: " << nvm_model.combined_line_count_ << " "
+      << "PARTIAL LINES: " << nvm_model.partial_line_count_ << "\n";
+  os << std::setw(10) << "MEDIA" << " :: "
+      << "LINES: " << nvm_model.media_line_count_ << " "
+      << "STALL: " << nvm_model.stall_latency_ / (1000 * 1000 * 1000) << " s\n";
+  os << std::setw(10) << "WEAR" << " :: "
+      << "REGIONS WRITTEN: " << worn_region_count << "/" << nvm_model.region_count_ << " "
+      << "MAX REGION LINES: " << max_wear << " "
+      << "SWAPS: " << nvm_model.swap_count_ << "\n";
+  os << std::setw(10) << "WA" << " :: "
+      << std::fixed << std::setprecision(2)
+      << nvm_model.GetWriteAmplification() << "\n";
+  os.unsetf(std::ios_base::floatfield);
+  os << std::setprecision(6);
+
+  return os;
+}
+
+}  // End machine namespace
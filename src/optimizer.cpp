@@ -0,0 +1,410 @@
+// OPTIMIZER SOURCE
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "optimizer.h"
+#include "configuration.h"
+#include "device.h"
+#include "stats.h"
+#include "workload.h"
+
+namespace machine {
+
+extern Stats machine_stats;
+
+// Smallest operation budget of a successive halving rung
+const size_t MIN_RUNG_OPERATION_COUNT = 10000;
+
+// Number of candidates evaluated with the full budget
+const size_t FINAL_RUNG_CANDIDATE_COUNT = 16;
+
+bool HasDevice(const HierarchyType& hierarchy_type,
+               const DeviceType& device_type){
+
+  switch(hierarchy_type){
+    case HIERARCHY_TYPE_NVM:
+      return device_type == DEVICE_TYPE_NVM;
+    case HIERARCHY_TYPE_DRAM_NVM:
+      return device_type == DEVICE_TYPE_DRAM || device_type == DEVICE_TYPE_NVM;
+    case HIERARCHY_TYPE_DRAM_DISK:
+      return device_type == DEVICE_TYPE_DRAM || device_type == DEVICE_TYPE_DISK;
+    case HIERARCHY_TYPE_NVM_DISK:
+      return device_type == DEVICE_TYPE_NVM || device_type == DEVICE_TYPE_DISK;
+    case HIERARCHY_TYPE_DRAM_NVM_DISK:
+      return device_type != DEVICE_TYPE_CACHE;
+    default:
+      return false;
+  }
+
+}
+
+std::vector<Candidate> GetCandidates(const configuration& state){
+  std::vector<Candidate> candidates;
+
+  for(int hierarchy_itr = 1; hierarchy_itr <= HIERARCHY_TYPE_MAX; hierarchy_itr++){
+    auto hierarchy_type = (HierarchyType) hierarchy_itr;
+    auto nvm_exists = HasDevice(hierarchy_type, DEVICE_TYPE_NVM);
+
+    for(int size_itr = 1; size_itr <= SIZE_TYPE_MAX; size_itr++){
+      // Size ratio only matters with NVM
+      auto size_ratio_count = (nvm_exists == true) ? SIZE_RATIO_TYPE_MAX : 1;
+
+      for(int size_ratio_itr = 1; size_ratio_itr <= size_ratio_count; size_ratio_itr++){
+        for(int caching_itr = 1; caching_itr <= CACHING_TYPE_MAX; caching_itr++){
+          Candidate candidate;
+          candidate.hierarchy_type = hierarchy_type;
+          candidate.size_type = (SizeType) size_itr;
+          candidate.size_ratio_type = (SizeRatioType) size_ratio_itr;
+          candidate.caching_type = (CachingType) caching_itr;
+          candidate.cost = GetCandidateCost(candidate, state);
+          candidates.push_back(candidate);
+        }
+      }
+    }
+  }
+
+  return candidates;
+}
+
+double GetCandidateCost(const Candidate& candidate,
+                        const configuration& state){
+
+  configuration candidate_state = state;
+  candidate_state.hierarchy_type = candidate.hierarchy_type;
+  candidate_state.size_type = candidate.size_type;
+  candidate_state.size_ratio_type = candidate.size_ratio_type;
+
+  auto last_device_type = GetLastDevice(candidate.hierarchy_type);
+  double cost = 0;
+  for(auto entry : state.tier_prices){
+    auto device_type = entry.first;
+    if(HasDevice(candidate.hierarchy_type, device_type) == false){
+      continue;
+    }
+
+    auto device_size = DeviceFactory::GetDeviceSize(device_type,
+                                                    candidate_state,
+                                                    last_device_type);
+    double device_gb = (double) device_size * DEFAULT_BLOCK_SIZE;
+    device_gb /= (1024 * 1024 * 1024);
+    cost += device_gb * entry.second;
+  }
+
+  return cost;
+}
+
+bool IsFeasible(const Candidate& candidate,
+                const configuration& state){
+
+  if(candidate.throughput <= 0){
+    return false;
+  }
+  if(state.slo_throughput > 0 && candidate.throughput < state.slo_throughput){
+    return false;
+  }
+  if(state.slo_latency > 0 && candidate.latency > state.slo_latency){
+    return false;
+  }
+
+  return true;
+}
+
+bool Dominates(const Candidate& first, const Candidate& second){
+  bool no_worse = (first.cost <= second.cost &&
+      first.throughput >= second.throughput);
+  bool better = (first.cost < second.cost ||
+      first.throughput > second.throughput);
+  return no_worse && better;
+}
+
+std::vector<Candidate> GetParetoFrontier(const std::vector<Candidate>& candidates){
+  std::vector<Candidate> frontier;
+
+  for(auto& candidate : candidates){
+    bool dominated = false;
+    for(auto& other : candidates){
+      if(Dominates(other, candidate) == true){
+        dominated = true;
+        break;
+      }
+    }
+    if(dominated == false){
+      frontier.push_back(candidate);
+    }
+  }
+
+  std::sort(frontier.begin(), frontier.end(),
+            [](const Candidate& first, const Candidate& second){
+    return first.cost < second.cost;
+  });
+
+  return frontier;
+}
+
+// Pareto rank of each candidate (0 == frontier)
+std::vector<size_t> GetParetoRanks(const std::vector<Candidate>& candidates){
+  std::vector<size_t> ranks(candidates.size(), 0);
+
+  for(size_t candidate_itr = 0; candidate_itr < candidates.size(); candidate_itr++){
+    for(auto& other : candidates){
+      if(Dominates(other, candidates[candidate_itr]) == true){
+        ranks[candidate_itr]++;
+      }
+    }
+  }
+
+  return ranks;
+}
+
+// What a candidate run reports back to the parent
+struct CandidateResult {
+
+  // ops/s
+  double throughput = 0;
+
+  // op latency at the SLO percentile (ns)
+  double latency = 0;
+
+};
+
+// Latency of all trace ops at the given percentile, from the histograms
+static double GetLatencyPercentile(const double& percentile){
+  Histogram histogram;
+  for(size_t operation_itr = 0; operation_itr < OPERATION_TYPE_COUNT; operation_itr++){
+    histogram.Merge(machine_stats.GetLatencyHistogram((OperationType) operation_itr));
+  }
+  return histogram.GetPercentile(percentile);
+}
+
+// Run one candidate in a forked child and return its throughput and latency
+pid_t StartCandidate(const Candidate& candidate,
+                     configuration& state,
+                     const size_t& operation_count,
+                     int& result_fd){
+
+  int fds[2];
+  if(pipe(fds) != 0){
+    perror("pipe");
+    exit(EXIT_FAILURE);
+  }
+
+  auto pid = fork();
+  if(pid < 0){
+    perror("fork");
+    exit(EXIT_FAILURE);
+  }
+
+  // Child
+  if(pid == 0){
+    close(fds[0]);
+    if(freopen("/dev/null", "w", stdout) == NULL){
+      _exit(EXIT_FAILURE);
+    }
+
+    state.hierarchy_type = candidate.hierarchy_type;
+    state.size_type = candidate.size_type;
+    state.size_ratio_type = candidate.size_ratio_type;
+    state.caching_type = candidate.caching_type;
+    state.operation_count = operation_count;
+    ConstructDeviceList(state);
+
+    CandidateResult result;
+    result.throughput = MachineHelper();
+    result.latency = GetLatencyPercentile(state.slo_percentile);
+    auto status = write(fds[1], &result, sizeof(result));
+    close(fds[1]);
+    _exit((status == sizeof(result)) ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+
+  // Parent
+  close(fds[1]);
+  result_fd = fds[0];
+  return pid;
+}
+
+void EvaluateCandidates(std::vector<Candidate>& candidates,
+                        configuration& state,
+                        const size_t& operation_count){
+
+  std::map<pid_t, std::pair<size_t, int>> running;
+  size_t next_candidate = 0;
+
+  while(next_candidate < candidates.size() || running.empty() == false){
+
+    // Keep all job slots busy
+    while(next_candidate < candidates.size() &&
+        running.size() < state.optimizer_jobs){
+      int result_fd = -1;
+      auto pid = StartCandidate(candidates[next_candidate],
+                                state,
+                                operation_count,
+                                result_fd);
+      running[pid] = std::make_pair(next_candidate, result_fd);
+      next_candidate++;
+    }
+
+    // Reap a finished child
+    int status = 0;
+    auto pid = waitpid(-1, &status, 0);
+    auto entry = running.find(pid);
+    if(entry == running.end()){
+      continue;
+    }
+
+    auto& candidate = candidates[entry->second.first];
+    auto result_fd = entry->second.second;
+    CandidateResult result;
+    if(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS){
+      if(read(result_fd, &result, sizeof(result)) != sizeof(result)){
+        result = CandidateResult();
+      }
+    }
+    close(result_fd);
+    running.erase(entry);
+
+    // The latency SLO bounds the tail, not the mean time per op
+    candidate.throughput = result.throughput;
+    candidate.latency = result.latency;
+  }
+
+}
+
+void PrintCandidates(const std::string& title,
+                     const std::vector<Candidate>& candidates,
+                     const configuration& state){
+
+  std::stringstream latency_label;
+  latency_label << " P" << state.slo_percentile << " LATENCY: ";
+
+  std::cout << title << "\n";
+  for(auto& candidate : candidates){
+    std::cout << std::setw(15) << HierarchyTypeToString(candidate.hierarchy_type)
+        << std::setw(8) << SizeTypeToString(candidate.size_type)
+        << std::setw(9) << SizeRatioTypeToString(candidate.size_ratio_type)
+        << std::setw(6) << CachingTypeToString(candidate.caching_type)
+        << " :: COST: " << std::setw(10) << std::fixed << std::setprecision(2)
+        << candidate.cost << " $"
+        << " THROUGHPUT: " << std::setw(12) << candidate.throughput << " (OPS/S)"
+        << latency_label.str() << std::setw(10) << candidate.latency << " (NS)"
+        << ((IsFeasible(candidate, state) == true) ? "" : " [SLO MISS]")
+        << "\n";
+  }
+
+}
+
+void WriteFrontier(const std::vector<Candidate>& frontier,
+                   const configuration& state){
+
+  if(state.summary_file.empty() == true){
+    return;
+  }
+
+  std::ofstream out(state.summary_file);
+  for(auto& candidate : frontier){
+    out << candidate.hierarchy_type << " "
+        << candidate.size_type << " "
+        << candidate.size_ratio_type << " "
+        << candidate.caching_type << " "
+        << std::fixed << std::setprecision(2)
+        << candidate.cost << " "
+        << candidate.throughput << "\n";
+  }
+  out.flush();
+
+}
+
+void RunOptimizer(configuration& state){
+
+  if(state.emulate == true){
+    std::cout << "Optimizer does not support emulation \n";
+    exit(EXIT_FAILURE);
+  }
+  if(state.operation_count == 0){
+    std::cout << "Optimizer requires an operation count \n";
+    exit(EXIT_FAILURE);
+  }
+
+  auto candidates = GetCandidates(state);
+
+  // Figure out the successive halving rungs
+  size_t rung_count = 1;
+  size_t candidate_count = candidates.size();
+  while(candidate_count > FINAL_RUNG_CANDIDATE_COUNT){
+    candidate_count = (candidate_count + 1)/2;
+    rung_count++;
+  }
+
+  std::cout << "+++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
+  std::cout << "OPTIMIZER :: CANDIDATES: " << candidates.size()
+      << " RUNGS: " << rung_count
+      << " JOBS: " << state.optimizer_jobs << "\n";
+
+  for(size_t rung_itr = 0; rung_itr < rung_count; rung_itr++){
+    auto shift = rung_count - 1 - rung_itr;
+    auto operation_count = std::max(state.operation_count >> shift,
+                                    MIN_RUNG_OPERATION_COUNT);
+    operation_count = std::min(operation_count, state.operation_count);
+
+    std::cout << "RUNG " << rung_itr << " :: CANDIDATES: " << candidates.size()
+        << " OPERATION COUNT: " << operation_count << "\n";
+    EvaluateCandidates(candidates, state, operation_count);
+
+    if(rung_itr == rung_count - 1){
+      break;
+    }
+
+    // Keep the better half: feasible first, then by Pareto rank
+    auto ranks = GetParetoRanks(candidates);
+    std::vector<size_t> order(candidates.size());
+    for(size_t candidate_itr = 0; candidate_itr < order.size(); candidate_itr++){
+      order[candidate_itr] = candidate_itr;
+    }
+    std::sort(order.begin(), order.end(),
+              [&](const size_t& first, const size_t& second){
+      auto first_feasible = IsFeasible(candidates[first], state);
+      auto second_feasible = IsFeasible(candidates[second], state);
+      if(first_feasible != second_feasible){
+        return first_feasible;
+      }
+      if(ranks[first] != ranks[second]){
+        return ranks[first] < ranks[second];
+      }
+      return candidates[first].throughput > candidates[second].throughput;
+    });
+
+    std::vector<Candidate> survivors;
+    for(size_t order_itr = 0; order_itr < (order.size() + 1)/2; order_itr++){
+      survivors.push_back(candidates[order[order_itr]]);
+    }
+    candidates = survivors;
+  }
+
+  std::cout << "+++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
+  PrintCandidates("FINAL CANDIDATES: ", candidates, state);
+
+  std::vector<Candidate> feasible_candidates;
+  for(auto& candidate : candidates){
+    if(IsFeasible(candidate, state) == true){
+      feasible_candidates.push_back(candidate);
+    }
+  }
+
+  auto frontier = GetParetoFrontier(feasible_candidates);
+  std::cout << "+++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
+  PrintCandidates("PARETO FRONTIER (COST vs THROUGHPUT): ", frontier, state);
+  std::cout << "+++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
+
+  WriteFrontier(frontier, state);
+
+}
+
+}  // End machine namespace
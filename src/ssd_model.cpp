@@ -0,0 +1,260 @@
+// SSD MODEL SOURCE
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include "ssd_model.h"
+
+namespace machine {
+
+const uint32_t SSDModel::INVALID_PAGE;
+
+const size_t SSDModel::GC_THRESHOLD;
+
+SSDModel::SSDModel(const size_t& logical_page_count,
+                   const double& over_provisioning,
+                   const size_t& pages_per_block,
+                   const GcPolicyType& gc_policy_type)
+: logical_page_count_(logical_page_count),
+  pages_per_block_(pages_per_block),
+  gc_policy_type_(gc_policy_type){
+
+  // Spare blocks for over-provisioning and the two active blocks
+  size_t physical_page_count = std::ceil(logical_page_count * (1 + over_provisioning));
+  size_t block_count = (physical_page_count + pages_per_block - 1)/pages_per_block;
+  block_count += GC_THRESHOLD + 2;
+
+  mapping_.resize(logical_page_count_, INVALID_PAGE);
+  reverse_mapping_.resize(block_count * pages_per_block_, INVALID_PAGE);
+  blocks_.resize(block_count);
+
+  for(size_t block_itr = block_count; block_itr > 0; block_itr--){
+    free_blocks_.push_back(block_itr - 1);
+  }
+
+  host_block_ = free_blocks_.back();
+  free_blocks_.pop_back();
+  gc_block_ = free_blocks_.back();
+  free_blocks_.pop_back();
+
+}
+
+void SSDModel::SetLatencies(const double& read_latency,
+                            const double& program_latency,
+                            const double& erase_latency){
+  read_latency_ = read_latency;
+  program_latency_ = program_latency;
+  erase_latency_ = erase_latency;
+}
+
+void SSDModel::InvalidatePage(const size_t& physical_page){
+  reverse_mapping_[physical_page] = INVALID_PAGE;
+  blocks_[physical_page / pages_per_block_].valid_count--;
+}
+
+size_t SSDModel::AllocatePage(const bool& is_gc, double& gc_latency){
+
+  auto& active_block = is_gc ? gc_block_ : host_block_;
+
+  if(blocks_[active_block].write_pointer == pages_per_block_){
+    // Host writes wait for garbage collection
+    if(is_gc == false){
+      while(free_blocks_.size() < GC_THRESHOLD){
+        gc_latency += CollectGarbage();
+      }
+    }
+
+    active_block = free_blocks_.back();
+    free_blocks_.pop_back();
+  }
+
+  auto& block = blocks_[active_block];
+  return active_block * pages_per_block_ + block.write_pointer++;
+}
+
+size_t SSDModel::SelectVictim() const{
+
+  size_t victim = blocks_.size();
+  double best_score = -1;
+
+  for(size_t block_itr = 0; block_itr < blocks_.size(); block_itr++){
+    auto& block = blocks_[block_itr];
+
+    // Only closed blocks are candidates
+    if(block.write_pointer != pages_per_block_ ||
+        block_itr == host_block_ ||
+        block_itr == gc_block_){
+      continue;
+    }
+
+    double utilization = (double) block.valid_count / pages_per_block_;
+    double score = 0;
+    switch(gc_policy_type_){
+      case GC_POLICY_TYPE_GREEDY:
+        score = 1 - utilization;
+        break;
+
+      case GC_POLICY_TYPE_COST_BENEFIT: {
+        // benefit / cost = age * (1 - u) / 2u
+        double age = clock_ - block.last_write + 1;
+        if(block.valid_count == 0){
+          return block_itr;
+        }
+        score = age * (1 - utilization) / (2 * utilization);
+        break;
+      }
+
+      default: {
+        std::cout << "SelectVictim: Get invalid gc policy type";
+        exit(EXIT_FAILURE);
+      }
+    }
+
+    if(score > best_score){
+      best_score = score;
+      victim = block_itr;
+    }
+  }
+
+  return victim;
+}
+
+double SSDModel::CollectGarbage(){
+
+  auto victim = SelectVictim();
+  if(victim == blocks_.size() ||
+      blocks_[victim].valid_count == pages_per_block_){
+    std::cout << "SSD out of space: no reclaimable erase block\n";
+    exit(EXIT_FAILURE);
+  }
+
+  double latency = 0;
+  gc_count_++;
+
+  // Relocate valid pages; they are as old as the data of the victim
+  auto victim_last_write = blocks_[victim].last_write;
+  auto first_page = victim * pages_per_block_;
+  for(size_t page_itr = first_page;
+      page_itr < first_page + pages_per_block_;
+      page_itr++){
+    auto logical_page = reverse_mapping_[page_itr];
+    if(logical_page == INVALID_PAGE){
+      continue;
+    }
+
+    auto physical_page = AllocatePage(true, latency);
+    InvalidatePage(page_itr);
+    mapping_[logical_page] = physical_page;
+    reverse_mapping_[physical_page] = logical_page;
+    auto& gc_block = blocks_[physical_page / pages_per_block_];
+    gc_block.valid_count++;
+    gc_block.last_write = std::max(gc_block.last_write, victim_last_write);
+
+    flash_page_count_++;
+    latency += read_latency_ + program_latency_;
+  }
+
+  // Erase
+  // An erased block holds no data, so it has no age either
+  auto& block = blocks_[victim];
+  block.write_pointer = 0;
+  block.last_write = 0;
+  block.erase_count++;
+  free_blocks_.push_back(victim);
+  latency += erase_latency_;
+
+  gc_latency_ += latency;
+  return latency;
+}
+
+double SSDModel::Write(const size_t& logical_page){
+
+  clock_++;
+  host_page_count_++;
+  flash_page_count_++;
+
+  // Out of place update
+  auto current_page = mapping_[logical_page];
+  if(current_page != INVALID_PAGE){
+    InvalidatePage(current_page);
+  }
+
+  double gc_latency = 0;
+  auto physical_page = AllocatePage(false, gc_latency);
+  mapping_[logical_page] = physical_page;
+  reverse_mapping_[physical_page] = logical_page;
+
+  auto& block = blocks_[physical_page / pages_per_block_];
+  block.valid_count++;
+  block.last_write = clock_;
+
+  return gc_latency;
+}
+
+void SSDModel::Trim(const size_t& logical_page){
+
+  auto current_page = mapping_[logical_page];
+  if(current_page == INVALID_PAGE){
+    return;
+  }
+
+  InvalidatePage(current_page);
+  mapping_[logical_page] = INVALID_PAGE;
+  trim_count_++;
+
+}
+
+void SSDModel::Precondition(){
+
+  for(size_t logical_page = 0; logical_page < logical_page_count_; logical_page++){
+    Write(logical_page);
+  }
+
+  ResetStats();
+
+}
+
+double SSDModel::GetWriteAmplification() const{
+  if(host_page_count_ == 0){
+    return 1;
+  }
+  return (double) flash_page_count_ / host_page_count_;
+}
+
+void SSDModel::ResetStats(){
+  host_page_count_ = 0;
+  flash_page_count_ = 0;
+  trim_count_ = 0;
+  gc_count_ = 0;
+  gc_latency_ = 0;
+}
+
+std::ostream& operator<< (std::ostream& os, const SSDModel& ssd_model){
+
+  size_t max_erase_count = 0;
+  for(auto& block : ssd_model.blocks_){
+    max_erase_count = std::max(max_erase_count, block.erase_count);
+  }
+
+  os << "SSD: \n";
+  os << std::setw(10) << "FTL" << " :: "
+      << "HOST PAGES: " << ssd_model.host_page_count_ << " "
+      << "FLASH PAGES: " << ssd_model.flash_page_count_ << " "
+      << "TRIMS: " << ssd_model.trim_count_ << "\n";
+  os << std::setw(10) << "GC" << " :: "
+      << GcPolicyTypeToString(ssd_model.gc_policy_type_) << " "
+      << "ERASES: " << ssd_model.gc_count_ << " "
+      << "TIME: " << ssd_model.gc_latency_ / (1000 * 1000 * 1000) << " s "
+      << "MAX BLOCK ERASES: " << max_erase_count << "\n";
+  os << std::setw(10) << "WA" << " :: "
+      << std::fixed << std::setprecision(2)
+      << ssd_model.GetWriteAmplification() << "\n";
+  os.unsetf(std::ios_base::floatfield);
+  os << std::setprecision(6);
+
+  return os;
+}
+
+}  // End machine namespace
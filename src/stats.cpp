@@ -4,6 +4,8 @@
 
 #include <ostream>
 #include <iomanip>
+#include <iterator>
+#include <algorithm>
 
 namespace machine {
 
@@ -12,7 +14,23 @@ void Stats::Reset(){
   write_ops.clear();
   flush_ops.clear();
   sync_ops.clear();
+  read_bytes.clear();
+  write_bytes.clear();
+  local_ops.clear();
+  remote_ops.clear();
+  migration_ops.clear();
   movement_ops.clear();
+  prefetch_ops.clear();
+
+  for(auto& device_pattern_ops : pattern_ops){
+    std::fill(std::begin(device_pattern_ops), std::end(device_pattern_ops), 0);
+  }
+
+  for(auto& operation_histograms : latency_histograms){
+    for(auto& histogram : operation_histograms){
+      histogram.Reset();
+    }
+  }
 
   read_ops[DeviceType::DEVICE_TYPE_CACHE] = 0;
   read_ops[DeviceType::DEVICE_TYPE_DRAM] = 0;
@@ -34,6 +52,16 @@ void Stats::Reset(){
   sync_ops[DeviceType::DEVICE_TYPE_NVM] = 0;
   sync_ops[DeviceType::DEVICE_TYPE_DISK] = 0;
 
+  read_bytes[DeviceType::DEVICE_TYPE_CACHE] = 0;
+  read_bytes[DeviceType::DEVICE_TYPE_DRAM] = 0;
+  read_bytes[DeviceType::DEVICE_TYPE_NVM] = 0;
+  read_bytes[DeviceType::DEVICE_TYPE_DISK] = 0;
+
+  write_bytes[DeviceType::DEVICE_TYPE_CACHE] = 0;
+  write_bytes[DeviceType::DEVICE_TYPE_DRAM] = 0;
+  write_bytes[DeviceType::DEVICE_TYPE_NVM] = 0;
+  write_bytes[DeviceType::DEVICE_TYPE_DISK] = 0;
+
   movement_ops[DeviceType::DEVICE_TYPE_INVALID][DeviceType::DEVICE_TYPE_CACHE] = 0;
   movement_ops[DeviceType::DEVICE_TYPE_CACHE][DeviceType::DEVICE_TYPE_DRAM] = 0;
   movement_ops[DeviceType::DEVICE_TYPE_CACHE][DeviceType::DEVICE_TYPE_NVM] = 0;
@@ -69,10 +97,82 @@ void Stats::IncrementSyncCount(DeviceType device_type){
   sync_ops[device_type]++;
 }
 
+void Stats::IncrementReadBytes(DeviceType device_type, size_t byte_count){
+  read_bytes[device_type] += byte_count;
+}
+
+void Stats::IncrementWriteBytes(DeviceType device_type, size_t byte_count){
+  write_bytes[device_type] += byte_count;
+}
+
+void Stats::IncrementNumaHitCount(DeviceType device_type, bool is_local){
+  if(is_local == true){
+    local_ops[device_type]++;
+  }
+  else {
+    remote_ops[device_type]++;
+  }
+}
+
+void Stats::IncrementNumaMigrationCount(DeviceType device_type){
+  migration_ops[device_type]++;
+}
+
+void Stats::IncrementPrefetchCount(DeviceType device_type){
+  prefetch_ops[device_type]++;
+}
+
 void Stats::IncrementOpCount(DeviceType source_device_type, DeviceType destination_device_type){
   movement_ops[source_device_type][destination_device_type]++;
 }
 
+Histogram Stats::GetLatencyHistogram(OperationType operation_type) const{
+  Histogram operation_histogram;
+  for(auto& histogram : latency_histograms[operation_type]){
+    operation_histogram.Merge(histogram);
+  }
+  return operation_histogram;
+}
+
+void WriteLatency(std::ostream& os,
+                  const std::string& operation,
+                  const std::string& device,
+                  const Histogram& histogram){
+  os << std::fixed << std::setprecision(2)
+      << operation << " " << device << " "
+      << histogram.GetCount() << " "
+      << histogram.GetMean() << " "
+      << histogram.GetPercentile(50) << " "
+      << histogram.GetPercentile(99) << " "
+      << histogram.GetPercentile(99.9) << " "
+      << histogram.GetMax() << "\n";
+}
+
+void Stats::WriteLatencies(std::ostream& os) const{
+
+  os << "OPERATION DEVICE COUNT MEAN P50 P99 P999 MAX\n";
+  for(size_t operation_itr = 0;
+      operation_itr < OPERATION_TYPE_COUNT;
+      operation_itr++){
+    auto operation_type = (OperationType) operation_itr;
+    auto operation = OperationTypeToString(operation_type);
+
+    for(size_t device_itr = 0; device_itr < DEVICE_TYPE_COUNT; device_itr++){
+      auto& histogram = latency_histograms[operation_type][device_itr];
+      if(histogram.GetCount() != 0){
+        WriteLatency(os, operation,
+                     DeviceTypeToString((DeviceType) device_itr), histogram);
+      }
+    }
+
+    auto operation_histogram = GetLatencyHistogram(operation_type);
+    if(operation_histogram.GetCount() != 0){
+      WriteLatency(os, operation, "ALL", operation_histogram);
+    }
+  }
+
+}
+
 std::ostream& operator<< (std::ostream& os, const Stats& stats){
 
   os << "READ OPS: \n";
@@ -90,6 +190,61 @@ std::ostream& operator<< (std::ostream& os, const Stats& stats){
     os << std::setw(10) << DeviceTypeToString(entry.first) << " :: " << entry.second/1000 << " K ops\n";
   }
 
+  os << "READ BYTES: \n";
+  for(auto entry: stats.read_bytes){
+    os << std::setw(10) << DeviceTypeToString(entry.first) << " :: " << entry.second/(1024 * 1024) << " MB\n";
+  }
+
+  os << "WRITE BYTES: \n";
+  for(auto entry: stats.write_bytes){
+    os << std::setw(10) << DeviceTypeToString(entry.first) << " :: " << entry.second/(1024 * 1024) << " MB\n";
+  }
+
+  if(stats.local_ops.empty() == false || stats.remote_ops.empty() == false){
+    os << "NUMA HITS: \n";
+    for(auto device_type : {DeviceType::DEVICE_TYPE_DRAM, DeviceType::DEVICE_TYPE_NVM}){
+      auto local_entry = stats.local_ops.find(device_type);
+      auto remote_entry = stats.remote_ops.find(device_type);
+      auto migration_entry = stats.migration_ops.find(device_type);
+      size_t local = (local_entry != stats.local_ops.end()) ? local_entry->second : 0;
+      size_t remote = (remote_entry != stats.remote_ops.end()) ? remote_entry->second : 0;
+      size_t migrations = (migration_entry != stats.migration_ops.end()) ? migration_entry->second : 0;
+      if(local + remote == 0){
+        continue;
+      }
+      os << std::setw(10) << DeviceTypeToString(device_type) << " :: "
+          << "LOCAL: " << local << " hits "
+          << "REMOTE: " << remote << " hits "
+          << "(" << (remote * 100)/(local + remote) << " % remote) "
+          << "MIGRATIONS: " << migrations << " ops\n";
+    }
+  }
+
+  os << "PATTERN OPS: \n";
+  for(size_t device_itr = 0; device_itr < DEVICE_TYPE_COUNT; device_itr++){
+    auto& device_pattern_ops = stats.pattern_ops[device_itr];
+    size_t total = 0;
+    for(auto count : device_pattern_ops){
+      total += count;
+    }
+    if(total == 0){
+      continue;
+    }
+    os << std::setw(10) << DeviceTypeToString((DeviceType) device_itr) << " ::";
+    for(size_t pattern_itr = 0; pattern_itr < PATTERN_TYPE_COUNT; pattern_itr++){
+      os << " " << PatternTypeToString((PatternType) pattern_itr) << ": "
+          << (device_pattern_ops[pattern_itr] * 100)/total << " %";
+    }
+    os << "\n";
+  }
+
+  if(stats.prefetch_ops.empty() == false){
+    os << "PREFETCH OPS: \n";
+    for(auto entry: stats.prefetch_ops){
+      os << std::setw(10) << DeviceTypeToString(entry.first) << " :: " << entry.second << " ops\n";
+    }
+  }
+
   os << "MOVEMENT OPS: \n";
   for(auto device_map: stats.movement_ops){
     for(auto entry: device_map.second){
@@ -100,6 +255,40 @@ std::ostream& operator<< (std::ostream& os, const Stats& stats){
     }
   }
 
+  os << "LATENCY (ns): \n";
+  for(size_t operation_itr = 0;
+      operation_itr < OPERATION_TYPE_COUNT;
+      operation_itr++){
+    auto operation_type = (OperationType) operation_itr;
+    for(size_t device_itr = 0; device_itr <= DEVICE_TYPE_COUNT; device_itr++){
+
+      // Last row covers all devices
+      Histogram histogram;
+      std::string device = "ALL";
+      if(device_itr < DEVICE_TYPE_COUNT){
+        histogram = stats.latency_histograms[operation_type][device_itr];
+        device = DeviceTypeToString((DeviceType) device_itr);
+      }
+      else {
+        histogram = stats.GetLatencyHistogram(operation_type);
+      }
+
+      if(histogram.GetCount() == 0){
+        continue;
+      }
+      os << std::fixed << std::setprecision(0)
+          << std::setw(6) << OperationTypeToString(operation_type)
+          << std::setw(8) << device << " :: "
+          << "P50: " << histogram.GetPercentile(50) << " "
+          << "P99: " << histogram.GetPercentile(99) << " "
+          << "P99.9: " << histogram.GetPercentile(99.9) << " "
+          << "MAX: " << histogram.GetMax() << " "
+          << "(" << histogram.GetCount() << " ops)\n";
+    }
+  }
+  os.unsetf(std::ios_base::floatfield);
+  os << std::setprecision(6);
+
   return os;
 }
 
@@ -9,10 +9,12 @@ namespace machine {
 StorageCache::StorageCache(DeviceType device_type,
                            CachingType caching_type,
                            size_t capacity,
+                           size_t block_size,
                            double clean_fraction) :
                            device_type_(device_type),
                            caching_type_(caching_type),
                            capacity_(capacity),
+                           block_size_(block_size),
                            clean_fraction_(clean_fraction){
 
   //std::cout << "STORAGE CACHE CAPACITY: " << capacity << "\n";
@@ -35,6 +37,26 @@ StorageCache::StorageCache(DeviceType device_type,
       arc_cache = new Cache<int, int, ARCCachePolicy<int, int>>(capacity, clean_fraction);
       break;
 
+    case CACHING_TYPE_CLOCK:
+      clock_cache = new Cache<int, int, CLOCKCachePolicy<int, int>>(capacity, clean_fraction);
+      break;
+
+    case CACHING_TYPE_CLOCK_PRO:
+      clock_pro_cache = new Cache<int, int, CLOCKProCachePolicy<int, int>>(capacity, clean_fraction);
+      break;
+
+    case CACHING_TYPE_TWO_Q:
+      two_q_cache = new Cache<int, int, TwoQCachePolicy<int, int>>(capacity, clean_fraction);
+      break;
+
+    case CACHING_TYPE_LIRS:
+      lirs_cache = new Cache<int, int, LIRSCachePolicy<int, int>>(capacity, clean_fraction);
+      break;
+
+    case CACHING_TYPE_W_TINY_LFU:
+      w_tiny_lfu_cache = new Cache<int, int, WTinyLFUCachePolicy<int, int>>(capacity, clean_fraction);
+      break;
+
     case CACHING_TYPE_INVALID:
     default:
       exit(EXIT_FAILURE);
@@ -64,6 +86,26 @@ Block StorageCache::Put(const int& key, const int& value){
       victim = arc_cache->Put(key, value);
       break;
 
+    case CACHING_TYPE_CLOCK:
+      victim = clock_cache->Put(key, value);
+      break;
+
+    case CACHING_TYPE_CLOCK_PRO:
+      victim = clock_pro_cache->Put(key, value);
+      break;
+
+    case CACHING_TYPE_TWO_Q:
+      victim = two_q_cache->Put(key, value);
+      break;
+
+    case CACHING_TYPE_LIRS:
+      victim = lirs_cache->Put(key, value);
+      break;
+
+    case CACHING_TYPE_W_TINY_LFU:
+      victim = w_tiny_lfu_cache->Put(key, value);
+      break;
+
     case CACHING_TYPE_INVALID:
     default:
       exit(EXIT_FAILURE);
@@ -99,6 +141,68 @@ int StorageCache::Get(const int& key) const{
     case CACHING_TYPE_ARC:
       return arc_cache->Get(key);
 
+    case CACHING_TYPE_CLOCK:
+      return clock_cache->Get(key);
+
+    case CACHING_TYPE_CLOCK_PRO:
+      return clock_pro_cache->Get(key);
+
+    case CACHING_TYPE_TWO_Q:
+      return two_q_cache->Get(key);
+
+    case CACHING_TYPE_LIRS:
+      return lirs_cache->Get(key);
+
+    case CACHING_TYPE_W_TINY_LFU:
+      return w_tiny_lfu_cache->Get(key);
+
+    case CACHING_TYPE_INVALID:
+    default:
+      exit(EXIT_FAILURE);
+  }
+
+}
+
+void StorageCache::Erase(const int& key){
+
+  switch(caching_type_){
+
+    case CACHING_TYPE_FIFO:
+      fifo_cache->Erase(key);
+      break;
+
+    case CACHING_TYPE_LFU:
+      lfu_cache->Erase(key);
+      break;
+
+    case CACHING_TYPE_LRU:
+      lru_cache->Erase(key);
+      break;
+
+    case CACHING_TYPE_ARC:
+      arc_cache->Erase(key);
+      break;
+
+    case CACHING_TYPE_CLOCK:
+      clock_cache->Erase(key);
+      break;
+
+    case CACHING_TYPE_CLOCK_PRO:
+      clock_pro_cache->Erase(key);
+      break;
+
+    case CACHING_TYPE_TWO_Q:
+      two_q_cache->Erase(key);
+      break;
+
+    case CACHING_TYPE_LIRS:
+      lirs_cache->Erase(key);
+      break;
+
+    case CACHING_TYPE_W_TINY_LFU:
+      w_tiny_lfu_cache->Erase(key);
+      break;
+
     case CACHING_TYPE_INVALID:
     default:
       exit(EXIT_FAILURE);
@@ -122,6 +226,21 @@ size_t StorageCache::GetSize() const{
     case CACHING_TYPE_ARC:
       return arc_cache->GetSize();
 
+    case CACHING_TYPE_CLOCK:
+      return clock_cache->GetSize();
+
+    case CACHING_TYPE_CLOCK_PRO:
+      return clock_pro_cache->GetSize();
+
+    case CACHING_TYPE_TWO_Q:
+      return two_q_cache->GetSize();
+
+    case CACHING_TYPE_LIRS:
+      return lirs_cache->GetSize();
+
+    case CACHING_TYPE_W_TINY_LFU:
+      return w_tiny_lfu_cache->GetSize();
+
     case CACHING_TYPE_INVALID:
     default:
       exit(EXIT_FAILURE);
@@ -136,7 +255,7 @@ std::ostream& operator<< (std::ostream& stream,
   std::cout << "[" << DeviceTypeToString(cache.device_type_) << "] ";
   std::cout << "[" << CachingTypeToString(cache.caching_type_) <<"] ";
 
-  PrintCapacity(cache.capacity_);
+  PrintCapacity(cache.capacity_, cache.block_size_);
 
   switch(cache.caching_type_){
 
@@ -156,28 +275,25 @@ std::ostream& operator<< (std::ostream& stream,
       cache.arc_cache->Print();
       return stream;
 
-    case CACHING_TYPE_INVALID:
-    default:
-      exit(EXIT_FAILURE);
-  }
-
-}
-
-bool StorageCache::IsSequential(const size_t& next){
-
-  switch(caching_type_){
+    case CACHING_TYPE_CLOCK:
+      cache.clock_cache->Print();
+      return stream;
 
-    case CACHING_TYPE_FIFO:
-      return fifo_cache->IsSequential(next);
+    case CACHING_TYPE_CLOCK_PRO:
+      cache.clock_pro_cache->Print();
+      return stream;
 
-    case CACHING_TYPE_LFU:
-      return lfu_cache->IsSequential(next);
+    case CACHING_TYPE_TWO_Q:
+      cache.two_q_cache->Print();
+      return stream;
 
-    case CACHING_TYPE_LRU:
-      return lru_cache->IsSequential(next);
+    case CACHING_TYPE_LIRS:
+      cache.lirs_cache->Print();
+      return stream;
 
-    case CACHING_TYPE_ARC:
-      return arc_cache->IsSequential(next);
+    case CACHING_TYPE_W_TINY_LFU:
+      cache.w_tiny_lfu_cache->Print();
+      return stream;
 
     case CACHING_TYPE_INVALID:
     default:
@@ -0,0 +1,109 @@
+// STREAM DETECTOR SOURCE
+
+#include "stream_detector.h"
+
+namespace machine {
+
+StreamDetector::StreamDetector(size_t stream_count,
+                               size_t max_stride)
+: streams_(stream_count),
+  max_stride_(max_stride){
+}
+
+PatternType StreamDetector::Classify(const size_t& block_id){
+
+  clock_++;
+
+  size_t match_itr = streams_.size();
+  size_t nearest_itr = streams_.size();
+  size_t nearest_distance = max_stride_ + 1;
+  long nearest_stride = 0;
+
+  for(size_t stream_itr = 0; stream_itr < streams_.size(); stream_itr++){
+    auto& stream = streams_[stream_itr];
+    if(stream.valid == false){
+      continue;
+    }
+
+    // Compare unsigned blocks without wrapping around
+    bool is_forward = (block_id >= stream.last_block);
+    size_t distance = is_forward ? (block_id - stream.last_block) :
+        (stream.last_block - block_id);
+    if(distance > max_stride_){
+      continue;
+    }
+    long stride = is_forward ? (long) distance : -(long) distance;
+
+    // Stream continues with the same stride
+    if(stride != 0 && stride == stream.stride){
+      match_itr = stream_itr;
+      break;
+    }
+
+    if(distance < nearest_distance){
+      nearest_itr = stream_itr;
+      nearest_distance = distance;
+      nearest_stride = stride;
+    }
+  }
+
+  PatternType pattern_type = PATTERN_TYPE_RANDOM;
+  size_t stream_itr = match_itr;
+
+  if(match_itr != streams_.size()){
+    auto stride = streams_[match_itr].stride;
+    if(stride == 1 || stride == -1){
+      pattern_type = PATTERN_TYPE_SEQUENTIAL;
+    }
+    else {
+      pattern_type = PATTERN_TYPE_STRIDED;
+    }
+  }
+  else if(nearest_itr != streams_.size()){
+    // Adjacent blocks are sequential right away, other strides need a repeat
+    stream_itr = nearest_itr;
+    if(nearest_distance == 1){
+      pattern_type = PATTERN_TYPE_SEQUENTIAL;
+    }
+    if(nearest_stride != 0){
+      streams_[stream_itr].stride = nearest_stride;
+    }
+  }
+  else {
+    // Start a new stream in place of the least recently used one
+    stream_itr = 0;
+    for(size_t victim_itr = 0; victim_itr < streams_.size(); victim_itr++){
+      if(streams_[victim_itr].valid == false){
+        stream_itr = victim_itr;
+        break;
+      }
+      if(streams_[victim_itr].last_access < streams_[stream_itr].last_access){
+        stream_itr = victim_itr;
+      }
+    }
+    streams_[stream_itr].stride = 0;
+    streams_[stream_itr].valid = true;
+  }
+
+  auto& stream = streams_[stream_itr];
+  stream.last_block = block_id;
+  stream.pattern_type = pattern_type;
+  stream.last_access = clock_;
+
+  return pattern_type;
+}
+
+long StreamDetector::GetStride(const size_t& block_id) const{
+
+  for(auto& stream : streams_){
+    if(stream.valid == true &&
+        stream.last_block == block_id &&
+        stream.pattern_type != PATTERN_TYPE_RANDOM){
+      return stream.stride;
+    }
+  }
+
+  return 0;
+}
+
+}  // End machine namespace
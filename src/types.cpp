@@ -15,6 +15,16 @@ std::string CachingTypeToString(const CachingType& caching_type){
       return "LRU";
     case CACHING_TYPE_ARC:
       return "ARC";
+    case CACHING_TYPE_CLOCK:
+      return "CLOCK";
+    case CACHING_TYPE_CLOCK_PRO:
+      return "CLOCK-PRO";
+    case CACHING_TYPE_TWO_Q:
+      return "2Q";
+    case CACHING_TYPE_LIRS:
+      return "LIRS";
+    case CACHING_TYPE_W_TINY_LFU:
+      return "W-TINYLFU";
     default:
       return "INVALID";
   }
@@ -38,6 +48,18 @@ std::string DeviceTypeToString(const DeviceType& device_type){
 
 }
 
+DeviceType StringToDeviceType(const std::string& device_name){
+
+  for(size_t device_itr = DEVICE_TYPE_CACHE; device_itr <= DEVICE_TYPE_MAX; device_itr++){
+    auto device_type = (DeviceType) device_itr;
+    if(DeviceTypeToString(device_type) == device_name){
+      return device_type;
+    }
+  }
+
+  return DEVICE_TYPE_INVALID;
+}
+
 std::string DiskModeTypeToString(const DiskModeType& disk_mode_type) {
 
   switch (disk_mode_type){
@@ -129,6 +151,113 @@ std::string LatencyTypeToString(const LatencyType& latency_type){
 
 }
 
+std::string NumaPlacementTypeToString(const NumaPlacementType& numa_placement_type){
+
+  switch (numa_placement_type) {
+    case NUMA_PLACEMENT_TYPE_FIRST_TOUCH:
+      return "FIRST-TOUCH";
+    case NUMA_PLACEMENT_TYPE_INTERLEAVE:
+      return "INTERLEAVE";
+    case NUMA_PLACEMENT_TYPE_MIGRATE:
+      return "MIGRATE";
+    default:
+      return "INVALID";
+  }
+
+}
+
+std::string LatencyModelTypeToString(const LatencyModelType& latency_model_type){
+
+  switch (latency_model_type) {
+    case LATENCY_MODEL_TYPE_FIXED:
+      return "FIXED";
+    case LATENCY_MODEL_TYPE_DISTRIBUTION:
+      return "DISTRIBUTION";
+    case LATENCY_MODEL_TYPE_SIZE:
+      return "SIZE";
+    default:
+      return "INVALID";
+  }
+
+}
+
+std::string GcPolicyTypeToString(const GcPolicyType& gc_policy_type){
+
+  switch (gc_policy_type) {
+    case GC_POLICY_TYPE_GREEDY:
+      return "GREEDY";
+    case GC_POLICY_TYPE_COST_BENEFIT:
+      return "COST-BENEFIT";
+    default:
+      return "INVALID";
+  }
+
+}
+
+std::string EmulationBackendTypeToString(const EmulationBackendType& emulation_backend_type){
+
+  switch (emulation_backend_type) {
+    case EMULATION_BACKEND_TYPE_STDIO:
+      return "STDIO";
+    case EMULATION_BACKEND_TYPE_DIRECT:
+      return "DIRECT";
+    case EMULATION_BACKEND_TYPE_URING:
+      return "URING";
+    case EMULATION_BACKEND_TYPE_MMAP:
+      return "MMAP";
+    case EMULATION_BACKEND_TYPE_MEMORY:
+      return "MEMORY";
+    default:
+      return "INVALID";
+  }
+
+}
+
+std::string PersistTypeToString(const PersistType& persist_type){
+
+  switch (persist_type) {
+    case PERSIST_TYPE_CLWB:
+      return "CLWB";
+    case PERSIST_TYPE_CLFLUSHOPT:
+      return "CLFLUSHOPT";
+    case PERSIST_TYPE_MSYNC:
+      return "MSYNC";
+    default:
+      return "INVALID";
+  }
+
+}
+
+std::string OperationTypeToString(const OperationType& operation_type){
+
+  switch (operation_type) {
+    case OPERATION_TYPE_READ:
+      return "READ";
+    case OPERATION_TYPE_WRITE:
+      return "WRITE";
+    case OPERATION_TYPE_FLUSH:
+      return "FLUSH";
+    default:
+      return "INVALID";
+  }
+
+}
+
+std::string PatternTypeToString(const PatternType& pattern_type){
+
+  switch (pattern_type) {
+    case PATTERN_TYPE_SEQUENTIAL:
+      return "SEQ";
+    case PATTERN_TYPE_STRIDED:
+      return "STRIDED";
+    case PATTERN_TYPE_RANDOM:
+      return "RND";
+    default:
+      return "INVALID";
+  }
+
+}
+
 DeviceType GetLastDevice(const HierarchyType& hierarchy_type){
 
   switch (hierarchy_type) {
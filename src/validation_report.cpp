@@ -0,0 +1,98 @@
+// VALIDATION REPORT SOURCE
+
+#include <iomanip>
+
+#include "validation_report.h"
+
+namespace machine {
+
+void ValidationReport::Record(const DeviceType& device_type,
+                              const AccessType& access_type,
+                              const PatternType& pattern_type,
+                              const double& page_latency,
+                              const double& modeled_latency,
+                              const double& measured_latency){
+
+  // Nothing to compare against
+  if(modeled_latency <= 0){
+    return;
+  }
+
+  auto& entry = entries_[Key(device_type, access_type, pattern_type)];
+  entry.page_latency = page_latency;
+  entry.modeled_total += modeled_latency;
+  entry.measured_total += measured_latency;
+  entry.measured.Record(measured_latency);
+  entry.ratio.Record(100 * measured_latency / modeled_latency);
+
+}
+
+double ValidationReport::GetSuggestedLatency(const LatencyModel& latency_model,
+                                             const DeviceType& device_type,
+                                             const AccessType& access_type,
+                                             const PatternType& pattern_type) const {
+
+  auto entry_itr = entries_.find(Key(device_type, access_type, pattern_type));
+  if(entry_itr == entries_.end()){
+    return latency_model.GetPageLatency(device_type, access_type, pattern_type);
+  }
+
+  auto& entry = entry_itr->second;
+  return entry.page_latency * entry.measured_total / entry.modeled_total;
+}
+
+std::map<DeviceType, LatencyProfile> ValidationReport::GetSuggestedProfiles(const LatencyModel& latency_model) const {
+
+  std::map<DeviceType, LatencyProfile> profiles;
+
+  for(auto& entry : entries_){
+    auto device_type = std::get<0>(entry.first);
+    if(profiles.count(device_type) != 0){
+      continue;
+    }
+
+    auto& profile = profiles[device_type];
+    profile.seq_read_latency = GetSuggestedLatency(latency_model, device_type,
+                                                   ACCESS_TYPE_READ, PATTERN_TYPE_SEQUENTIAL);
+    profile.seq_write_latency = GetSuggestedLatency(latency_model, device_type,
+                                                    ACCESS_TYPE_WRITE, PATTERN_TYPE_SEQUENTIAL);
+    profile.rnd_read_latency = GetSuggestedLatency(latency_model, device_type,
+                                                   ACCESS_TYPE_READ, PATTERN_TYPE_RANDOM);
+    profile.rnd_write_latency = GetSuggestedLatency(latency_model, device_type,
+                                                    ACCESS_TYPE_WRITE, PATTERN_TYPE_RANDOM);
+  }
+
+  return profiles;
+}
+
+void ValidationReport::Reset(){
+  entries_.clear();
+}
+
+std::ostream& operator<< (std::ostream& os, const ValidationReport& validation_report){
+
+  os << "VALIDATION (modeled vs measured, us): \n";
+  for(auto& entry : validation_report.entries_){
+    auto& stats = entry.second;
+    auto count = stats.measured.GetCount();
+    auto label = DeviceTypeToString(std::get<0>(entry.first)) + " " +
+        ((std::get<1>(entry.first) == ACCESS_TYPE_READ) ? "READ" : "WRITE") + " " +
+        PatternTypeToString(std::get<2>(entry.first));
+
+    os << std::setw(20) << label << " :: "
+        << "OPS: " << count << " "
+        << "MODELED: " << stats.modeled_total / count / 1000 << " "
+        << "MEASURED: " << stats.measured_total / count / 1000 << " "
+        << "(P50: " << stats.measured.GetPercentile(50) / 1000 << " "
+        << "P99: " << stats.measured.GetPercentile(99) / 1000 << ") "
+        << "RATIO %: P10: " << stats.ratio.GetPercentile(10) << " "
+        << "P50: " << stats.ratio.GetPercentile(50) << " "
+        << "P90: " << stats.ratio.GetPercentile(90) << " "
+        << "TABLE: " << stats.page_latency << " -> "
+        << stats.page_latency * stats.measured_total / stats.modeled_total << " ns\n";
+  }
+
+  return os;
+}
+
+}  // End machine namespace
@@ -17,6 +17,8 @@
 #include "device.h"
 #include "cache.h"
 #include "stats.h"
+#include "optimizer.h"
+#include "calibration.h"
 
 namespace machine {
 
@@ -48,11 +50,22 @@ static void WriteOutput(double stat) {
   out.flush();
 }
 
+static void WriteLatencyOutput() {
+
+  if(state.latency_file.empty() == true){
+    return;
+  }
+
+  std::ofstream out(state.latency_file);
+  machine_stats.WriteLatencies(out);
+  out.flush();
+}
+
 size_t GetMachineSize(){
 
   size_t machine_size = 0;
-  for(auto device: state.devices){
-    auto device_size = device.cache.GetSize();
+  for(auto& device: state.devices){
+    auto device_size = device.GetSize();
     machine_size += device_size;
   }
 
@@ -63,12 +76,15 @@ void PrintMachine(){
 
   std::cout << "\n+++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
   std::cout << "MACHINE\n";
-  for(auto device: state.devices){
-    std::cout << device.cache;
+  for(auto& device: state.devices){
+    for(auto& cache: device.caches){
+      std::cout << cache;
+    }
   }
   std::cout << "+++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
 
   std::cout << machine_stats;
+  PrintDeviceModels();
 
 }
 
@@ -95,7 +111,7 @@ void PrintRequiredBlocks(size_t percent,
 
   std::cout << "PERCENT: " << percent << " ";
   std::cout << "BLOCKS NEEDED: ";
-  PrintCapacity(current_total_blocks);
+  PrintCapacity(current_total_blocks, DEFAULT_BLOCK_SIZE);
   std::cout << "\n";
 
 }
@@ -122,7 +138,7 @@ void PrintFrequency(size_t available_blocks,
   auto captured_frequency = (current_total_frequency * 100)/total_frequency;
 
   std::cout << "AVAILABLE BLOCKS: ";
-  PrintCapacity(available_blocks);
+  PrintCapacity(available_blocks, DEFAULT_BLOCK_SIZE);
 
   std::cout << " PERCENT: " << captured_frequency << "%\n";
 }
@@ -195,35 +211,106 @@ bool IsVolatileDevice(DeviceType device_type){
       device_type == DeviceType::DEVICE_TYPE_DRAM);
 }
 
-void BringBlockToMemory(const size_t& block_id){
+// Prefetch the next blocks of a sequential or strided stream on storage
+void PrefetchBlocks(const size_t& block_id,
+                    const DeviceType& storage_device_type,
+                    const DeviceType& memory_device_type){
+
+  auto device_offset = GetDeviceOffset(state.devices, storage_device_type);
+  auto& device = state.devices[device_offset];
+  auto stride = device.stream_detector->GetStride(device.GetBlockId(block_id));
+  if(stride == 0){
+    return;
+  }
+
+  // Stride in trace blocks
+  stride *= (long) device.block_factor;
+
+  // Prefetch reads overlap with demand accesses, but writing back the
+  // blocks they evict does not: charge it to the running op
+  double prefetch_ns = 0;
+  prefetch_destination = memory_device_type;
+
+  for(size_t prefetch_itr = 1; prefetch_itr <= state.prefetch_depth; prefetch_itr++){
+    long offset = stride * (long) prefetch_itr;
+    if(offset < 0 && (size_t) (-offset) > block_id){
+      break;
+    }
+
+    size_t prefetch_block_id = block_id + offset;
+    if(LocateInMemoryDevices(prefetch_block_id) != DeviceType::DEVICE_TYPE_INVALID){
+      continue;
+    }
+    auto source = LocateInStorageDevices(prefetch_block_id);
+    if(source == DeviceType::DEVICE_TYPE_INVALID){
+      continue;
+    }
+
+    prefetch_source = source;
+    Copy(state.devices,
+         memory_device_type,
+         source,
+         prefetch_block_id,
+         CLEAN_BLOCK,
+         false,
+         prefetch_ns,
+         logical_ns);
+    machine_stats.IncrementPrefetchCount(memory_device_type);
+  }
+
+  prefetch_source = DEVICE_TYPE_INVALID;
+  prefetch_destination = DEVICE_TYPE_INVALID;
+
+}
+
+// Returns the device that held the block before it was brought up
+DeviceType BringBlockToMemory(const size_t& block_id){
 
   auto memory_device_type = LocateInMemoryDevices(block_id);
   auto storage_device_type = LocateInStorageDevices(block_id);
+  auto serving_device_type = memory_device_type;
+  if(serving_device_type == DeviceType::DEVICE_TYPE_INVALID){
+    serving_device_type = storage_device_type;
+  }
   auto nvm_exists = DeviceExists(state.devices, DeviceType::DEVICE_TYPE_NVM);
   auto flush_block = false;
+  auto prefetch_destination = DeviceType::DEVICE_TYPE_INVALID;
+
+  // Hit on DRAM or NVM
+  if(memory_device_type == DeviceType::DEVICE_TYPE_DRAM ||
+      memory_device_type == DeviceType::DEVICE_TYPE_NVM){
+    CountNumaHit(state.devices, memory_device_type, block_id);
+  }
 
   // Not found on DRAM & NVM
   if(memory_device_type == DeviceType::DEVICE_TYPE_INVALID &&
       storage_device_type != DeviceType::DEVICE_TYPE_INVALID){
     // Copy to NVM first if it exists in hierarchy
+    auto destination = DeviceType::DEVICE_TYPE_DRAM;
     if(nvm_exists == true) {
-      Copy(state.devices,
-           DeviceType::DEVICE_TYPE_NVM,
-           storage_device_type,
-           block_id,
-           CLEAN_BLOCK,
-           flush_block,
-           logical_ns);
-    }
-    else {
-      Copy(state.devices,
-           DeviceType::DEVICE_TYPE_DRAM,
-           storage_device_type,
-           block_id,
-           CLEAN_BLOCK,
-           flush_block,
-           logical_ns);
+      destination = DeviceType::DEVICE_TYPE_NVM;
     }
+
+    Copy(state.devices,
+         destination,
+         storage_device_type,
+         block_id,
+         CLEAN_BLOCK,
+         flush_block,
+         logical_ns);
+    prefetch_destination = destination;
+  }
+
+  // Remote to local NUMA node migration
+  memory_device_type = LocateInMemoryDevices(block_id);
+
+  if(state.numa_placement_type == NUMA_PLACEMENT_TYPE_MIGRATE &&
+      (memory_device_type == DeviceType::DEVICE_TYPE_DRAM ||
+      memory_device_type == DeviceType::DEVICE_TYPE_NVM)){
+    MigrateToLocalNode(state.devices,
+                       memory_device_type,
+                       block_id,
+                       logical_ns);
   }
 
   // NVM to DRAM migration
@@ -259,7 +346,13 @@ void BringBlockToMemory(const size_t& block_id){
          logical_ns);
   }
 
+  // Prefetch once the block is in the cache so that it cannot be evicted
+  if(state.prefetch_depth > 0 &&
+      prefetch_destination != DeviceType::DEVICE_TYPE_INVALID){
+    PrefetchBlocks(block_id, storage_device_type, prefetch_destination);
+  }
 
+  return serving_device_type;
 }
 
 void BringBlockToStorage(const size_t& block_id,
@@ -279,44 +372,51 @@ void BringBlockToStorage(const size_t& block_id,
 
   // Check if it is on DRAM or CACHE
   if(is_volatile_source){
+    // Flush the entire source block
+    auto device_offset = GetDeviceOffset(state.devices, source);
+    auto& source_device = state.devices[device_offset];
+    auto source_block_id = source_device.GetBlockId(block_id);
+    auto first_block_id = source_device.GetFirstBlockId(source_block_id);
+
     // Copy to NVM first if it exists in hierarchy
     if(nvm_exists == true) {
-      Copy(state.devices,
-           DeviceType::DEVICE_TYPE_NVM,
-           source,
-           block_id,
-           nvm_status,
-           flush_block,
-           logical_ns);
+      CopyBlocks(state.devices,
+                 DeviceType::DEVICE_TYPE_NVM,
+                 source,
+                 first_block_id,
+                 source_device.block_factor,
+                 nvm_status,
+                 flush_block,
+                 logical_ns);
     }
     else {
-      Copy(state.devices,
-           DeviceType::DEVICE_TYPE_DISK,
-           source,
-           block_id,
-           CLEAN_BLOCK,
-           flush_block,
-           logical_ns);
+      CopyBlocks(state.devices,
+                 DeviceType::DEVICE_TYPE_DISK,
+                 source,
+                 first_block_id,
+                 source_device.block_factor,
+                 CLEAN_BLOCK,
+                 flush_block,
+                 logical_ns);
     }
 
     // Mark block as clean
-    auto device_offset = GetDeviceOffset(state.devices, source);
-    auto device_cache = state.devices[device_offset].cache;
-    auto victim = device_cache.Put(block_id, CLEAN_BLOCK);
+    auto victim = source_device.Put(source_block_id, CLEAN_BLOCK);
     if(victim.block_id != INVALID_KEY){
       exit(EXIT_FAILURE);
     }
 
     // Update duration
-    logical_ns += GetWriteLatency(state.devices, source, block_id, flush_block);
+    logical_ns += GetWriteLatency(state.devices, source, block_id, flush_block,
+                                  DEFAULT_BLOCK_SIZE);
   }
 
 }
 
-void WriteBlock(const size_t& block_id) {
+DeviceType WriteBlock(const size_t& block_id) {
 
   // Bring block to memory if needed
-  BringBlockToMemory(block_id);
+  auto serving_device_type = BringBlockToMemory(block_id);
 
   auto destination = LocateInMemoryDevices(block_id);
   auto flush_block = false;
@@ -334,7 +434,7 @@ void WriteBlock(const size_t& block_id) {
          flush_block,
          logical_ns);
 
-    return;
+    return serving_device_type;
   }
 
   // CASE 2: Existing block
@@ -344,36 +444,40 @@ void WriteBlock(const size_t& block_id) {
   auto is_volatile_destination = IsVolatileDevice(destination);
   if(is_volatile_destination){
     auto device_offset = GetDeviceOffset(state.devices, destination);
-    auto device_cache = state.devices[device_offset].cache;
-    auto victim = device_cache.Put(block_id, DIRTY_BLOCK);
+    auto& device = state.devices[device_offset];
+    auto victim = device.Put(device.GetBlockId(block_id), DIRTY_BLOCK);
     if(victim.block_id != INVALID_KEY){
       exit(EXIT_FAILURE);
     }
   }
 
   // Update duration
-  logical_ns += GetWriteLatency(state.devices, destination, block_id, flush_block);
+  logical_ns += GetWriteLatency(state.devices, destination, block_id, flush_block,
+                                DEFAULT_BLOCK_SIZE);
 
+  return serving_device_type;
 }
 
-void ReadBlock(const size_t& block_id){
+DeviceType ReadBlock(const size_t& block_id){
   //std::cout << "READ  " << block_id << "\n";
 
   // Bring block to memory if needed
-  BringBlockToMemory(block_id);
+  auto serving_device_type = BringBlockToMemory(block_id);
 
   // Update duration
   auto source = LocateInMemoryDevices(block_id);
-  logical_ns += GetReadLatency(state.devices, source, block_id);
+  logical_ns += GetReadLatency(state.devices, source, block_id,
+                               DEFAULT_BLOCK_SIZE);
 
   if(source == DeviceType::DEVICE_TYPE_INVALID){
     std::cout << "Could not read block : " << block_id << "\n";
     exit(EXIT_FAILURE);
   }
 
+  return serving_device_type;
 }
 
-void FlushBlock(const size_t& block_id) {
+DeviceType FlushBlock(const size_t& block_id) {
   //std::cout << "FLUSH " << block_id << "\n";
 
   // Check if dirty in volatile device
@@ -381,9 +485,9 @@ void FlushBlock(const size_t& block_id) {
   auto is_volatile_device = IsVolatileDevice(memory_device_type);
   if(is_volatile_device == true){
     auto device_offset = GetDeviceOffset(state.devices, memory_device_type);
-    auto device_cache = state.devices[device_offset].cache;
+    auto& device = state.devices[device_offset];
     // Check device cache
-    auto block_status = device_cache.Get(block_id);
+    auto block_status = device.Get(device.GetBlockId(block_id));
     if(block_status == INVALID_VALUE){
       std::cout << "Did not find the to be flushed block: " << block_id;
       exit(EXIT_FAILURE);
@@ -394,6 +498,7 @@ void FlushBlock(const size_t& block_id) {
 
   }
 
+  return memory_device_type;
 }
 
 void BootstrapBlock(const size_t& block_id) {
@@ -401,15 +506,15 @@ void BootstrapBlock(const size_t& block_id) {
   auto nvm_exists = DeviceExists(state.devices, DeviceType::DEVICE_TYPE_NVM);
   if(nvm_exists == true){
     auto device_offset = GetDeviceOffset(state.devices, DeviceType::DEVICE_TYPE_NVM);
-    auto device_cache = state.devices[device_offset].cache;
+    auto& device = state.devices[device_offset];
 
-    double size = device_cache.GetSize();
-    double capacity = device_cache.GetCapacity();
+    double size = device.GetSize();
+    double capacity = device.GetCapacity();
     double occupied_fraction = size/capacity;
     if(occupied_fraction > 0.5){
       // Bootstrap on last device
-      auto last_device_cache = state.devices.back().cache;
-      last_device_cache.Put(block_id, CLEAN_BLOCK);
+      auto& last_device = state.devices.back();
+      last_device.Put(last_device.GetBlockId(block_id), CLEAN_BLOCK);
       return;
     }
   }
@@ -425,7 +530,7 @@ size_t GetGlobalBlockNumber(const size_t& fork_number,
   return (fork_number * 10 + block_number);
 }
 
-void MachineHelper() {
+double MachineHelper() {
 
   // Run workload
 
@@ -434,6 +539,7 @@ void MachineHelper() {
   char operation_type;
   size_t fork_number;
   size_t block_number;
+  size_t client_number;
   size_t warm_up_ratio = 10; // 10%
 
   // Figure out warm up operation count
@@ -442,7 +548,7 @@ void MachineHelper() {
   std::cout << "WARMING UP SIMULATOR:: OPERATION COUNT: " << warm_up_operation_count << "\n";
 
   if (state.file_name.empty()) {
-    return;
+    return 0;
   }
   else {
     std::cout << "Running trace " << state.file_name << "...\n";
@@ -466,11 +572,15 @@ void MachineHelper() {
     // Get a line from the input stream
     input->getline(buffer, fragment_size);
 
-    // Check statement
-    sscanf(buffer, "%c %lu %lu",
+    // Check statement (the client column is optional)
+    client_number = 0;
+    sscanf(buffer, "%c %lu %lu %lu",
            &operation_type,
            &fork_number,
-           &block_number);
+           &block_number,
+           &client_number);
+    current_numa_node = GetClientNode(state, client_number);
+    current_client = client_number;
 
     auto global_block_number = GetGlobalBlockNumber(fork_number, block_number);
 
@@ -510,6 +620,7 @@ void MachineHelper() {
 
   // Reset stats
   machine_stats.Reset();
+  ResetDeviceModelStats();
 
   warmed_up = false;
   size_t read_operation_itr = 0;
@@ -523,29 +634,46 @@ void MachineHelper() {
     // Get a line from the input stream
     input->getline(buffer, fragment_size);
 
-    // Check statement
-    sscanf(buffer, "%c %lu %lu",
+    // Check statement (the client column is optional)
+    client_number = 0;
+    sscanf(buffer, "%c %lu %lu %lu",
            &operation_type,
            &fork_number,
-           &block_number);
+           &block_number,
+           &client_number);
+    current_numa_node = GetClientNode(state, client_number);
+    current_client = client_number;
 
     auto global_block_number = GetGlobalBlockNumber(fork_number, block_number);
+    auto operation_start_ns = logical_ns;
 
     switch(operation_type){
       case 'r': {
-        ReadBlock(global_block_number);
+        auto device_type = ReadBlock(global_block_number);
+        machine_stats.RecordLatency(OPERATION_TYPE_READ, device_type,
+                                    logical_ns - operation_start_ns);
+        WaitOnPendingWrites(OPERATION_TYPE_READ, device_type,
+                            logical_ns - operation_start_ns);
         read_operation_itr++;
         break;
       }
 
       case 'w': {
-        WriteBlock(global_block_number);
+        auto device_type = WriteBlock(global_block_number);
+        machine_stats.RecordLatency(OPERATION_TYPE_WRITE, device_type,
+                                    logical_ns - operation_start_ns);
+        WaitOnPendingWrites(OPERATION_TYPE_WRITE, device_type,
+                            logical_ns - operation_start_ns);
         write_operation_itr++;
         break;
       }
 
       case 'f': {
-        FlushBlock(global_block_number);
+        auto device_type = FlushBlock(global_block_number);
+        machine_stats.RecordLatency(OPERATION_TYPE_FLUSH, device_type,
+                                    logical_ns - operation_start_ns);
+        WaitOnPendingWrites(OPERATION_TYPE_FLUSH, device_type,
+                            logical_ns - operation_start_ns);
         flush_operation_itr++;
         break;
       }
@@ -580,6 +708,7 @@ void MachineHelper() {
 
       // Reset stats
       machine_stats.Reset();
+      ResetDeviceModelStats();
 
       // Set warmed up
       warmed_up = true;
@@ -607,6 +736,12 @@ void MachineHelper() {
 
   }
 
+  // Sync blocks still waiting for a group commit
+  if(state.emulate == true){
+    FlushGroupCommits();
+    DrainIOWorkers();
+  }
+
   // Measure physical time, logical time, and throughput
   auto logical_s = logical_ns/(1000 * 1000 * 1000);
   auto physical_ns = physical_timer.GetDuration();
@@ -617,6 +752,7 @@ void MachineHelper() {
   std::cout << "PHYSICAL TIME (s): " << physical_s << "\n";
   std::cout << "LOGICAL TIME  (s): " << logical_s << "\n";
   std::cout << "THROUGHPUT : " << throughput << " (OPS/S) \n";
+  PrintDeviceLifetime(logical_ns);
   std::cout << "+++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
 
   // Get machine size
@@ -631,21 +767,40 @@ void MachineHelper() {
   // Print machine caches
   PrintMachine();
 
-  // Emit output
-  WriteOutput(throughput);
+  // Suggest latencies for this host
+  if(state.emulate == true && state.validation_profile.empty() == false){
+    WriteValidationProfile(state.validation_profile);
+  }
 
+  return throughput;
 }
 
 void RunMachineTest() {
 
+  // Measure the devices and write a latency profile
+  if(state.calibration_paths.empty() == false){
+    RunCalibration(state);
+    return;
+  }
+
   // Bootstrap filesystem if needed
   if(state.emulate == true){
     emulate = true;
     BootstrapFileSystemForEmulation(state);
   }
 
+  // Search the hierarchy design space
+  if(state.optimize == true){
+    RunOptimizer(state);
+    return;
+  }
+
   // Run the benchmark once
-  MachineHelper();
+  auto throughput = MachineHelper();
+
+  // Emit output
+  WriteOutput(throughput);
+  WriteLatencyOutput();
 
 }
 
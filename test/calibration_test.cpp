@@ -0,0 +1,85 @@
+// CALIBRATION TEST
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "calibration.h"
+#include "configuration.h"
+
+namespace machine {
+
+TEST(CalibrationTest, ProfileCheck) {
+
+  std::map<DeviceType, LatencyProfile> profiles;
+  profiles[DEVICE_TYPE_DRAM].seq_read_latency = 100;
+  profiles[DEVICE_TYPE_DRAM].seq_write_latency = 200;
+  profiles[DEVICE_TYPE_DRAM].rnd_read_latency = 300;
+  profiles[DEVICE_TYPE_DRAM].rnd_write_latency = 400;
+  profiles[DEVICE_TYPE_DRAM].read_bandwidth = 10;
+  profiles[DEVICE_TYPE_DRAM].write_bandwidth = 5;
+  profiles[DEVICE_TYPE_DISK].seq_read_latency = 30000;
+  profiles[DEVICE_TYPE_DISK].seq_write_latency = 100000;
+  profiles[DEVICE_TYPE_DISK].rnd_read_latency = 50000;
+  profiles[DEVICE_TYPE_DISK].rnd_write_latency = 150000;
+
+  std::string profile_file = "calibration_test_profile.txt";
+  WriteLatencyProfile(profile_file, profiles);
+  auto read_profiles = ReadLatencyProfile(profile_file);
+  remove(profile_file.c_str());
+
+  EXPECT_EQ(read_profiles.size(), 2);
+  EXPECT_EQ(read_profiles.count(DEVICE_TYPE_NVM), 0);
+  for(auto entry : profiles){
+    auto& read_profile = read_profiles[entry.first];
+    EXPECT_DOUBLE_EQ(read_profile.seq_read_latency, entry.second.seq_read_latency);
+    EXPECT_DOUBLE_EQ(read_profile.seq_write_latency, entry.second.seq_write_latency);
+    EXPECT_DOUBLE_EQ(read_profile.rnd_read_latency, entry.second.rnd_read_latency);
+    EXPECT_DOUBLE_EQ(read_profile.rnd_write_latency, entry.second.rnd_write_latency);
+    EXPECT_DOUBLE_EQ(read_profile.read_bandwidth, entry.second.read_bandwidth);
+    EXPECT_DOUBLE_EQ(read_profile.write_bandwidth, entry.second.write_bandwidth);
+  }
+
+}
+
+TEST(CalibrationTest, DeviceCheck) {
+
+  configuration state;
+  state.emulation_backend_type = EMULATION_BACKEND_TYPE_STDIO;
+  state.nvm_emulation_backend_type = EMULATION_BACKEND_TYPE_INVALID;
+
+  // A file that is already in the directory is left alone
+  std::string directory = ".";
+  std::string file_path = "calibration_test_file";
+  FILE *file_pointer = fopen(file_path.c_str(), "w");
+  ASSERT_NE(file_pointer, nullptr);
+  fputs("keep", file_pointer);
+  fclose(file_pointer);
+
+  auto profile = CalibrateDevice(state, DEVICE_TYPE_DISK, directory, 1024 * 1024, 64);
+
+  EXPECT_GT(profile.seq_read_latency, 0);
+  EXPECT_GT(profile.seq_write_latency, 0);
+  EXPECT_GT(profile.rnd_read_latency, 0);
+  EXPECT_GT(profile.rnd_write_latency, 0);
+  EXPECT_GT(profile.read_bandwidth, 0);
+  EXPECT_GT(profile.write_bandwidth, 0);
+
+  struct stat file_stat;
+  ASSERT_EQ(stat(file_path.c_str(), &file_stat), 0);
+  EXPECT_EQ(file_stat.st_size, 4);
+  remove(file_path.c_str());
+
+  // The scratch file is removed
+  auto directory_pointer = opendir(directory.c_str());
+  ASSERT_NE(directory_pointer, nullptr);
+  while(auto entry = readdir(directory_pointer)){
+    EXPECT_EQ(std::string(entry->d_name).find("machine_calibration_"), std::string::npos);
+  }
+  closedir(directory_pointer);
+
+}
+
+}  // End machine namespace
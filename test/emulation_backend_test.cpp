@@ -0,0 +1,147 @@
+// EMULATION BACKEND TEST
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <unistd.h>
+
+#include "emulation_backend.h"
+
+namespace machine {
+
+TEST(EmulationBackendTest, BackendCheck) {
+
+  std::string file_path = "emulation_backend_test_file";
+  size_t file_size = 1024 * 1024;
+  size_t block_size = 8192;
+
+  FILE *file_pointer = fopen(file_path.c_str(), "w");
+  ASSERT_NE(file_pointer, nullptr);
+  ASSERT_EQ(ftruncate(fileno(file_pointer), file_size), 0);
+  fclose(file_pointer);
+
+  std::unique_ptr<EmulationBackend> backends[] = {
+      std::unique_ptr<EmulationBackend>(new StdioBackend(file_path, block_size)),
+      std::unique_ptr<EmulationBackend>(new DirectBackend(file_path, block_size, true))
+  };
+
+  // Aligned blocks across the file
+  for(auto& backend : backends){
+    for(off64_t offset = 0; offset + block_size <= file_size; offset += 16 * 4096){
+      backend->Write(offset, block_size);
+      backend->Read(offset, 4096);
+    }
+    backend->Sync();
+  }
+
+  remove(file_path.c_str());
+
+}
+
+TEST(EmulationBackendTest, MmapCheck) {
+
+  std::string file_path = "emulation_backend_mmap_test_file";
+  size_t file_size = 1024 * 1024;
+  size_t block_size = 4096;
+
+  FILE *file_pointer = fopen(file_path.c_str(), "w");
+  ASSERT_NE(file_pointer, nullptr);
+  ASSERT_EQ(ftruncate(fileno(file_pointer), file_size), 0);
+  fclose(file_pointer);
+
+  MmapBackend backend(file_path, block_size, 1000);
+  EXPECT_NE(backend.GetPersistType(), PERSIST_TYPE_INVALID);
+
+  // Stores reach the file
+  backend.Write(block_size, block_size);
+  backend.Sync();
+
+  std::string contents(block_size, 0);
+  file_pointer = fopen(file_path.c_str(), "r");
+  ASSERT_NE(file_pointer, nullptr);
+  fseek(file_pointer, block_size, SEEK_SET);
+  ASSERT_EQ(fread(&contents[0], block_size, 1, file_pointer), 1);
+  fclose(file_pointer);
+  EXPECT_NE(contents, std::string(block_size, 0));
+
+  // Every access spins for the extra latency
+  auto start = std::chrono::steady_clock::now();
+  for(size_t read_itr = 0; read_itr < 100; read_itr++){
+    backend.Read(0, block_size);
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+  EXPECT_GE(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(), 100 * 1000);
+
+  remove(file_path.c_str());
+
+}
+
+TEST(EmulationBackendTest, MemoryCheck) {
+
+  size_t memory_size = 16 * 1024 * 1024;
+  size_t block_size = 4096;
+
+  MemoryBackend dram_backend(memory_size, block_size, 1, 1, 0);
+  EXPECT_GT(dram_backend.GetReadCost(), 0);
+  EXPECT_GT(dram_backend.GetWriteCost(), 0);
+
+  // A slower tier spins for its extra latency on every access
+  MemoryBackend nvm_backend(memory_size, block_size, 4, 8, 1000);
+  auto start = std::chrono::steady_clock::now();
+  for(off64_t offset = 0; offset < 100 * (off64_t) block_size; offset += block_size){
+    nvm_backend.Write(offset, block_size);
+    nvm_backend.Read(offset, block_size);
+  }
+  nvm_backend.Sync();
+  auto duration = std::chrono::steady_clock::now() - start;
+  EXPECT_GE(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(), 200 * 1000);
+
+}
+
+#ifdef HAVE_IO_URING
+
+TEST(EmulationBackendTest, UringCheck) {
+
+  std::string file_path = "emulation_backend_uring_test_file";
+  size_t file_size = 1024 * 1024;
+  size_t block_size = 4096;
+
+  FILE *file_pointer = fopen(file_path.c_str(), "w");
+  ASSERT_NE(file_pointer, nullptr);
+  ASSERT_EQ(ftruncate(fileno(file_pointer), file_size), 0);
+  fclose(file_pointer);
+
+  UringBackend backend(file_path, block_size, 8, false);
+
+  // Writes and prefetches stay in flight up to the queue depth
+  for(off64_t offset = 0; offset + block_size <= file_size; offset += block_size){
+    backend.Write(offset, block_size);
+    backend.Prefetch(offset, block_size);
+    EXPECT_LE(backend.GetInFlightCount(), 8);
+  }
+
+  // A read buffer is reused only after the read into it is reaped
+  backend.Sync();
+  for(off64_t offset = 0; offset + block_size <= file_size; offset += block_size){
+    backend.Prefetch(offset, block_size);
+    EXPECT_EQ(backend.GetFreeReadBufferCount() + backend.GetInFlightCount(), 8);
+  }
+
+  // Foreground reads overlap with queued writes
+  for(off64_t offset = 0; offset + block_size <= file_size; offset += 16 * block_size){
+    backend.Write(offset, block_size);
+    backend.Read(offset + block_size, block_size);
+  }
+
+  backend.Sync();
+  EXPECT_EQ(backend.GetInFlightCount(), 0);
+  EXPECT_EQ(backend.GetFreeReadBufferCount(), 8);
+
+  remove(file_path.c_str());
+
+}
+
+#endif
+
+}  // End machine namespace
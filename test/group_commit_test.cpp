@@ -0,0 +1,48 @@
+// GROUP COMMIT TEST
+
+#include <gtest/gtest.h>
+
+#include "group_commit.h"
+
+namespace machine {
+
+TEST(GroupCommitTest, BatchCheck) {
+
+  GroupCommit group_commit(4, 0);
+
+  // Every fourth flushed block syncs the batch
+  for(size_t block_itr = 1; block_itr <= 12; block_itr++){
+    EXPECT_EQ(group_commit.Add(block_itr * 100), block_itr % 4 == 0);
+    if(block_itr % 4 == 0){
+      // The sync is shared by the waiting blocks
+      EXPECT_DOUBLE_EQ(group_commit.Commit(1000, block_itr * 100), 250);
+    }
+  }
+  EXPECT_EQ(group_commit.GetPendingCount(), 0);
+
+  EXPECT_DOUBLE_EQ(group_commit.GetSyncLatencyPerBlock(), 250);
+
+}
+
+TEST(GroupCommitTest, WindowCheck) {
+
+  GroupCommit group_commit(100, 1000);
+
+  // A batch is synced once its oldest block has waited for the window
+  EXPECT_FALSE(group_commit.Add(0));
+  EXPECT_FALSE(group_commit.Add(500));
+  EXPECT_TRUE(group_commit.Add(1000));
+  EXPECT_DOUBLE_EQ(group_commit.Commit(900, 1000), 300);
+  EXPECT_DOUBLE_EQ(group_commit.GetSyncLatencyPerBlock(), 300);
+
+  // The window restarts with the next batch
+  EXPECT_FALSE(group_commit.Add(1500));
+  EXPECT_EQ(group_commit.GetPendingCount(), 1);
+
+  // and runs out on the clock even if no other block is flushed
+  EXPECT_FALSE(group_commit.IsDue(2400));
+  EXPECT_TRUE(group_commit.IsDue(2500));
+
+}
+
+}  // End machine namespace
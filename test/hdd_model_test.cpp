@@ -0,0 +1,121 @@
+// HDD MODEL TEST
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+#include "hdd_model.h"
+#include "distribution.h"
+
+namespace machine {
+
+// 100 cylinders of 10 pages, 10 ns per page
+HDDModel GetHDDModel(const size_t& queue_depth){
+  return HDDModel(1000, 10, 100, 10, 1000, queue_depth);
+}
+
+TEST(HDDModelTest, SeekCheck) {
+
+  auto hdd_model = GetHDDModel(1);
+
+  EXPECT_DOUBLE_EQ(hdd_model.GetSeekLatency(0), 0);
+  EXPECT_DOUBLE_EQ(hdd_model.GetSeekLatency(1), 10);
+  EXPECT_DOUBLE_EQ(hdd_model.GetSeekLatency(99), 1000);
+
+  // Seek time grows with distance, but less than linearly
+  for(size_t distance = 2; distance < 100; distance++){
+    EXPECT_GT(hdd_model.GetSeekLatency(distance),
+              hdd_model.GetSeekLatency(distance - 1));
+  }
+  EXPECT_GT(hdd_model.GetSeekLatency(25), hdd_model.GetSeekLatency(99) / 4);
+
+}
+
+TEST(HDDModelTest, RotationCheck) {
+
+  auto hdd_model = GetHDDModel(1);
+
+  // Consecutive pages stream under the head
+  double latency = 0;
+  for(size_t page_itr = 0; page_itr < 100; page_itr++){
+    latency += hdd_model.Access(page_itr, 1, 0);
+  }
+
+  // Track switches seek and then wait for the start of the next track
+  EXPECT_NEAR(latency, 100 * 10 + 9 * 100, 1e-6);
+
+  // Going back one page waits for almost a full rotation
+  EXPECT_NEAR(hdd_model.Access(99, 1, 0), 100, 1e-6);
+
+}
+
+TEST(HDDModelTest, IdleCheck) {
+
+  auto hdd_model = GetHDDModel(1);
+  EXPECT_NEAR(hdd_model.Access(0, 1, 0), 10, 1e-6);
+
+  // Right away, the head waits for page 5 to come around
+  auto busy_model = hdd_model;
+  EXPECT_NEAR(busy_model.Access(5, 1, 0), 50, 1e-6);
+
+  // After idling for 10.4 rotations, page 5 is just arriving
+  EXPECT_NEAR(hdd_model.Access(5, 1, 1050), 10, 1e-6);
+
+}
+
+TEST(HDDModelTest, ScanCheck) {
+
+  UniformDistribution generator(50);
+  std::vector<size_t> pages;
+  for(size_t write_itr = 0; write_itr < 512; write_itr++){
+    pages.push_back(generator.next() % 1000);
+  }
+
+  // Service writebacks in arrival order
+  auto fifo_model = GetHDDModel(1);
+  double fifo_latency = 0;
+  for(auto page : pages){
+    EXPECT_TRUE(fifo_model.QueueWrite(page, 1));
+    auto service_times = fifo_model.Drain(0);
+    ASSERT_EQ(service_times.size(), 1);
+    fifo_latency += service_times[0];
+  }
+
+  // Batch writebacks into elevator passes
+  auto scan_model = GetHDDModel(64);
+  double scan_latency = 0;
+  for(auto page : pages){
+    if(scan_model.QueueWrite(page, 1) == true){
+      auto service_times = scan_model.Drain(0);
+      EXPECT_EQ(service_times.size(), 64);
+      scan_latency += std::accumulate(service_times.begin(),
+                                      service_times.end(), 0.0);
+    }
+  }
+
+  EXPECT_LT(scan_latency, fifo_latency / 2);
+
+  // Nothing is pending after a drain
+  EXPECT_EQ(scan_model.GetPendingCount(), 0);
+  EXPECT_TRUE(scan_model.Drain(0).empty());
+
+}
+
+TEST(HDDModelTest, ServiceTimeCheck) {
+
+  auto hdd_model = GetHDDModel(3);
+  EXPECT_FALSE(hdd_model.QueueWrite(500, 1));
+  EXPECT_FALSE(hdd_model.QueueWrite(0, 1));
+  EXPECT_TRUE(hdd_model.QueueWrite(1, 1));
+
+  // The sweep services pages 0, 1, and 500; each slot keeps its own cost
+  auto service_times = hdd_model.Drain(0);
+  ASSERT_EQ(service_times.size(), 3);
+  EXPECT_NEAR(service_times[1], 10, 1e-6);
+  EXPECT_NEAR(service_times[2], 10, 1e-6);
+  EXPECT_GT(service_times[0], hdd_model.GetSeekLatency(49));
+
+}
+
+}  // End machine namespace
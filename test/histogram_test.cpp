@@ -0,0 +1,79 @@
+// HISTOGRAM TEST
+
+#include <gtest/gtest.h>
+
+#include "histogram.h"
+
+namespace machine {
+
+TEST(HistogramTest, BucketCheck) {
+
+  size_t bucket_count = Histogram::BUCKET_COUNT;
+
+  // Small values are exact
+  for(uint64_t value = 0; value < Histogram::SUB_BUCKET_COUNT; value++){
+    EXPECT_EQ(Histogram::GetBucketIndex(value), value);
+    EXPECT_EQ(Histogram::GetBucketUpperBound(value), value);
+  }
+
+  // Larger values stay within the relative error bound
+  for(uint64_t value = Histogram::SUB_BUCKET_COUNT; value < (1UL << 40); value = value * 3 + 1){
+    auto bucket_index = Histogram::GetBucketIndex(value);
+    auto upper_bound = Histogram::GetBucketUpperBound(bucket_index);
+    EXPECT_LT(bucket_index, bucket_count);
+    EXPECT_GE(upper_bound, value);
+    EXPECT_LE(upper_bound - value, value >> Histogram::SUB_BUCKET_BITS);
+  }
+
+  EXPECT_LT(Histogram::GetBucketIndex(UINT64_MAX), bucket_count);
+
+}
+
+TEST(HistogramTest, PercentileCheck) {
+
+  Histogram histogram;
+  for(size_t value = 1; value <= 10000; value++){
+    histogram.Record(value);
+  }
+
+  EXPECT_EQ(histogram.GetCount(), 10000);
+  EXPECT_DOUBLE_EQ(histogram.GetMean(), 5000.5);
+  EXPECT_DOUBLE_EQ(histogram.GetMax(), 10000);
+  EXPECT_NEAR(histogram.GetPercentile(50), 5000, 5000/Histogram::SUB_BUCKET_COUNT);
+  EXPECT_NEAR(histogram.GetPercentile(99), 9900, 9900/Histogram::SUB_BUCKET_COUNT);
+  EXPECT_NEAR(histogram.GetPercentile(99.9), 9990, 9990/Histogram::SUB_BUCKET_COUNT);
+  EXPECT_DOUBLE_EQ(histogram.GetPercentile(100), 10000);
+
+  // Merge doubles the counts
+  Histogram merged_histogram;
+  merged_histogram.Merge(histogram);
+  merged_histogram.Merge(histogram);
+  EXPECT_EQ(merged_histogram.GetCount(), 20000);
+  EXPECT_NEAR(merged_histogram.GetPercentile(50), 5000, 5000/Histogram::SUB_BUCKET_COUNT);
+
+  histogram.Reset();
+  EXPECT_EQ(histogram.GetCount(), 0);
+  EXPECT_DOUBLE_EQ(histogram.GetPercentile(99), 0);
+
+}
+
+TEST(HistogramTest, ShiftCheck) {
+
+  Histogram histogram;
+  histogram.Record(10);
+  histogram.Record(20);
+
+  // A later charge moves the value to its new bucket
+  histogram.Shift(10, 90);
+  EXPECT_EQ(histogram.GetCount(), 2);
+  EXPECT_DOUBLE_EQ(histogram.GetMean(), 60);
+  EXPECT_DOUBLE_EQ(histogram.GetMax(), 100);
+  EXPECT_DOUBLE_EQ(histogram.GetPercentile(50), 20);
+
+  // Values that were never recorded are left alone
+  histogram.Shift(30, 10);
+  EXPECT_EQ(histogram.GetCount(), 2);
+
+}
+
+}  // End machine namespace
@@ -0,0 +1,67 @@
+// IO WORKER POOL TEST
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <sstream>
+#include <unistd.h>
+
+#include "configuration.h"
+#include "io_worker_pool.h"
+
+namespace machine {
+
+TEST(IOWorkerPoolTest, DispatchCheck) {
+
+  EmulationTarget target;
+  target.file_path = "io_worker_pool_test_file";
+  target.file_size = 1024 * 1024;
+  size_t block_size = 4096;
+
+  FILE *file_pointer = fopen(target.file_path.c_str(), "w");
+  ASSERT_NE(file_pointer, nullptr);
+  ASSERT_EQ(ftruncate(fileno(file_pointer), target.file_size), 0);
+  fclose(file_pointer);
+
+  configuration state;
+  state.emulation_backend_type = EMULATION_BACKEND_TYPE_DIRECT;
+  state.nvm_emulation_backend_type = EMULATION_BACKEND_TYPE_INVALID;
+  state.data_sync = true;
+
+  std::map<DeviceType, EmulationTarget> targets = {{DEVICE_TYPE_DISK, target}};
+  IOWorkerPool io_worker_pool(state, targets, 4, 2, block_size);
+  EXPECT_EQ(io_worker_pool.GetWorkerCount(), 4);
+  EXPECT_TRUE(io_worker_pool.IsPooled(DEVICE_TYPE_DISK));
+  EXPECT_FALSE(io_worker_pool.IsPooled(DEVICE_TYPE_NVM));
+
+  // Each client writes, syncs, and reads back on its own worker
+  for(size_t block_itr = 0; block_itr < 64; block_itr++){
+    IORequest request;
+    request.device_type = DEVICE_TYPE_DISK;
+    request.offset = block_itr * block_size;
+    request.byte_count = block_size;
+    size_t ticket = 0;
+    for(auto operation_type : {OPERATION_TYPE_WRITE, OPERATION_TYPE_FLUSH, OPERATION_TYPE_READ}){
+      request.operation_type = operation_type;
+      ticket = io_worker_pool.Submit(block_itr, request);
+    }
+
+    // Tickets count the requests of each worker; the read can be awaited
+    EXPECT_EQ(ticket, 3 * (block_itr / 4 + 1));
+    if(block_itr % 8 == 0){
+      io_worker_pool.Wait(block_itr, ticket);
+    }
+  }
+  io_worker_pool.Drain();
+
+  std::stringstream stream;
+  stream << io_worker_pool;
+  EXPECT_NE(stream.str().find("READ: 64 "), std::string::npos);
+  EXPECT_NE(stream.str().find("WRITE: 64 "), std::string::npos);
+  EXPECT_NE(stream.str().find("SYNC: 64 "), std::string::npos);
+
+  remove(target.file_path.c_str());
+
+}
+
+}  // End machine namespace
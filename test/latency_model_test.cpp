@@ -0,0 +1,76 @@
+// LATENCY MODEL TEST
+
+#include <gtest/gtest.h>
+
+#include "latency_model.h"
+
+namespace machine {
+
+void SetupLatencies(LatencyModel& model){
+  model.SetPageLatency(DEVICE_TYPE_DRAM, ACCESS_TYPE_READ,
+                       PATTERN_TYPE_SEQUENTIAL, 1000);
+  model.SetPageLatency(DEVICE_TYPE_DRAM, ACCESS_TYPE_READ,
+                       PATTERN_TYPE_RANDOM, 2000);
+  model.SetBandwidth(DEVICE_TYPE_DRAM, ACCESS_TYPE_READ, 4096.0 / 1000);
+}
+
+TEST(LatencyModelTest, FixedCheck) {
+
+  FixedLatencyModel model;
+  SetupLatencies(model);
+
+  EXPECT_DOUBLE_EQ(model.GetLatency(DEVICE_TYPE_DRAM, ACCESS_TYPE_READ,
+                                    PATTERN_TYPE_SEQUENTIAL, 4096), 1000);
+  EXPECT_DOUBLE_EQ(model.GetLatency(DEVICE_TYPE_DRAM, ACCESS_TYPE_READ,
+                                    PATTERN_TYPE_RANDOM, 4096), 2000);
+
+  // Remaining pages stream sequentially
+  EXPECT_DOUBLE_EQ(model.GetLatency(DEVICE_TYPE_DRAM, ACCESS_TYPE_READ,
+                                    PATTERN_TYPE_RANDOM, 4 * 4096), 5000);
+  EXPECT_DOUBLE_EQ(model.GetLatency(DEVICE_TYPE_DRAM, ACCESS_TYPE_READ,
+                                    PATTERN_TYPE_RANDOM, 0), 0);
+
+}
+
+TEST(LatencyModelTest, DistributionCheck) {
+
+  DistributionLatencyModel model(0.5, 50);
+  SetupLatencies(model);
+
+  size_t sample_count = 100000;
+  double total_latency = 0;
+  double max_latency = 0;
+  for(size_t sample_itr = 0; sample_itr < sample_count; sample_itr++){
+    auto latency = model.GetLatency(DEVICE_TYPE_DRAM, ACCESS_TYPE_READ,
+                                    PATTERN_TYPE_SEQUENTIAL, 4096);
+    EXPECT_GT(latency, 0);
+    total_latency += latency;
+    max_latency = std::max(max_latency, latency);
+  }
+
+  // Unit mean factor with a tail
+  EXPECT_NEAR(total_latency / sample_count, 1000, 50);
+  EXPECT_GT(max_latency, 2000);
+
+}
+
+TEST(LatencyModelTest, SizeCheck) {
+
+  SizeLatencyModel model;
+  SetupLatencies(model);
+
+  // Page sized transfers match the fixed model
+  EXPECT_DOUBLE_EQ(model.GetLatency(DEVICE_TYPE_DRAM, ACCESS_TYPE_READ,
+                                    PATTERN_TYPE_RANDOM, 4096), 2000);
+  EXPECT_DOUBLE_EQ(model.GetLatency(DEVICE_TYPE_DRAM, ACCESS_TYPE_READ,
+                                    PATTERN_TYPE_SEQUENTIAL, 4 * 4096), 4000);
+
+  // Partial pages pay for the bytes moved
+  EXPECT_DOUBLE_EQ(model.GetLatency(DEVICE_TYPE_DRAM, ACCESS_TYPE_READ,
+                                    PATTERN_TYPE_SEQUENTIAL, 2048), 500);
+  EXPECT_DOUBLE_EQ(model.GetLatency(DEVICE_TYPE_DRAM, ACCESS_TYPE_READ,
+                                    PATTERN_TYPE_RANDOM, 2048), 1500);
+
+}
+
+}  // End machine namespace
@@ -0,0 +1,67 @@
+// NVM MODEL TEST
+
+#include <gtest/gtest.h>
+
+#include "nvm_model.h"
+
+namespace machine {
+
+TEST(NVMModelTest, CombiningCheck) {
+
+  // 1 MB in 16 regions with a 4 line buffer
+  NVMModel nvm_model(1024 * 1024, 64 * 1024, 1, 4, 1000, false);
+  size_t line_size = NVMModel::LINE_SIZE;
+
+  // Small sequential writes fill lines in the buffer
+  for(size_t address = 0; address < 1024 * line_size; address += 64){
+    nvm_model.Write(address, 64, address);
+  }
+  EXPECT_NEAR(nvm_model.GetWriteAmplification(), 1, 0.01);
+
+  // Scattered small writes each cost a full media line
+  nvm_model.ResetStats();
+  for(size_t line_itr = 0; line_itr < 1024; line_itr++){
+    nvm_model.Write(line_itr * 4 * line_size, 64, 0);
+  }
+  EXPECT_NEAR(nvm_model.GetWriteAmplification(), 4, 0.05);
+
+}
+
+TEST(NVMModelTest, ThrottlingCheck) {
+
+  NVMModel nvm_model(1024 * 1024, 64 * 1024, 1, 4, 1000, false);
+
+  // Writes at the media bandwidth do not stall
+  double stall = 0;
+  for(size_t page_itr = 0; page_itr < 64; page_itr++){
+    stall += nvm_model.Write(page_itr * 4096, 4096, page_itr * 4096.0);
+  }
+  EXPECT_DOUBLE_EQ(stall, 0);
+
+  // A burst waits for the media
+  nvm_model.ResetStats();
+  for(size_t page_itr = 0; page_itr < 64; page_itr++){
+    stall = nvm_model.Write(page_itr * 4096, 4096, 0);
+  }
+  EXPECT_GT(stall, 60 * 4096);
+
+}
+
+TEST(NVMModelTest, WearCheck) {
+
+  double lifetimes[2];
+  for(auto wear_leveling : {false, true}){
+    NVMModel nvm_model(1024 * 1024, 64 * 1024, 1, 4, 1000, wear_leveling);
+
+    // Hammer the first two pages
+    for(size_t write_itr = 0; write_itr < 64 * 1024; write_itr++){
+      nvm_model.Write((write_itr % 2) * 4096, 4096, 0);
+    }
+    lifetimes[wear_leveling] = nvm_model.GetLifetime(1000 * 1000 * 1000);
+  }
+
+  EXPECT_GT(lifetimes[1], 2 * lifetimes[0]);
+
+}
+
+}  // End machine namespace
@@ -0,0 +1,52 @@
+// OPTIMIZER TEST
+
+#include <gtest/gtest.h>
+
+#include "optimizer.h"
+#include "configuration.h"
+
+namespace machine {
+
+Candidate MakeCandidate(double cost, double throughput, double latency = 0){
+  Candidate candidate;
+  candidate.cost = cost;
+  candidate.throughput = throughput;
+  candidate.latency = latency;
+  return candidate;
+}
+
+TEST(OptimizerTest, ParetoFrontier) {
+
+  std::vector<Candidate> candidates = {
+      MakeCandidate(100, 1000),
+      MakeCandidate(200, 900),    // dominated
+      MakeCandidate(50, 500),
+      MakeCandidate(300, 5000),
+      MakeCandidate(300, 4000)    // dominated
+  };
+
+  auto frontier = GetParetoFrontier(candidates);
+
+  EXPECT_EQ(frontier.size(), 3);
+  EXPECT_EQ(frontier[0].cost, 50);
+  EXPECT_EQ(frontier[1].cost, 100);
+  EXPECT_EQ(frontier[2].throughput, 5000);
+}
+
+TEST(OptimizerTest, FeasibilityCheck) {
+
+  configuration state;
+  state.slo_throughput = 1000;
+  state.slo_latency = 0;
+
+  EXPECT_TRUE(IsFeasible(MakeCandidate(10, 2000), state));
+  EXPECT_FALSE(IsFeasible(MakeCandidate(10, 500), state));
+
+  // The latency SLO bounds the tail latency, whatever the throughput
+  state.slo_throughput = 0;
+  state.slo_latency = 100000;
+  EXPECT_FALSE(IsFeasible(MakeCandidate(10, 20000, 150000), state));
+  EXPECT_TRUE(IsFeasible(MakeCandidate(10, 2000, 80000), state));
+}
+
+}  // End machine namespace
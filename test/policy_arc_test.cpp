@@ -176,5 +176,41 @@ TEST(ARCCache, FrequencyCheck) {
   EXPECT_EQ(cache.Get(2), INVALID_VALUE);
 }
 
+TEST(ARCCache, EraseCheck) {
+  size_t cache_capacity = 2;
+  arc_cache_t<int, int> cache(cache_capacity);
+
+  // T1: 4 B1: 3 T2: 2 B2: 1
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+  cache.Put(4, 4);
+  cache.Erase(4);
+  cache.Erase(2);
+
+  // Only ghost entries are left, so nothing is evicted
+  EXPECT_EQ(cache.GetSize(), 0);
+  auto victim = cache.Put(4, 4);
+  EXPECT_EQ(victim.block_id, INVALID_KEY);
+  EXPECT_EQ(cache.Get(4), 4);
+}
+
+TEST(ARCCache, LargeCapacityCheck) {
+  const int CACHE_CAPACITY = 64 * 1024;
+  arc_cache_t<int, int> cache(CACHE_CAPACITY);
+
+  // Hot keys are reused while a scan streams through the cache
+  for (int i = 0; i < 16 * CACHE_CAPACITY; ++i) {
+    cache.Put(i % 1024, 1);
+    cache.Put(1024 + i, 1);
+  }
+
+  EXPECT_EQ(cache.GetSize(), CACHE_CAPACITY);
+  for (int i = 0; i < 1024; ++i) {
+    EXPECT_EQ(cache.Get(i), 1);
+  }
+}
 
 }  // End machine namespace
@@ -0,0 +1,49 @@
+// CLOCK-PRO TEST
+
+#include <gtest/gtest.h>
+
+#include "policy_clock_pro.h"
+#include "cache.h"
+
+namespace machine {
+
+template <typename Key, typename Value>
+using clock_pro_cache_t = Cache<Key, Value, CLOCKProCachePolicy<Key, Value>>;
+
+TEST(CLOCKProCache, SimplePut) {
+  size_t cache_capacity = 1;
+  clock_pro_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 666);
+  EXPECT_EQ(cache.Get(1), 666);
+
+  cache.Put(2, 777);
+  EXPECT_EQ(cache.GetSize(), 1);
+  EXPECT_EQ(cache.Get(1), INVALID_VALUE);
+  EXPECT_EQ(cache.Get(2), 777);
+}
+
+TEST(CLOCKProCache, TestPeriodCheck) {
+  size_t cache_capacity = 4;
+  CLOCKProCachePolicy<int, int> policy(cache_capacity, 0);
+
+  // The cold target starts at its minimum
+  EXPECT_EQ(policy.GetColdTarget(), 1);
+
+  for (int key = 0; key < 5; ++key) {
+    policy.Put(key, key);
+  }
+
+  // 0 was evicted but is remembered as a test entry
+  EXPECT_EQ(policy.Get(0), INVALID_VALUE);
+  EXPECT_EQ(policy.GetTestCount(), 1);
+
+  // Coming back within its test period makes it hot and grows the target
+  policy.Put(0, 0);
+  EXPECT_EQ(policy.Get(0), 0);
+  EXPECT_EQ(policy.GetHotCount(), 1);
+  EXPECT_EQ(policy.GetColdTarget(), 2);
+  EXPECT_EQ(policy.GetSize(), cache_capacity);
+}
+
+}  // End machine namespace
@@ -0,0 +1,77 @@
+// CLOCK TEST
+
+#include <gtest/gtest.h>
+
+#include "policy_clock.h"
+#include "cache.h"
+
+namespace machine {
+
+template <typename Key, typename Value>
+using clock_cache_t = Cache<Key, Value, CLOCKCachePolicy<Key, Value>>;
+
+TEST(CLOCKCache, SimplePut) {
+  size_t cache_capacity = 1;
+  clock_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 666);
+
+  EXPECT_EQ(cache.Get(1), 666);
+  EXPECT_EQ(cache.Get(2), INVALID_VALUE);
+}
+
+TEST(CLOCKCache, SweepCheck) {
+  size_t cache_capacity = 3;
+  clock_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+
+  // Usage count of 1 goes up to four
+  cache.Get(1);
+  cache.Get(1);
+  cache.Get(1);
+
+  // The hand wears 1 down and takes 2, then 3
+  EXPECT_EQ(cache.Put(4, 4).block_id, 2);
+  EXPECT_EQ(cache.Put(5, 5).block_id, 3);
+  EXPECT_EQ(cache.Get(1), 1);
+}
+
+TEST(CLOCKCache, UsageCapCheck) {
+  size_t cache_capacity = 3;
+
+  // Second chance only
+  clock_max_usage = 1;
+  CLOCKCachePolicy<int, int> policy(cache_capacity, 0);
+
+  policy.Put(1, 1);
+  policy.Put(2, 2);
+  policy.Put(3, 3);
+  policy.Get(1);
+  policy.Get(1);
+  EXPECT_EQ(policy.GetUsageCount(1), 1);
+
+  EXPECT_EQ(policy.Put(4, 4).block_id, 1);
+
+  clock_max_usage = 5;
+}
+
+TEST(CLOCKCache, EraseCheck) {
+  size_t cache_capacity = 3;
+  clock_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+  cache.Erase(2);
+
+  // Erased frame is reused without eviction
+  EXPECT_EQ(cache.GetSize(), 2);
+  EXPECT_EQ(cache.Put(4, 4).block_id, INVALID_KEY);
+  EXPECT_EQ(cache.Get(2), INVALID_VALUE);
+  EXPECT_EQ(cache.Get(4), 4);
+}
+
+}  // End machine namespace
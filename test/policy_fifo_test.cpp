@@ -114,4 +114,46 @@ TEST(FIFOCache, FIFOCheck){
   cache.Print();
 }
 
+TEST(FIFOCache, EraseCheck){
+  size_t cache_capacity = 3;
+  fifo_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+  cache.Erase(2);
+
+  // Erased slot is reused without eviction
+  EXPECT_EQ(cache.Put(4, 4).block_id, INVALID_KEY);
+
+  // The hole is skipped and insertion order is kept
+  EXPECT_EQ(cache.Put(5, 5).block_id, 1);
+  EXPECT_EQ(cache.Put(6, 6).block_id, 3);
+  EXPECT_EQ(cache.Put(7, 7).block_id, 4);
+}
+
+TEST(FIFOCache, ChurnCheck){
+  size_t cache_capacity = 4;
+  fifo_cache_t<int, int> cache(cache_capacity);
+
+  // Erasing all but the newest block forces the ring to wrap and compact
+  int next_key = 0;
+  for (int round = 0; round < 100; ++round) {
+    for (size_t i = 0; i < cache_capacity; ++i) {
+      cache.Put(next_key, next_key);
+      next_key++;
+    }
+    for (int key = next_key - cache_capacity; key < next_key - 1; ++key) {
+      cache.Erase(key);
+    }
+    EXPECT_EQ(cache.GetSize(), 1);
+  }
+
+  // Oldest survivors are evicted first
+  cache.Put(next_key, 0);
+  cache.Put(next_key + 1, 0);
+  cache.Put(next_key + 2, 0);
+  EXPECT_EQ(cache.Put(next_key + 3, 0).block_id, static_cast<size_t>(next_key - 1));
+}
+
 }  // End machine namespace
@@ -130,4 +130,57 @@ TEST(LFUCache, FrequencyCheck){
   cache.Print();
 }
 
+TEST(LFUCache, TieCheck) {
+  size_t cache_capacity = 3;
+  lfu_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+
+  // 3 and then 1 reach frequency two
+  cache.Get(3);
+  cache.Get(1);
+
+  // The newest block at frequency one goes first
+  EXPECT_EQ(cache.Put(4, 4).block_id, 2);
+  EXPECT_EQ(cache.Put(5, 5).block_id, 4);
+
+  // Then the block that reached frequency two first
+  cache.Get(5);
+  EXPECT_EQ(cache.Put(6, 6).block_id, 3);
+}
+
+TEST(LFUCache, AgingCheck) {
+  size_t cache_capacity = 3;
+
+  for(auto aging_factor : {0, 100}){
+    lfu_aging_factor = aging_factor;
+    LFUCachePolicy<int, int> policy(cache_capacity, 0);
+
+    // Hot during warm-up
+    policy.Put(1, 1);
+    for (int i = 0; i < 1000; ++i) {
+      policy.Get(1);
+    }
+
+    // A new working set
+    for (int i = 0; i < 600; ++i) {
+      policy.Put(2 + i % 2, 1);
+    }
+
+    // Without aging the warm-up block is pinned
+    if(aging_factor == 0){
+      EXPECT_EQ(policy.GetFrequency(1), 1001);
+      EXPECT_EQ(policy.Put(4, 1).block_id, 2);
+    }
+    else {
+      EXPECT_LT(policy.GetFrequency(1), policy.GetFrequency(2));
+      EXPECT_EQ(policy.Put(4, 1).block_id, 1);
+    }
+  }
+
+  lfu_aging_factor = 0;
+}
+
 }  // End machine namespace
@@ -0,0 +1,50 @@
+// LIRS TEST
+
+#include <gtest/gtest.h>
+
+#include "policy_lirs.h"
+#include "cache.h"
+
+namespace machine {
+
+template <typename Key, typename Value>
+using lirs_cache_t = Cache<Key, Value, LIRSCachePolicy<Key, Value>>;
+
+TEST(LIRSCache, SimplePut) {
+  size_t cache_capacity = 1;
+  lirs_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 666);
+  EXPECT_EQ(cache.Get(1), 666);
+
+  cache.Put(2, 777);
+  EXPECT_EQ(cache.GetSize(), 1);
+  EXPECT_EQ(cache.Get(1), INVALID_VALUE);
+  EXPECT_EQ(cache.Get(2), 777);
+}
+
+TEST(LIRSCache, StatusSwitchCheck) {
+  size_t cache_capacity = 10;
+  LIRSCachePolicy<int, int> policy(cache_capacity, 0);
+
+  // 0-8 fill the LIR share, 9 is the resident HIR block
+  for (int key = 0; key < 10; ++key) {
+    policy.Put(key, key);
+  }
+  EXPECT_EQ(policy.GetLIRCount(), 9);
+
+  // 9 stays on the stack as a non-resident entry
+  EXPECT_EQ(policy.Put(10, 10).block_id, 9);
+  EXPECT_EQ(policy.Get(9), INVALID_VALUE);
+  EXPECT_EQ(policy.GetNonResidentCount(), 1);
+
+  // Its reuse distance beats the oldest LIR block (0), which is demoted
+  EXPECT_EQ(policy.Put(9, 9).block_id, 10);
+  EXPECT_EQ(policy.GetLIRCount(), 9);
+  EXPECT_EQ(policy.Get(9), 9);
+  EXPECT_EQ(policy.GetSize(), cache_capacity);
+
+  EXPECT_EQ(policy.Put(11, 11).block_id, 0);
+}
+
+}  // End machine namespace
@@ -2,7 +2,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <list>
 #include <map>
+#include <random>
 #include <unordered_map>
 #include <mutex>
 
@@ -82,5 +85,76 @@ TEST(LRUCache, RecencyCheck){
   cache.Print();
 }
 
+TEST(LRUCache, EraseCheck){
+  size_t cache_capacity = 3;
+  lru_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+  cache.Erase(2);
+
+  EXPECT_EQ(cache.GetSize(), 2);
+  EXPECT_EQ(cache.Get(2), INVALID_VALUE);
+
+  // Erased slot is reused without eviction
+  cache.Put(4, 4);
+  EXPECT_EQ(cache.Get(1), 1);
+  EXPECT_EQ(cache.Get(3), 3);
+  EXPECT_EQ(cache.Get(4), 4);
+}
+
+TEST(LRUCache, ReferenceCheck){
+  size_t cache_capacity = 1000;
+  lru_cache_t<int, int> cache(cache_capacity);
+
+  // Reference list of keys, most recently used first
+  std::list<int> reference;
+  std::minstd_rand generator(7);
+
+  for(int operation_itr = 0; operation_itr < 200000; operation_itr++){
+    auto key = static_cast<int>(generator() % 4000);
+    auto location = std::find(reference.begin(), reference.end(), key);
+
+    switch(generator() % 3){
+      case 0: {
+        auto victim = cache.Put(key, key + 1);
+        if(location != reference.end()){
+          reference.erase(location);
+          EXPECT_EQ(victim.block_id, INVALID_KEY);
+        }
+        else if(reference.size() == cache_capacity){
+          EXPECT_EQ(victim.block_id, static_cast<size_t>(reference.back()));
+          EXPECT_EQ(victim.block_type, static_cast<size_t>(reference.back() + 1));
+          reference.pop_back();
+        }
+        reference.push_front(key);
+        break;
+      }
+      case 1: {
+        auto value = cache.Get(key);
+        if(location != reference.end()){
+          EXPECT_EQ(value, key + 1);
+          reference.erase(location);
+          reference.push_front(key);
+        }
+        else {
+          EXPECT_EQ(value, INVALID_VALUE);
+        }
+        break;
+      }
+      default: {
+        cache.Erase(key);
+        if(location != reference.end()){
+          reference.erase(location);
+        }
+        break;
+      }
+    }
+
+    ASSERT_EQ(cache.GetSize(), reference.size());
+  }
+
+}
 
 }  // End machine namespace
@@ -0,0 +1,100 @@
+// POLICY RESIDENCY TEST
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+
+#include "policy_clock.h"
+#include "policy_clock_pro.h"
+#include "policy_two_q.h"
+#include "policy_lirs.h"
+#include "policy_w_tiny_lfu.h"
+#include "cache.h"
+
+namespace machine {
+
+// Checks shared by the policies that track residency themselves
+template <typename Policy>
+class PolicyResidencyTest : public ::testing::Test {
+ protected:
+  using cache_t = Cache<int, int, Policy>;
+};
+
+using ResidencyPolicies = ::testing::Types<
+    CLOCKCachePolicy<int, int>,
+    CLOCKProCachePolicy<int, int>,
+    TwoQCachePolicy<int, int>,
+    LIRSCachePolicy<int, int>,
+    WTinyLFUCachePolicy<int, int>>;
+
+TYPED_TEST_SUITE(PolicyResidencyTest, ResidencyPolicies);
+
+// Checks shared by the scan-resistant policies
+template <typename Policy>
+class PolicyScanTest : public ::testing::Test {
+ protected:
+  using cache_t = Cache<int, int, Policy>;
+};
+
+using ScanResistantPolicies = ::testing::Types<
+    CLOCKProCachePolicy<int, int>,
+    TwoQCachePolicy<int, int>,
+    LIRSCachePolicy<int, int>,
+    WTinyLFUCachePolicy<int, int>>;
+
+TYPED_TEST_SUITE(PolicyScanTest, ScanResistantPolicies);
+
+TYPED_TEST(PolicyResidencyTest, ResidencyCheck) {
+  size_t cache_capacity = 64;
+  typename TestFixture::cache_t cache(cache_capacity);
+  std::set<int> resident;
+  std::minstd_rand generator(5);
+
+  // Every block that leaves the cache is reported exactly once
+  for (int operation_itr = 0; operation_itr < 100000; ++operation_itr) {
+    auto key = static_cast<int>(generator() % 256);
+    if (generator() % 8 == 0) {
+      cache.Erase(key);
+      resident.erase(key);
+      continue;
+    }
+
+    auto victim = cache.Put(key, key);
+    if (victim.block_id != INVALID_KEY) {
+      EXPECT_EQ(resident.erase(victim.block_id), 1);
+    }
+    resident.insert(key);
+    ASSERT_EQ(cache.GetSize(), resident.size());
+  }
+
+  for (int key = 0; key < 256; ++key) {
+    EXPECT_EQ(cache.Get(key) != INVALID_VALUE, resident.count(key) == 1);
+  }
+}
+
+TYPED_TEST(PolicyScanTest, ScanCheck) {
+  size_t cache_capacity = 100;
+  typename TestFixture::cache_t cache(cache_capacity);
+
+  // Blocks 0-49 are reused between rounds of new blocks
+  for (int round = 0; round < 10; ++round) {
+    for (int key = 0; key < 50; ++key) {
+      cache.Put(key, key);
+    }
+    for (int key = 0; key < 50; ++key) {
+      cache.Put(1000 + round * 50 + key, key);
+    }
+  }
+
+  // A long scan of blocks used once does not displace them
+  for (int key = 10000; key < 20000; ++key) {
+    cache.Put(key, key);
+  }
+
+  for (int key = 0; key < 50; ++key) {
+    EXPECT_EQ(cache.Get(key), key);
+  }
+}
+
+}  // End machine namespace
@@ -0,0 +1,47 @@
+// 2Q TEST
+
+#include <gtest/gtest.h>
+
+#include "policy_two_q.h"
+#include "cache.h"
+
+namespace machine {
+
+template <typename Key, typename Value>
+using two_q_cache_t = Cache<Key, Value, TwoQCachePolicy<Key, Value>>;
+
+TEST(TwoQCache, SimplePut) {
+  size_t cache_capacity = 1;
+  two_q_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 666);
+  EXPECT_EQ(cache.Get(1), 666);
+
+  cache.Put(2, 777);
+  EXPECT_EQ(cache.GetSize(), 1);
+  EXPECT_EQ(cache.Get(1), INVALID_VALUE);
+  EXPECT_EQ(cache.Get(2), 777);
+}
+
+TEST(TwoQCache, AdmissionCheck) {
+  size_t cache_capacity = 4;
+  TwoQCachePolicy<int, int> policy(cache_capacity, 0);
+
+  for (int key = 0; key < 4; ++key) {
+    policy.Put(key, key);
+  }
+
+  // A hit in A1in does not protect a block
+  EXPECT_EQ(policy.Get(0), 0);
+  EXPECT_EQ(policy.Put(4, 4).block_id, 0);
+  EXPECT_EQ(policy.Get(0), INVALID_VALUE);
+  EXPECT_EQ(policy.GetHotCount(), 0);
+
+  // Coming back while remembered in A1out admits it to Am
+  EXPECT_EQ(policy.Put(0, 0).block_id, 1);
+  EXPECT_EQ(policy.GetHotCount(), 1);
+  EXPECT_EQ(policy.Get(0), 0);
+  EXPECT_EQ(policy.GetSize(), cache_capacity);
+}
+
+}  // End machine namespace
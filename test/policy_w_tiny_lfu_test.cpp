@@ -0,0 +1,78 @@
+// W-TINYLFU TEST
+
+#include <gtest/gtest.h>
+
+#include "policy_w_tiny_lfu.h"
+#include "cache.h"
+
+namespace machine {
+
+template <typename Key, typename Value>
+using w_tiny_lfu_cache_t = Cache<Key, Value, WTinyLFUCachePolicy<Key, Value>>;
+
+TEST(WTinyLFUCache, SimplePut) {
+  size_t cache_capacity = 1;
+  w_tiny_lfu_cache_t<int, int> cache(cache_capacity);
+
+  cache.Put(1, 666);
+  EXPECT_EQ(cache.Get(1), 666);
+
+  cache.Put(2, 777);
+  EXPECT_EQ(cache.GetSize(), 1);
+  EXPECT_EQ(cache.Get(1), INVALID_VALUE);
+  EXPECT_EQ(cache.Get(2), 777);
+}
+
+TEST(WTinyLFUCache, SketchCheck) {
+  FrequencySketch sketch(64);
+
+  EXPECT_EQ(sketch.Estimate(7), 0);
+
+  // The first access only reaches the doorkeeper
+  sketch.Increment(7);
+  EXPECT_EQ(sketch.Estimate(7), 1);
+
+  for (int access_itr = 0; access_itr < 4; ++access_itr) {
+    sketch.Increment(7);
+  }
+  EXPECT_EQ(sketch.Estimate(7), 5);
+
+  // Counters saturate at 15
+  for (int access_itr = 0; access_itr < 30; ++access_itr) {
+    sketch.Increment(7);
+  }
+  EXPECT_EQ(sketch.Estimate(7), 16);
+
+  // Reset halves the counters and clears the doorkeeper
+  sketch.Reset();
+  EXPECT_EQ(sketch.Estimate(7), 7);
+}
+
+TEST(WTinyLFUCache, AdmissionCheck) {
+  size_t cache_capacity = 4;
+  WTinyLFUCachePolicy<int, int> policy(cache_capacity, 0);
+
+  // 0-2 are in the main region and have been used before
+  for (int key = 0; key < 4; ++key) {
+    policy.Put(key, key);
+  }
+  for (int key = 0; key < 3; ++key) {
+    policy.Get(key);
+  }
+
+  // A one-hit wonder pushed out of the window is not admitted
+  EXPECT_EQ(policy.Put(4, 4).block_id, 3);
+  EXPECT_EQ(policy.Put(5, 5).block_id, 4);
+
+  // A block seen often enough displaces the LRU block of probation
+  for (int access_itr = 0; access_itr < 3; ++access_itr) {
+    policy.Get(5);
+  }
+  auto victim = policy.Put(6, 6).block_id;
+  EXPECT_NE(victim, 5);
+  EXPECT_NE(victim, 6);
+  EXPECT_EQ(policy.Get(5), 5);
+  EXPECT_EQ(policy.GetSize(), cache_capacity);
+}
+
+}  // End machine namespace
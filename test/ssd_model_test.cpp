@@ -0,0 +1,72 @@
+// SSD MODEL TEST
+
+#include <gtest/gtest.h>
+
+#include "ssd_model.h"
+#include "distribution.h"
+
+namespace machine {
+
+TEST(SSDModelTest, SequentialCheck) {
+
+  SSDModel ssd_model(1024, 0.25, 16, GC_POLICY_TYPE_GREEDY);
+  ssd_model.SetLatencies(1, 10, 100);
+  ssd_model.Precondition();
+
+  // Sequential overwrites invalidate whole erase blocks
+  double gc_latency = 0;
+  for(size_t round_itr = 0; round_itr < 4; round_itr++){
+    for(size_t page_itr = 0; page_itr < 1024; page_itr++){
+      gc_latency += ssd_model.Write(page_itr);
+    }
+  }
+
+  EXPECT_DOUBLE_EQ(ssd_model.GetWriteAmplification(), 1);
+  EXPECT_GT(gc_latency, 0);
+
+}
+
+TEST(SSDModelTest, RandomCheck) {
+
+  for(auto gc_policy_type : {GC_POLICY_TYPE_GREEDY, GC_POLICY_TYPE_COST_BENEFIT}){
+    SSDModel ssd_model(1024, 0.25, 16, gc_policy_type);
+    ssd_model.SetLatencies(1, 10, 100);
+    ssd_model.Precondition();
+
+    // Random overwrites force relocations
+    UniformDistribution generator(50);
+    for(size_t write_itr = 0; write_itr < 8192; write_itr++){
+      ssd_model.Write(generator.next() % 1024);
+    }
+
+    EXPECT_GT(ssd_model.GetWriteAmplification(), 1);
+  }
+
+}
+
+TEST(SSDModelTest, TrimCheck) {
+
+  UniformDistribution generator(50);
+
+  SSDModel ssd_model(1024, 0.25, 16, GC_POLICY_TYPE_GREEDY);
+  SSDModel trimmed_ssd_model(1024, 0.25, 16, GC_POLICY_TYPE_GREEDY);
+  ssd_model.Precondition();
+  trimmed_ssd_model.Precondition();
+
+  // Discarded pages are not relocated
+  for(size_t page_itr = 0; page_itr < 512; page_itr++){
+    trimmed_ssd_model.Trim(page_itr);
+  }
+
+  for(size_t write_itr = 0; write_itr < 8192; write_itr++){
+    auto page = 512 + generator.next() % 512;
+    ssd_model.Write(page);
+    trimmed_ssd_model.Write(page);
+  }
+
+  EXPECT_LT(trimmed_ssd_model.GetWriteAmplification(),
+            ssd_model.GetWriteAmplification());
+
+}
+
+}  // End machine namespace
@@ -0,0 +1,71 @@
+// STREAM DETECTOR TEST
+
+#include <gtest/gtest.h>
+
+#include "stream_detector.h"
+
+namespace machine {
+
+TEST(StreamDetectorTest, InterleavedCheck) {
+
+  StreamDetector detector;
+
+  // Two interleaved scans
+  EXPECT_EQ(detector.Classify(100), PATTERN_TYPE_RANDOM);
+  EXPECT_EQ(detector.Classify(5000), PATTERN_TYPE_RANDOM);
+  for(size_t block_itr = 1; block_itr < 10; block_itr++){
+    EXPECT_EQ(detector.Classify(100 + block_itr), PATTERN_TYPE_SEQUENTIAL);
+    EXPECT_EQ(detector.Classify(5000 - block_itr), PATTERN_TYPE_SEQUENTIAL);
+  }
+
+  EXPECT_EQ(detector.GetStride(109), 1);
+  EXPECT_EQ(detector.GetStride(4991), -1);
+  EXPECT_EQ(detector.GetStride(12345), 0);
+
+}
+
+TEST(StreamDetectorTest, StridedCheck) {
+
+  StreamDetector detector;
+
+  EXPECT_EQ(detector.Classify(1000), PATTERN_TYPE_RANDOM);
+  EXPECT_EQ(detector.Classify(1008), PATTERN_TYPE_RANDOM);
+  for(size_t block_itr = 2; block_itr < 10; block_itr++){
+    EXPECT_EQ(detector.Classify(1000 + 8 * block_itr), PATTERN_TYPE_STRIDED);
+  }
+
+  EXPECT_EQ(detector.GetStride(1072), 8);
+
+  // Strides beyond the window are random
+  EXPECT_EQ(detector.Classify(1072 + 1000), PATTERN_TYPE_RANDOM);
+
+}
+
+TEST(StreamDetectorTest, WrapAroundCheck) {
+
+  StreamDetector detector;
+
+  // Unsigned distances must not wrap
+  EXPECT_EQ(detector.Classify(0), PATTERN_TYPE_RANDOM);
+  EXPECT_EQ(detector.Classify(SIZE_MAX), PATTERN_TYPE_RANDOM);
+  EXPECT_EQ(detector.Classify(SIZE_MAX - 1), PATTERN_TYPE_SEQUENTIAL);
+  EXPECT_EQ(detector.Classify(1), PATTERN_TYPE_SEQUENTIAL);
+
+}
+
+TEST(StreamDetectorTest, ReplacementCheck) {
+
+  StreamDetector detector(2);
+
+  detector.Classify(0);
+  detector.Classify(1);
+  detector.Classify(1000);
+  detector.Classify(2000);
+
+  // Least recently used stream was replaced
+  EXPECT_EQ(detector.Classify(2), PATTERN_TYPE_RANDOM);
+  EXPECT_EQ(detector.Classify(2001), PATTERN_TYPE_SEQUENTIAL);
+
+}
+
+}  // End machine namespace
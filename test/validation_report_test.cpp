@@ -0,0 +1,48 @@
+// VALIDATION REPORT TEST
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "validation_report.h"
+
+namespace machine {
+
+TEST(ValidationReportTest, SuggestionCheck) {
+
+  FixedLatencyModel latency_model;
+  latency_model.SetPageLatency(DEVICE_TYPE_NVM, ACCESS_TYPE_READ, PATTERN_TYPE_SEQUENTIAL, 1000);
+  latency_model.SetPageLatency(DEVICE_TYPE_NVM, ACCESS_TYPE_READ, PATTERN_TYPE_RANDOM, 2000);
+  latency_model.SetPageLatency(DEVICE_TYPE_NVM, ACCESS_TYPE_WRITE, PATTERN_TYPE_RANDOM, 3000);
+
+  // Sequential reads measure twice the model, random reads half
+  ValidationReport validation_report;
+  for(size_t operation_itr = 0; operation_itr < 100; operation_itr++){
+    validation_report.Record(DEVICE_TYPE_NVM, ACCESS_TYPE_READ, PATTERN_TYPE_SEQUENTIAL,
+                             1000, 1000, 2000);
+    validation_report.Record(DEVICE_TYPE_NVM, ACCESS_TYPE_READ, PATTERN_TYPE_RANDOM,
+                             2000, 2000, 1000);
+  }
+
+  EXPECT_DOUBLE_EQ(validation_report.GetSuggestedLatency(latency_model, DEVICE_TYPE_NVM,
+                                                         ACCESS_TYPE_READ,
+                                                         PATTERN_TYPE_SEQUENTIAL), 2000);
+  EXPECT_DOUBLE_EQ(validation_report.GetSuggestedLatency(latency_model, DEVICE_TYPE_NVM,
+                                                         ACCESS_TYPE_READ,
+                                                         PATTERN_TYPE_RANDOM), 1000);
+
+  // Unmeasured cells keep the table value
+  auto profiles = validation_report.GetSuggestedProfiles(latency_model);
+  ASSERT_EQ(profiles.count(DEVICE_TYPE_NVM), 1);
+  EXPECT_DOUBLE_EQ(profiles[DEVICE_TYPE_NVM].seq_read_latency, 2000);
+  EXPECT_DOUBLE_EQ(profiles[DEVICE_TYPE_NVM].rnd_read_latency, 1000);
+  EXPECT_DOUBLE_EQ(profiles[DEVICE_TYPE_NVM].rnd_write_latency, 3000);
+  EXPECT_EQ(profiles.count(DEVICE_TYPE_DISK), 0);
+
+  std::stringstream stream;
+  stream << validation_report;
+  EXPECT_NE(stream.str().find("NVM READ SEQ"), std::string::npos);
+
+}
+
+}  // End machine namespace